@@ -53,6 +53,14 @@ public:
    * \return 1 if action takes place, 0 otherwise
    */
   int atCurrentTime(const TimeClass* const TimeInfo) const;
+  /**
+   * \brief This is the function used to check whether an action takes place on a given timestep
+   * \param year is the year of the timestep to check
+   * \param step is the step of the timestep to check
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if action takes place, 0 otherwise
+   */
+  int atTime(int year, int step, const TimeClass* const TimeInfo) const;
 protected:
   /**
    * \brief This is the flag if the action takes place on every timestep
@@ -12,13 +12,13 @@ public:
   /**
    * \brief This is the default AddressKeeper constructor
    */
-  AddressKeeper() { addr = 0; name = 0; };
+  AddressKeeper() { addr = 0; name = 0; firstuse = 1; };
   /**
    * \brief This is the AddressKeeper constructor that creates a copy of an existing AddressKeeper
    * \param initial is the AddressKeeper to copy
    */
   AddressKeeper(const AddressKeeper& initial)
-    : addr(initial.addr), name(new char[strlen(initial.name) + 1])
+    : addr(initial.addr), firstuse(initial.firstuse), name(new char[strlen(initial.name) + 1])
     { strcpy(name, initial.name); };
   /**
    * \brief This is the default AddressKeeper destructor
@@ -71,6 +71,7 @@ public:
     name = new char[strlen(a.name) + 1];
     strcpy(name, a.name);
     addr = a.addr;
+    firstuse = a.firstuse;
   };
   /**
    * \brief This will return a null terminated text string containing the name of the stored variable
@@ -81,6 +82,11 @@ public:
    * \brief This is the memory address where the value of the variable is stored
    */
   double* addr;  //JMB shouldnt this be private??
+  /**
+   * \brief This is the first timestep when the value of the variable is used in the model simulation
+   * \note This is 1 unless the variable is known to only be used later on in the simulation
+   */
+  int firstuse;
 private:
   /**
    * \brief This is the null terminated name of the stored variable
@@ -18,7 +18,7 @@ public:
   /**
    * \brief This is the default AgeBandMatrix constructor
    */
-  AgeBandMatrix() { minage = 0; nrow = 0; v = 0; };
+  AgeBandMatrix() { minage = 0; nrow = 0; v = 0; data = 0; };
   /**
    * \brief This is the AgeBandMatrix constructor for a specified minimum age and size
    * \param age is the minimum index of the vector to be created
@@ -70,25 +70,25 @@ public:
    * \param age is the element of the vector to be returned
    * \return the value of the specified element
    */
-  PopInfoIndexVector& operator [] (int age) { return *(v[age - minage]); };
+  PopInfoIndexVector& operator [] (int age) { return v[age - minage]; };
   /**
    * \brief This will return the value of an element of the vector
    * \param age is the element of the vector to be returned
    * \return the value of the specified element
    */
-  const PopInfoIndexVector& operator [] (int age) const { return *(v[age - minage]); };
+  const PopInfoIndexVector& operator [] (int age) const { return v[age - minage]; };
   /**
    * \brief This will return the minimum length of an age group stored in the vector
    * \param age is identifier for the age group
    * \return minimum length
    */
-  int minLength(int age) const { return v[age - minage]->minCol(); };
+  int minLength(int age) const { return v[age - minage].minCol(); };
   /**
    * \brief This will return the maximum length of an age group stored in the vector
    * \param age is identifier for the age group
    * \return maximum length
    */
-  int maxLength(int age) const { return v[age - minage]->maxCol(); };
+  int maxLength(int age) const { return v[age - minage].maxCol(); };
   /**
    * \brief This function will sum the columns of each element stored in the vector (ie sum over all ages for each length group of the population)
    * \param Result is the PopInfoVector containing the sum over all ages for each length
@@ -170,10 +170,21 @@ protected:
    * \brief This is number of rows of the vector
    */
   int nrow;
+  /**
+   * \brief This will set up the entries of the vector to use one block of storage
+   * \param minl is the IntVector of minimum lengths for the entries of the vector
+   * \param size is the IntVector of sizes for the entries of the vector
+   */
+  void allocateStorage(const IntVector& minl, const IntVector& size);
   /**
    * \brief This is the indexed vector of PopInfoIndexVector values
+   * \note The entries of this vector do not own their storage, which is in data
+   */
+  PopInfoIndexVector* v;
+  /**
+   * \brief This is the contiguous block of PopInfo values for all the entries of the vector, stored in age order
    */
-  PopInfoIndexVector** v;
+  PopInfo* data;
 };
 
 #endif
@@ -0,0 +1,99 @@
+#ifndef aggregationplanner_h
+#define aggregationplanner_h
+
+#include "stockaggregator.h"
+#include "fleetpreyaggregator.h"
+#include "lengthgroup.h"
+#include "gadget.h"
+
+/**
+ * \class AggregationPlanner
+ * \brief This is the class used to share the aggregators between the likelihood components that need the same aggregated population
+ *
+ * Each likelihood component that compares the modelled population to data asks for an aggregator that sums the population of a list of stocks (or the catch of a list of stocks by a list of fleets) into the area, age and length groups used by that component.  The planner keeps a list of the aggregators that have been requested, and if a likelihood component asks for an aggregator with the same stocks, fleets, areas, ages and length groups as an aggregator that has already been created then that aggregator is returned instead of creating a new one.  The shared aggregators are only summed once on each timestep, and the summed population is then used by all the likelihood components that need it.
+ * \note The planner owns the aggregators, which are deleted with the planner, so the likelihood components must not delete the aggregators that they have been given
+ */
+class AggregationPlanner {
+public:
+  /**
+   * \brief This is the default AggregationPlanner constructor
+   */
+  AggregationPlanner() {};
+  /**
+   * \brief This is the default AggregationPlanner destructor
+   */
+  ~AggregationPlanner();
+  /**
+   * \brief This function will return an aggregator that sums the population of the stocks
+   * \param Stocks is the StockPtrVector of the stocks that will be aggregated
+   * \param LgrpDiv is the LengthGroupDivision that the stocks will be aggregated to
+   * \param Areas is the IntMatrix of the areas that the stocks will be aggregated to
+   * \param Ages is the IntMatrix of the ages that the stocks will be aggregated to
+   * \return pointer to the StockAggregator, which might be shared with other likelihood components
+   */
+  StockAggregator* getStockAggregator(const StockPtrVector& Stocks,
+    const LengthGroupDivision* const LgrpDiv, const IntMatrix& Areas, const IntMatrix& Ages);
+  /**
+   * \brief This function will return an aggregator that sums the catch of the stocks by the fleets
+   * \param Fleets is the FleetPtrVector of the fleets that will be aggregated
+   * \param Stocks is the StockPtrVector of the stocks that will be aggregated
+   * \param LgrpDiv is the LengthGroupDivision that the stocks will be aggregated to
+   * \param Areas is the IntMatrix of the areas that the stocks will be aggregated to
+   * \param Ages is the IntMatrix of the ages that the stocks will be aggregated to
+   * \param overcons is the flag to denote whether the overconsumption should be taken into account
+   * \return pointer to the FleetPreyAggregator, which might be shared with other likelihood components
+   */
+  FleetPreyAggregator* getFleetPreyAggregator(const FleetPtrVector& Fleets,
+    const StockPtrVector& Stocks, LengthGroupDivision* const LgrpDiv,
+    const IntMatrix& Areas, const IntMatrix& Ages, int overcons);
+  /**
+   * \brief This function will mark all the aggregators as not summed, so that they are summed again when they are next needed
+   * \note This function is called at the start of each timestep
+   */
+  void newStep();
+  /**
+   * \brief This function will write a summary of the aggregators to the log file
+   */
+  void logSummary() const;
+private:
+  /**
+   * \brief This is the struct used to store the details of an aggregator that has been requested
+   */
+  struct Request {
+    /**
+     * \brief This is the Request constructor
+     * \note The vectors and matrices dont have an assignment operator so they have to be copied here
+     */
+    Request(const FleetPtrVector& Fleets, const StockPtrVector& Stocks,
+      const LengthGroupDivision* const Lgrpdiv, const IntMatrix& Areas, const IntMatrix& Ages, int overcons)
+      : fleets(Fleets), stocks(Stocks), LgrpDiv(new LengthGroupDivision(*Lgrpdiv)), areas(Areas),
+        ages(Ages), overcons(overcons), numuses(1), saggr(0), faggr(0) {};
+    FleetPtrVector fleets;
+    StockPtrVector stocks;
+    LengthGroupDivision* LgrpDiv;
+    IntMatrix areas;
+    IntMatrix ages;
+    int overcons;
+    int numuses;
+    StockAggregator* saggr;
+    FleetPreyAggregator* faggr;
+  };
+  /**
+   * \brief This function will find an aggregator that has already been requested
+   * \param Fleets is the FleetPtrVector of the fleets that will be aggregated
+   * \param Stocks is the StockPtrVector of the stocks that will be aggregated
+   * \param LgrpDiv is the LengthGroupDivision that the stocks will be aggregated to
+   * \param Areas is the IntMatrix of the areas that the stocks will be aggregated to
+   * \param Ages is the IntMatrix of the ages that the stocks will be aggregated to
+   * \param overcons is the flag to denote whether the overconsumption should be taken into account (-1 for a StockAggregator)
+   * \return pointer to the Request for the aggregator, or 0 if no such aggregator has been requested
+   */
+  Request* findRequest(const FleetPtrVector& Fleets, const StockPtrVector& Stocks,
+    const LengthGroupDivision* const LgrpDiv, const IntMatrix& Areas, const IntMatrix& Ages, int overcons);
+  /**
+   * \brief This is the vector of the aggregators that have been requested
+   */
+  vector<Request*> requests;
+};
+
+#endif
@@ -180,6 +180,12 @@ public:
    * \brief This is the function that resets the timestep to the beginning of the model simulation
    */
   void Reset();
+  /**
+   * \brief This is the function that sets the timestep to a given point part way through the model simulation
+   * \param time is the timestep that the simulation will be restarted from
+   * \note The length of the timestep is treated as having changed on the timestep that the simulation is restarted from, so that any values that depend on it are recalculated
+   */
+  void Restart(int time);
   /**
    * \brief This will return the number of substeps in the current timestep of the model simulation
    * \return number of substeps
@@ -192,8 +198,14 @@ public:
   /**
    * \brief This is the function that will check to see if the length of the current timestep has changed from the previous timestep
    * \return 1 if the length of the timestep has changed, 0 otherwise
+   * \note The first timestep of the simulation is compared to the last timestep, since that is the timestep that the previous simulation finished on
    */
   int didStepSizeChange() const;
+  /**
+   * \brief This is the function that will check to see if the simulation has been restarted on the current timestep
+   * \return 1 if the simulation has been restarted on the current timestep, 0 otherwise
+   */
+  int didRestart() const { return restarted; };
   /**
    * \brief This function will return the maximum ratio of any stock that can be consumed on the current substep
    * \return maximum ratio of the stock that can be consumed on the current substep
@@ -250,6 +262,10 @@ protected:
    * \brief This is the current substep of the model simulation
    */
   int currentsubstep;
+  /**
+   * \brief This is the flag used to denote whether the simulation has been restarted on the current timestep
+   */
+  int restarted;
 };
 
 #endif
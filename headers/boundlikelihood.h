@@ -36,6 +36,17 @@ public:
    * \param keeper is the Keeper for the current model
    */
   void Reset(const Keeper* const keeper);
+  /**
+   * \brief This function will check whether the BoundLikelihood likelihood can be restarted part way through the simulation
+   * \return 1, since the likelihood score is calculated before the simulation
+   */
+  virtual int canRestart() const { return 1; };
+  /**
+   * \brief This function will reset the bounds information when the simulation is restarted from a checkpoint
+   * \param id is the identifier of the checkpoint
+   * \param TimeInfo is the TimeClass for the current model
+   */
+  virtual void restoreState(int id, const TimeClass* const TimeInfo);
   /**
    * \brief This function will calculate the likelihood score for the current model
    * \param TimeInfo is the TimeClass for the current model
@@ -3,6 +3,7 @@
 
 #include "likelihood.h"
 #include "fleetpreyaggregator.h"
+#include "aggregationplanner.h"
 #include "doublematrixptrmatrix.h"
 #include "actionattimes.h"
 #include "ludecomposition.h"
@@ -38,11 +39,24 @@ public:
    * \param TimeInfo is the TimeClass for the current model
    */
   virtual void addLikelihood(const TimeClass* const TimeInfo);
+  /**
+   * \brief This function will check whether the CatchDistribution component needs to be calculated on a given timestep
+   * \param year is the year of the timestep to check
+   * \param step is the step of the timestep to check
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if there is data for the timestep, 0 otherwise
+   */
+  virtual int isActive(int year, int step, const TimeClass* const TimeInfo) const;
   /**
    * \brief This function will reset the CatchDistribution likelihood information
    * \param keeper is the Keeper for the current model
    */
   virtual void Reset(const Keeper* const keeper);
+  /**
+   * \brief This function will check whether the CatchDistribution likelihood can be restarted part way through the simulation
+   * \return 1, since the modelled data is stored for each timestep
+   */
+  virtual int canRestart() const { return 1; };
   /**
    * \brief This function will print the summary CatchDistribution likelihood information
    * \param outfile is the ofstream that all the model information gets sent to
@@ -52,14 +66,20 @@ public:
    * \brief This will select the fleets and stocks required to calculate the CatchDistribution likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
    * \param Stocks is the StockPtrVector of all the available stocks
+   * \param planner is the AggregationPlanner used to share the aggregators between the likelihood components
    */
-  void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks);
+  void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+    AggregationPlanner* const planner);
   /**
    * \brief This function will print information from each CatchDistribution calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
    * \param TimeInfo is the TimeClass for the current model
    */
   virtual void printLikelihood(ofstream& outfile, const TimeClass* const TimeInfo);
+  /**
+   * \brief This function will set the flag to denote that the modelled distribution will be printed
+   */
+  virtual void setPrintModel() { printmodel = 1; };
   /**
    * \brief This function will print summary information from each CatchDistribution likelihood calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
@@ -76,6 +96,12 @@ private:
    */
   void readDistributionData(CommentStream& infile, const TimeClass* TimeInfo,
     int numarea, int numage, int numlen);
+  /**
+   * \brief This function will calculate the terms of the likelihood score that only depend on the observed data
+   * \param TimeInfo is the TimeClass for the current model
+   * \note The observed data doesnt change during the optimisation, so these terms only need to be calculated once
+   */
+  void prepareObservations(const TimeClass* const TimeInfo);
   /**
    * \brief This function will calculate the likelihood score for the current timestep based on a multinomial function
    * \return likelihood score
@@ -135,6 +161,16 @@ private:
    * \note The indices for this object are [time][area][age][length]
    */
   DoubleMatrixPtrMatrix modelDistribution;
+  /**
+   * \brief This is the DoubleMatrixPtrMatrix used to store the terms of the likelihood calculation that only depend on the observed data
+   * \note The indices for this object are [time][area], and the matrix stored depends on the function used - the data constants for each multinomial calculation, the observed proportions for the sum of squares, stratified and multivariate normal functions, the logarithm of the observed proportions for the multivariate logistic function and the observed total for the logarithmic function
+   */
+  DoubleMatrixPtrMatrix obsPrepared;
+  /**
+   * \brief This is the IntVector used to find the index of the likelihood data for each timestep
+   * \note This is -1 for the timesteps that have no likelihood data
+   */
+  IntVector timeMap;
   /**
    * \brief This is the DoubleMatrix used to store the calculated likelihood information
    * \note The indices for this object are [time][area]
@@ -219,6 +255,11 @@ private:
    * \note The default value is 0, which calculates the likelihood score on each timestep
    */
   int yearly;
+  /**
+   * \brief This is the flag to denote whether the modelled distribution needs to be stored for printing
+   * \note The default value is 0, and the modelled distribution is then only stored if it is needed to calculate the likelihood score
+   */
+  int printmodel;
   /**
    * \brief This is the LengthGroupDivision used to store length information
    */
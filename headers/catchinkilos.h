@@ -36,6 +36,17 @@ public:
    * \param keeper is the Keeper for the current model
    */
   virtual void Reset(const Keeper* const keeper);
+  /**
+   * \brief This function will check whether the CatchInKilos likelihood can be restarted part way through the simulation
+   * \return 1
+   */
+  virtual int canRestart() const { return 1; };
+  /**
+   * \brief This function will restore the CatchInKilos likelihood information that was stored at a checkpoint
+   * \param id is the identifier of the checkpoint
+   * \param TimeInfo is the TimeClass for the current model
+   */
+  virtual void restoreState(int id, const TimeClass* const TimeInfo);
   /**
    * \brief This function will print the summary CatchInKilos likelihood information
    * \param outfile is the ofstream that all the model information gets sent to
@@ -57,6 +68,14 @@ public:
    * \param TimeInfo is the TimeClass for the current model
    */
   virtual void addLikelihood(const TimeClass* const TimeInfo);
+  /**
+   * \brief This function will check whether the CatchInKilos component needs to be calculated on a given timestep
+   * \param year is the year of the timestep to check
+   * \param step is the step of the timestep to check
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if there is data for the timestep, 0 otherwise
+   */
+  virtual int isActive(int year, int step, const TimeClass* const TimeInfo) const;
   /**
    * \brief This will select the fleets and stocks required to calculate the CatchInKilos likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
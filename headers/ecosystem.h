@@ -19,6 +19,7 @@
 #include "maininfo.h"
 #include "printinfo.h"
 #include "optinfo.h"
+#include "aggregationplanner.h"
 #include "gadget.h"
 
 /**
@@ -103,6 +104,13 @@ public:
    * \brief This function will write current information about the model parameters to file
    */
   void writeValues();
+#ifdef _OPENMP
+  /**
+   * \brief This function will write information about the model parameters from the last simulation of a copy of the model to file
+   * \param eco is the Ecosystem that has been used for the simulation
+   */
+  void writeValues(Ecosystem* eco);
+#endif
   /**
    * \brief This function will write final information about the model parameters to file in a column format (which can then be used as the starting point for a subsequent model run)
    * \param filename is the name of the file to write the model information to
@@ -184,6 +192,11 @@ public:
    * \return number of variables
    */
   int numVariables() const { return keeper->numVariables(); };
+  /**
+   * \brief This function will return the number of printer classes used to print the model output
+   * \return number of printer classes
+   */
+  int numPrinters() const { return printvec.Size(); };
   /**
    * \brief This function will return the number of variables to be optimised
    * \return number of variables to be optimised
@@ -213,6 +226,12 @@ public:
    * \note This function covers the increase in age and the simple 'doesmove' option for movement between stocks
    */
   void updateAgesOneArea(int area = 0);
+  /**
+   * \brief This function will find the checkpoint that the simulation can be restarted from
+   * \param val is the DoubleVector containing the values of the parameters for the simulation
+   * \return the identifier of the latest checkpoint before any of the changed parameters are used, or -1 if the simulation cannot be restarted
+   */
+  int findCheckpoint(const DoubleVector& val) const;
   /**
    * \brief This function will update the model parameters, run the model and calculate a likelihood score
    * \param x is the DoubleVector containing the updated values for the parameters
@@ -220,6 +239,56 @@ public:
    * \note This function gets updated values for the model parameters from the optimisation algorithm and performs a model run based on these new values, calculating a new likelihood score that is then returned to the optimisation algorithm
    */
   double SimulateAndUpdate(const DoubleVector& x);
+  /**
+   * \brief This function will calculate the values of all the model parameters from the scaled values of the parameters being optimised
+   * \param x is the DoubleVector containing the scaled values of the parameters being optimised
+   * \param val is the DoubleVector that will contain the values of all the model parameters
+   */
+  void getUpdatedValues(const DoubleVector& x, DoubleVector& val);
+  /**
+   * \brief This function will choose the starting points for the optimisation, using a latin hypercube design within the bounds of the optimised parameters
+   * \note The first starting point is given by the initial values of the parameters, and the other starting points are spread out so that each one is in a different part of the range of each parameter
+   */
+  void drawStartingPoints();
+  /**
+   * \brief This function will set the values of the optimised parameters in a DoubleVector of the values of all the model parameters
+   * \param x is the DoubleVector containing the values of the optimised parameters
+   * \param val is the DoubleVector containing the values of all the model parameters
+   * \param opt is the IntVector of flags used to denote whether each parameter is optimised
+   */
+  void setOptValues(const DoubleVector& x, DoubleVector& val, const IntVector& opt) const;
+  /**
+   * \brief This function will read the points stored in an evaluation cache file, and store any new points evaluated in this file
+   * \param filename is the name of the evaluation cache file
+   * \param sum is the checksum of the model files
+   */
+  void openEvalCache(const char* filename, unsigned long sum);
+  /**
+   * \brief This function will set the files used to store and restore the state of the optimisation
+   * \param outfilename is the name of the file that the state of the optimisation will be stored in (or NULL)
+   * \param interval is the number of seconds between storing the state of the optimisation
+   * \param infilename is the name of the file that the state of the optimisation will be restored from (or NULL)
+   * \param sum is the checksum of the model files
+   */
+  void openOptCheckpoint(const char* outfilename, int interval, const char* infilename, unsigned long sum);
+  /**
+   * \brief This function will store or restore the state of the model used by the optimisation checkpoint
+   * \note This includes the current and best values of the parameters, the number of function evaluations and the results from each optimisation algorithm
+   */
+  void transferCheckpoint();
+  /**
+   * \brief This function will write the results of the optimisation from each starting point to file
+   * \param filename is the name of the file to write the results to
+   * \param prec is the precision to use in the output file
+   */
+  void writeMultiStart(const char* const filename, int prec) const;
+#ifdef _OPENMP
+  /**
+   * \brief This function will return the flag used to denote whether the function evaluations are calculated on the MPI slave processes
+   * \return flag
+   */
+  int runDistributed() const;
+#endif
   /**
    * \brief This function will return the likelihood score from the current simulation
    * \return likelihood score
@@ -230,6 +299,12 @@ public:
    * \return number of iterations
    */
   int getFuncEval() const { return funceval; };
+  /**
+   * \brief This function will add to the number of function evaluations that have been calculated using this Ecosystem
+   * \param num is the number of function evaluations to add
+   * \note This is used for the points that are evaluated without running the model on this Ecosystem, such as the points sent to the MPI slave processes
+   */
+  void countFuncEval(int num) { funceval += num; };
   /**
    * \brief This function will return the current time in the simulation
    * \return current time
@@ -296,6 +371,16 @@ protected:
    * \brief This is the LikelihoodPtrVector of the likelihood components for the current model
    */
   LikelihoodPtrVector likevec;
+  /**
+   * \brief This is the IntMatrix of the likelihood components that need to be calculated on each timestep
+   * \note The rows are indexed by the timestep, and each row lists the position in likevec of the likelihood components that are active on that timestep, in the order that they are in likevec
+   */
+  IntMatrix likesteps;
+  /**
+   * \brief This is the IntVector of the flags used to denote whether the likelihood components can be calculated in parallel on each timestep
+   * \note This is 0 for the timesteps when one of the active likelihood components changes the model
+   */
+  IntVector likeparallel;
   /**
    * \brief This is the PrinterPtrVector of the printer classes for the current model
    */
@@ -316,6 +401,10 @@ protected:
    * \brief This is the Keeper for the current model
    */
   Keeper* keeper;
+  /**
+   * \brief This is the AggregationPlanner used to share the aggregators between the likelihood components for the current model
+   */
+  AggregationPlanner* planner;
   /**
    * \brief This is the StockPtrVector of the stocks for the current model
    */
@@ -355,7 +444,70 @@ protected:
    * \note This vector is only used to temporarily store values during an optimising run
    */
   IntVector optflag;
-
+  /**
+   * \brief This is the number of years between the checkpoints stored during each simulation (0 for no checkpoints)
+   */
+  int simcheckpoint;
+  /**
+   * \brief This is the IntVector used to store the timesteps when the checkpoints are stored during each simulation
+   */
+  IntVector checkpointtime;
+  /**
+   * \brief This is the IntVector used to store the first timestep when each of the parameters is used
+   */
+  IntVector firstuse;
+  /**
+   * \brief This is the DoubleVector used to store the values of the parameters used in the last simulation
+   */
+  DoubleVector simulatedval;
+  /**
+   * \brief This is the flag used to denote whether the checkpoints stored during the last simulation are valid
+   */
+  int checkpointvalid;
+  /**
+   * \brief This is the flag used to denote whether the likelihood scores for the points evaluated during the optimisation are stored in the evaluation cache
+   */
+  int evalcache;
+  /**
+   * \brief This is the flag used to denote whether the likelihood score for the last point was found in the evaluation cache, so the modelled population is not for that point
+   */
+  int cachehit;
+  /**
+   * \brief This is the DoubleVector used to store the likelihood scores from each likelihood component, followed by the values of the parameters at the end of the simulation, for the evaluation cache
+   */
+  DoubleVector cachescore;
+  /**
+   * \brief This is the DoubleVector used to store the values of the parameters at the end of the simulation for the evaluation cache
+   */
+  DoubleVector cachevalues;
+  /**
+   * \brief This is the number of starting points for the optimisation (0 for the single starting point given in the input file)
+   */
+  int multistart;
+  /**
+   * \brief This is the relative tolerance used to stop the optimisation from a starting point when its likelihood score is worse than the best score found from the other starting points
+   */
+  double multistarttol;
+  /**
+   * \brief This is the DoubleMatrix used to store the values of the optimised parameters at each starting point
+   */
+  DoubleMatrix startval;
+  /**
+   * \brief This is the DoubleMatrix used to store the best values of the optimised parameters found from each starting point
+   */
+  DoubleMatrix startbestval;
+  /**
+   * \brief This is the DoubleMatrix used to store the best likelihood score found from each starting point after each optimisation algorithm
+   */
+  DoubleMatrix startscore;
+  /**
+   * \brief This is the IntVector used to store the number of optimisation algorithms that have finished for each starting point
+   */
+  IntVector startdone;
+  /**
+   * \brief This is the IntVector used to store the flags used to denote whether the optimisation from each starting point has been stopped early
+   */
+  IntVector startstop;
 
   ofstream  convergence_best;
   ofstream  convergence_time;
@@ -373,6 +525,14 @@ protected:
   const int static SPECULATIVE=1;
   const int static REPRODUCIBLE=2;
   int runParallel;
+  /**
+   * \brief This is the flag used to denote whether the areas are updated in parallel during each simulation
+   */
+  int runAreaParallel;
+  /**
+   * \brief This is the flag used to denote whether the likelihood components are calculated in parallel during each simulation
+   */
+  int runLikeParallel;
 #endif
 };
 
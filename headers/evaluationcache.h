@@ -0,0 +1,75 @@
+#ifndef evaluationcache_h
+#define evaluationcache_h
+
+#include "doublevector.h"
+#include "gadget.h"
+#include <map>
+#include <vector>
+
+/**
+ * \class EvaluationCache
+ * \brief This is the class used to store the likelihood scores for the points that have already been evaluated during an optimisation
+ *
+ * The likelihood scores from each likelihood component, and the values of the model parameters at the end of the simulation (since the boundlikelihood component can move the parameters back within the bounds), are stored for every point that has been evaluated, indexed by the values of all the model parameters.  If an optimisation algorithm needs to evaluate a point that has already been evaluated then the likelihood scores can be found from the cache without running the model again.  The cache is shared between all the Ecosystem objects, so a point evaluated by one of the threads of a parallel optimisation will be found by the other threads.  The cache can also be written to file, so that the points evaluated during an earlier optimisation run can be used to speed up a later run of the same model.
+ *
+ * \note The values of the parameters have to be exactly the same for the likelihood scores to be found from the cache, so using the cache will not change the results from the optimisation
+ */
+class EvaluationCache {
+public:
+  /**
+   * \brief This function will look for a point in the cache
+   * \param val is the DoubleVector containing the values of all the model parameters
+   * \param score is the DoubleVector that will contain the likelihood scores from each likelihood component followed by the values of the parameters at the end of the simulation, if the point is found
+   * \return 1 if the point is found in the cache, 0 otherwise
+   */
+  static int Find(const DoubleVector& val, DoubleVector& score);
+  /**
+   * \brief This function will store a point in the cache, and write it to the cache file if there is one
+   * \param val is the DoubleVector containing the values of all the model parameters
+   * \param score is the DoubleVector containing the likelihood scores from each likelihood component followed by the values of the parameters at the end of the simulation
+   */
+  static void Store(const DoubleVector& val, const DoubleVector& score);
+  /**
+   * \brief This function will read the points stored in a cache file, and open the file so that new points will be written to it
+   * \param filename is the name of the cache file
+   * \param sum is the checksum of the model files, used to check that the cache file was created from the same model
+   * \param numvar is the number of model parameters
+   * \param numlike is the number of likelihood components
+   */
+  static void openFile(const char* filename, unsigned long sum, int numvar, int numlike);
+  /**
+   * \brief This function will close the cache file
+   */
+  static void closeFile();
+  /**
+   * \brief This function will return the number of points stored in the cache
+   * \return number of points
+   */
+  static int numPoints();
+  /**
+   * \brief This function will return the number of points that have been found in the cache
+   * \return number of points found
+   */
+  static int numFound() { return numfound; };
+private:
+  /**
+   * \brief This function will write a point to the cache file
+   * \param key is the vector containing the values of all the model parameters
+   * \param entry is the vector containing the likelihood scores and the values of the parameters at the end of the simulation
+   */
+  static void writePoint(const vector<double>& key, const vector<double>& entry);
+  /**
+   * \brief This is the cache, containing the likelihood scores and the values of the parameters at the end of the simulation, indexed by the values of the model parameters
+   */
+  static map<vector<double>, vector<double> > cache;
+  /**
+   * \brief This is the ofstream that the new points are written to
+   */
+  static ofstream outfile;
+  /**
+   * \brief This is the number of points that have been found in the cache
+   */
+  static int numfound;
+};
+
+#endif
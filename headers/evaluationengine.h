@@ -0,0 +1,131 @@
+#ifndef evaluationengine_h
+#define evaluationengine_h
+
+#include "doublematrix.h"
+#include "intvector.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+class Ecosystem;
+
+/**
+ * \class EvaluationEngine
+ * \brief This is the class used by the optimisation algorithms to calculate the likelihood scores for the points that they need to evaluate
+ *
+ * The evaluation engine owns the copies of the model that are used when Gadget is run in parallel.  A batch of points is shared out between the copies of the model, with each thread taking the next point as soon as it has finished the previous one, or the points are sent to the slave processes if this is an MPI run.  A single point can also be evaluated from within a parallel region, by checking out a copy of the model that is not being used by any other thread.  Points can be submitted one at a time, and the likelihood scores collected later, so that the points that an optimisation algorithm needs are evaluated together as one batch.
+ *
+ * The function evaluations are counted on the copies of the model that calculated them, and the total number of function evaluations is the same however the points were evaluated.  If the evaluation cache is used, then a point that appears more than once in a batch is only simulated once.
+ * \note If Gadget is not run in parallel then the points are evaluated one after another using the main model
+ */
+class EvaluationEngine {
+public:
+  /**
+   * \brief This function will set the copies of the model that are used to evaluate the points
+   * \param eco is the array of the copies of the model
+   * \param num is the number of copies of the model
+   */
+  static void setReplicas(Ecosystem** eco, int num);
+  /**
+   * \brief This function will set the flag used to denote whether the evaluation cache is used
+   * \param flag is the flag used to denote whether the evaluation cache is used
+   */
+  static void setCache(int flag) { usecache = flag; };
+  /**
+   * \brief This function will calculate the likelihood scores for a batch of points
+   * \param x is the DoubleMatrix containing the scaled values of the optimised parameters for each point
+   * \param f is the DoubleVector that will contain the likelihood score for each point
+   * \param first is the first point (row of x) to be evaluated
+   * \param last is the point (row of x) after the last point to be evaluated
+   */
+  static void Evaluate(const DoubleMatrix& x, DoubleVector& f, int first, int last);
+  /**
+   * \brief This function will calculate the likelihood score for one point, using a copy of the model that is not being used by any other thread
+   * \param x is the DoubleVector containing the scaled values of the optimised parameters
+   * \return likelihood score
+   * \note This function can be called from within a parallel region
+   */
+  static double Evaluate(const DoubleVector& x);
+  /**
+   * \brief This function will submit a point to be evaluated with the next batch of points
+   * \param x is the DoubleVector containing the scaled values of the optimised parameters
+   * \return the ticket used to collect the likelihood score
+   * \note The submitted points are only evaluated when one of the likelihood scores is needed, so this function must not be called from within a parallel region
+   */
+  static int Submit(const DoubleVector& x);
+  /**
+   * \brief This function will return the likelihood score for a submitted point, evaluating all the submitted points that have not been evaluated yet
+   * \param ticket is the ticket returned when the point was submitted
+   * \return likelihood score
+   */
+  static double Wait(int ticket);
+  /**
+   * \brief This function will return the flag used to denote whether a submitted point has been evaluated
+   * \param ticket is the ticket returned when the point was submitted
+   * \return 1 if the point has been evaluated, 0 otherwise
+   */
+  static int isReady(int ticket);
+  /**
+   * \brief This function will evaluate all the submitted points that have not been evaluated yet
+   */
+  static void Flush();
+  /**
+   * \brief This function will return the total number of function evaluations, from the main model and all the copies of the model
+   * \return number of function evaluations
+   */
+  static int numEvaluations();
+  /**
+   * \brief This function will check out a copy of the model that is not being used by any other thread
+   * \return the number of the copy of the model
+   */
+  static int checkOut();
+  /**
+   * \brief This function will return a copy of the model that was checked out, so that it can be used by other threads
+   * \param id is the number of the copy of the model
+   */
+  static void checkIn(int id);
+private:
+  /**
+   * \brief This is the array of the copies of the model that are used to evaluate the points
+   */
+  static Ecosystem** replicas;
+  /**
+   * \brief This is the number of copies of the model
+   */
+  static int numreplicas;
+#ifdef _OPENMP
+  /**
+   * \brief This is the array of the locks used to check out each copy of the model
+   * \note A thread that cant find a free copy of the model blocks on one of these locks until that copy is checked in
+   */
+  static omp_lock_t* locks;
+#else
+  /**
+   * \brief This is the IntVector of flags used to denote whether each copy of the model has been checked out
+   */
+  static IntVector busy;
+#endif
+  /**
+   * \brief This is the flag used to denote whether the evaluation cache is used
+   */
+  static int usecache;
+  /**
+   * \brief This is the DoubleMatrix of the points that have been submitted
+   */
+  static DoubleMatrix pending;
+  /**
+   * \brief This is the DoubleVector of the likelihood scores for the points that have been submitted
+   */
+  static DoubleVector results;
+  /**
+   * \brief This is the number of submitted points that have been evaluated
+   */
+  static int numdone;
+  /**
+   * \brief This is the number of submitted points whose likelihood scores have not been collected
+   */
+  static int numwaiting;
+};
+
+#endif
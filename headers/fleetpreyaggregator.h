@@ -11,6 +11,10 @@
 #include "preyptrvector.h"
 #include "intmatrix.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /**
  * \class FleetPreyAggregator
  * \brief This is the class used to aggregate fleet catch information
@@ -41,6 +45,14 @@ public:
    * \brief This function will aggregate the fleet catch data
    */
   void Sum();
+  /**
+   * \brief This function will mark the aggregator as shared between likelihood components, so that the data is only aggregated once on each timestep
+   */
+  void setShared();
+  /**
+   * \brief This function will mark the aggregator as not summed for the current timestep
+   */
+  void clearSum() { summed = 0; };
   /**
    * \brief This function will check the fleet catch data
    * \return 1 if there is no catch data found, 0 otherwise
@@ -102,6 +114,24 @@ private:
    * \brief This is the AgeBandMatrix used to temporarily store information when aggregating the catch
    */
   const AgeBandMatrix* alptr;
+  /**
+   * \brief This is the flag used to denote whether the aggregator is shared between likelihood components
+   */
+  int shared;
+  /**
+   * \brief This is the flag used to denote whether the shared aggregator has been summed on the current timestep
+   */
+  int summed;
+#ifdef _OPENMP
+  /**
+   * \brief This is the lock used to make sure that a shared aggregator is only summed by one likelihood component at a time
+   */
+  omp_lock_t sumlock;
+#endif
+  /**
+   * \brief This function will add up the fleet catch data
+   */
+  void calcSum();
 };
 
 #endif
@@ -62,6 +62,12 @@ public:
    * \param keeper is the Keeper for the current model
    */
   void Inform(Keeper* keeper);
+  /**
+   * \brief This function will inform the Keeper for the current model of the first timestep when the Formula is used
+   * \param keeper is the Keeper for the current model
+   * \param time is the first timestep when the Formula is used
+   */
+  void setFirstUse(Keeper* keeper, int time) const;
   /**
    * \brief This function will delete a Formula value
    * \param keeper is the Keeper for the current model
@@ -92,15 +92,13 @@ public:
    * \param area is the area that the growth is being calculated on
    * \return lgrowth, a DoubleMatrix containing the length increase
    */
-//  const DoubleMatrix& getLengthIncrease(int area) const { return *lgrowth[this->areaNum(area)]; };
-  const Matrix& getLengthIncrease(int area) const { return *lgrowth; };
+  const Matrix& getLengthIncrease(int area) const { return lgrowth[this->areaNum(area)]; };
   /**
    * \brief This function will return the calculated weight increase due to growth on an area
    * \param area is the area that the growth is being calculated on
    * \return wgrowth, a DoubleMatrix containing the weight increase
    */
-//  const DoubleMatrix& getWeightIncrease(int area) const { return *wgrowth[this->areaNum(area)]; };
-  const Matrix& getWeightIncrease(int area) const { return *wgrowth; };
+  const Matrix& getWeightIncrease(int area) const { return wgrowth[this->areaNum(area)]; };
   /**
    * \brief This function will return the fixed weight increase due to growth on an area
    * \param area is the area that the growth is being calculated on
@@ -185,14 +183,6 @@ protected:
    * \brief This is the maximum number of length groups that an individual fish from the stock can grow on one timestep
    */
   int maxlengthgroupgrowth;
-  /**
-   * \brief This is the mean growth, as calculated for this length group by the GrowthCalc function
-   */
-  double growth;
-  /**
-   * \brief This is the value of alpha in the beta binomial distribution
-   */
-  double alpha;
   /**
    * \brief This is the value of beta in the beta binomial distribution
    */
@@ -208,15 +198,10 @@ protected:
    */
   DoubleVector part2;
   /**
-   * \brief This is a double used when calculating the beta binomial distribution
-   * \note This stores the value of gamma(alpha+beta)/gamma(n+alpha+beta)
-   */
-  double part3;
-  /**
-   * \brief This is a DoubleVector used when calculating the beta binomial distribution
+   * \brief This is a DoubleMatrix used when calculating the beta binomial distribution, with one row for each area
    * \note This stores the value of gamma(x+alpha)/gamma(x)
    */
-  DoubleVector part4;
+  DoubleMatrix part4;
 };
 
 #endif
@@ -103,6 +103,11 @@ public:
    * \param val is the DoubleVector that will contain a copy of the initial values
    */
   void getInitialValues(DoubleVector& val) const;
+  /**
+   * \brief This function will set the initial value of the variables, used to scale the variables
+   * \param val is the DoubleVector containing the initial values
+   */
+  void setInitialValues(const DoubleVector& val);
   /**
    * \brief This function will return a copy of the scaled value of the variables
    * \param val is the DoubleVector that will contain a copy of the scaled values
@@ -113,6 +118,18 @@ public:
    * \param val is the DoubleVector that will contain a copy of the current values
    */
   void getCurrentValues(DoubleVector& val) const;
+  /**
+   * \brief This function will return the first timestep when each of the variables is used in the model simulation
+   * \param firstuse is the IntVector that will contain the first timestep when each variable is used
+   */
+  void getFirstUse(IntVector& firstuse) const;
+  /**
+   * \brief This function will set the first timestep when a variable is used in the model simulation
+   * \param var is the variable that is used
+   * \param time is the first timestep when the variable is used
+   * \note This should only be set for variables that are not used before this timestep, since a simulation that is restarted from a checkpoint will not recalculate anything that depends on them on the earlier timesteps
+   */
+  void setFirstUse(const double& var, int time);
   /**
    * \brief This function will return a copy of the lower bounds of the variables to be optimised
    * \param lbs is the DoubleVector that will contain a copy of the lower bounds
@@ -175,6 +192,15 @@ public:
    * \param prec is the precision to use in the output file
    */
   void writeValues(const LikelihoodPtrVector& likevec, int prec);
+  /**
+   * \brief This function will write information about the model parameters from a simulation to file
+   * \param val is the DoubleVector containing the values of the parameters used in the simulation
+   * \param likevec is the LikelihoodPtrVector containing the likelihood components from the simulation
+   * \param likelihood is the likelihood score from the simulation
+   * \param prec is the precision to use in the output file
+   * \note This is used when the simulation has been run on a copy of the model, but the information is written to the output file opened by this Keeper
+   */
+  void writeValues(const DoubleVector& val, const LikelihoodPtrVector& likevec, double likelihood, int prec);
   /**
    * \brief This function will write final information about the model parameters to file in a column format (which can then be used as the starting point for a subsequent model run)
    * \param optvec is the OptInfoPtrVector containing the optimisation algorithms used for the current model
@@ -202,6 +228,11 @@ public:
    * \return bestlikelihood
    */
   double getBestLikelihoodScore() const { return bestlikelihood; };
+  /**
+   * \brief This function will return the best values of the variables that are being optimised
+   * \param val is the DoubleVector that will contain the best values of the optimised variables
+   */
+  void getOptBestValues(DoubleVector& val) const;
   /**
    * \brief This function will return the DoubleVector used to store the values of the parameters
    * \return values
@@ -5,6 +5,7 @@
 #include "fleetptrvector.h"
 #include "printinfo.h"
 #include "hasname.h"
+#include "doublevector.h"
 #include "gadget.h"
 
 class TimeClass;
@@ -48,6 +49,21 @@ public:
    * \param keeper is the Keeper for the current model
    */
   virtual void addLikelihoodKeeper(const TimeClass* const TimeInfo, Keeper* const keeper) {};
+  /**
+   * \brief This function will check whether the likelihood component needs to be calculated on a given timestep
+   * \param year is the year of the timestep to check
+   * \param step is the step of the timestep to check
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if the likelihood score can change on the timestep, 0 otherwise
+   * \note This will be overridden by the likelihood components that are only calculated on the timesteps that they have data for, so that the other components are not called on those timesteps
+   */
+  virtual int isActive(int year, int step, const TimeClass* const TimeInfo) const { return 1; };
+  /**
+   * \brief This function will check whether the likelihood component only reads the model when the likelihood score is calculated
+   * \return 1 if the likelihood component doesnt change the model, 0 otherwise
+   * \note The likelihood components that only read the model can be calculated in parallel, since each component stores its own likelihood score
+   */
+  virtual int isReadOnly() const { return 1; };
   /**
    * \brief This function will reset the likelihood information
    * \param keeper is the Keeper for the current model
@@ -58,6 +74,27 @@ public:
    * \param keeper is the Keeper for the current model
    */
   virtual void Reset(const TimeClass* const TimeInfo) {};
+  /**
+   * \brief This function will check whether the likelihood component can be restarted part way through the simulation
+   * \return 1 if the likelihood component can be restarted from a checkpoint, 0 otherwise
+   * \note This will be overridden by the likelihood components that only store information indexed by the timestep, so that restoring the likelihood score is all that is needed to restart the calculation
+   */
+  virtual int canRestart() const { return 0; };
+  /**
+   * \brief This function will store the likelihood information at a checkpoint
+   * \param id is the identifier of the checkpoint
+   */
+  virtual void storeState(int id) {
+    if (id >= storedlikelihood.Size())
+      storedlikelihood.resize(id + 1 - storedlikelihood.Size(), 0.0);
+    storedlikelihood[id] = likelihood;
+  };
+  /**
+   * \brief This function will restore the likelihood information that was stored at a checkpoint
+   * \param id is the identifier of the checkpoint
+   * \param TimeInfo is the TimeClass for the current model
+   */
+  virtual void restoreState(int id, const TimeClass* const TimeInfo) { likelihood = storedlikelihood[id]; };
   /**
    * \brief This function will print the summary likelihood information
    * \param outfile is the ofstream that all the model information gets sent to
@@ -69,6 +106,11 @@ public:
    * \param TimeInfo is the TimeClass for the current model
    */
   virtual void printLikelihood(ofstream& outfile, const TimeClass* const TimeInfo) {};
+  /**
+   * \brief This function will set the flag to denote that the information from the likelihood calculation will be printed
+   * \note The likelihood components can use this to avoid storing the modelled data when it isnt needed
+   */
+  virtual void setPrintModel() {};
   /**
    * \brief This function will print summary information from each likelihood calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
@@ -89,6 +131,12 @@ public:
    * \return likelihood
    */
   double getUnweightedLikelihood() const { return likelihood; };
+  /**
+   * \brief This will set the unweighted likelihood score for the likelihood component
+   * \param value is the unweighted likelihood score
+   * \note This is used when the likelihood score has been found from the evaluation cache instead of being calculated
+   */
+  void setUnweightedLikelihood(double value) { likelihood = value; };
   /**
    * \brief This will return the weight applied to the likelihood component
    * \return weight
@@ -109,6 +157,10 @@ protected:
    * \brief This stores the weight to be applied to the likelihood component
    */
   double weight;
+  /**
+   * \brief This stores the likelihood score at each checkpoint of the simulation
+   */
+  DoubleVector storedlikelihood;
 private:
   /**
    * \brief This denotes what type of likelihood class has been created
@@ -71,6 +71,26 @@ public:
    * \param filename is the name of the file
    */
   void setOptInfoFile(char* filename);
+  /**
+   * \brief This function will set the filename that the evaluation cache will be stored in
+   * \param filename is the name of the file
+   */
+  void setEvalCacheFile(char* filename);
+  /**
+   * \brief This function will set the filename that the state of the optimisation will be stored in
+   * \param filename is the name of the file
+   */
+  void setOptCheckpointFile(char* filename);
+  /**
+   * \brief This function will set the filename that the state of the optimisation will be restored from
+   * \param filename is the name of the file
+   */
+  void setOptRestartFile(char* filename);
+  /**
+   * \brief This function will set the filename that the results from each starting point of a multiple start optimisation will be written to
+   * \param filename is the name of the file
+   */
+  void setMultiStartFile(char* filename);
   /**
    * \brief This function will return the flag used to determine whether the likelihood score should be optimised
    * \return flag
@@ -97,6 +117,21 @@ public:
    * \return flag
    */
   int runParallel() const { return runparallel; };
+  /**
+   * \brief This function will set the type of parallel optimisation to be used
+   * \param parallel is the type of parallel optimisation
+   */
+  void setRunParallel(int parallel) { runparallel = parallel; };
+  /**
+   * \brief This function will return the flag used to determine whether the areas should be updated in parallel during each simulation
+   * \return flag
+   */
+  int runAreaParallel() const { return runareaparallel; };
+  /**
+   * \brief This function will return the flag used to determine whether the likelihood components should be calculated in parallel during each simulation
+   * \return flag
+   */
+  int runLikeParallel() const { return runlikeparallel; };
 #endif
   /**
    * \brief This function will return the flag used to determine whether the optimisation parameters have been given
@@ -160,6 +195,51 @@ public:
   double getMaxRatio() const {
 	  return maxratio;
   }
+  /**
+   * \brief This function will return the number of years between the checkpoints stored during each simulation
+   * \return simcheckpoint
+   */
+  int getSimCheckpoint() const { return simcheckpoint; };
+  /**
+   * \brief This function will return the flag used to determine whether the likelihood scores for the points evaluated during the optimisation should be stored
+   * \return flag
+   */
+  int getEvalCache() const { return evalcache; };
+  /**
+   * \brief This function will return the filename that the evaluation cache will be stored in
+   * \return filename
+   */
+  char* getEvalCacheFile() const { return strEvalCacheFile; };
+  /**
+   * \brief This function will return the filename that the state of the optimisation will be stored in
+   * \return filename
+   */
+  char* getOptCheckpointFile() const { return strOptCheckpointFile; };
+  /**
+   * \brief This function will return the number of seconds between storing the state of the optimisation
+   * \return optcheckpointtime
+   */
+  int getOptCheckpointTime() const { return optcheckpointtime; };
+  /**
+   * \brief This function will return the filename that the state of the optimisation will be restored from
+   * \return filename
+   */
+  char* getOptRestartFile() const { return strOptRestartFile; };
+  /**
+   * \brief This function will return the number of starting points for the optimisation
+   * \return multistart
+   */
+  int getMultiStart() const { return multistart; };
+  /**
+   * \brief This function will return the relative tolerance used to decide whether the optimisation from one starting point should be stopped early
+   * \return multistarttol
+   */
+  double getMultiStartTolerance() const { return multistarttol; };
+  /**
+   * \brief This function will return the filename that the results from each starting point will be written to
+   * \return filename
+   */
+  char* getMultiStartFile() const { return strMultiStartFile; };
   /**
    * \brief This function will return seeds used in SA
    * \return seed array of unsigned int with the seeds used in SA
@@ -177,6 +257,22 @@ private:
    * \brief This is the name of the file that optimisation parameters will be read from
    */
   char* strOptInfoFile;
+  /**
+   * \brief This is the name of the file that the evaluation cache will be stored in
+   */
+  char* strEvalCacheFile;
+  /**
+   * \brief This is the name of the file that the state of the optimisation will be stored in
+   */
+  char* strOptCheckpointFile;
+  /**
+   * \brief This is the name of the file that the state of the optimisation will be restored from
+   */
+  char* strOptRestartFile;
+  /**
+   * \brief This is the name of the file that the results from each starting point of a multiple start optimisation will be written to
+   */
+  char* strMultiStartFile;
   /**
    * \brief This is the name of the file that initial values for the model parameters will be read from
    */
@@ -241,6 +337,26 @@ private:
    * \brief This is the maximum ratio of a stock that can be consumed on any given timestep
    */
   double maxratio;
+  /**
+   * \brief This is the number of years between the checkpoints stored during each simulation, so that later simulations can be restarted part way through (0 for no checkpoints)
+   */
+  int simcheckpoint;
+  /**
+   * \brief This is the flag used to denote whether the likelihood scores for the points evaluated during the optimisation should be stored, so that no point is simulated twice
+   */
+  int evalcache;
+  /**
+   * \brief This is the number of seconds between storing the state of the optimisation in the checkpoint file
+   */
+  int optcheckpointtime;
+  /**
+   * \brief This is the number of starting points for the optimisation (0 for the single starting point given in the input file)
+   */
+  int multistart;
+  /**
+   * \brief This is the relative tolerance used to stop the optimisation from a starting point when its likelihood score is worse than the best score found from the other starting points
+   */
+  double multistarttol;
   /**
    * \brief vector with the seeds used in SA
    * \note see[0] = seed | see[1] = seedM | see[2] = seedP
@@ -250,6 +366,14 @@ private:
   /**
    * \brief This is the flag used to denote whether the likelihood score should be optimised in pararrel   */
   int runparallel;
+  /**
+   * \brief This is the flag used to denote whether the areas should be updated in parallel during each simulation
+   */
+  int runareaparallel;
+  /**
+   * \brief This is the flag used to denote whether the likelihood components should be calculated in parallel during each simulation
+   */
+  int runlikeparallel;
 #endif
 };
 
@@ -28,6 +28,14 @@ public:
    * \param TimeInfo is the TimeClass for the current model
    */
   virtual void addLikelihood(const TimeClass* const TimeInfo);
+  /**
+   * \brief This function will check whether the MigrationPenalty component needs to be calculated on a given timestep
+   * \param year is the year of the timestep to check
+   * \param step is the step of the timestep to check
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if it is the last timestep, 0 otherwise
+   */
+  virtual int isActive(int year, int step, const TimeClass* const TimeInfo) const;
   /**
    * \brief This will select the fleets and stocks required to calculate the MigrationPenalty likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
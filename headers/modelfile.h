@@ -0,0 +1,69 @@
+#ifndef modelfile_h
+#define modelfile_h
+
+#include "gadget.h"
+#include <map>
+#include <string>
+
+/**
+ * \class ModelFile
+ * \brief This is the class used to read the input files for the model from an in-memory image of the files
+ *
+ * The first time that a file is opened the contents of the file are read from disk and stored in the model image, which is shared between all the ModelFile objects.  Any later attempt to open the same file will read the data from the copy stored in the model image, without accessing the filesystem.  This means that the Ecosystem copies used by the parallel optimisation algorithms can be created from the files that have already been read when the main Ecosystem was created.
+ *
+ * \note The files are identified by the name that was used to open them, so any file that has been stored in the model image will be found even after the current working directory has changed
+ */
+class ModelFile : public istream {
+public:
+  /**
+   * \brief This is the default ModelFile constructor
+   */
+  ModelFile();
+  /**
+   * \brief This is the default ModelFile destructor
+   */
+  ~ModelFile() {};
+  /**
+   * \brief This function will open a file to read from, using the copy stored in the model image if there is one
+   * \param filename is the name of the file to open
+   * \param mode is the mode to use when opening the file
+   * \note If the file cannot be opened then the failbit will be set for the stream
+   */
+  void open(const char* filename, ios::openmode mode = ios::in);
+  /**
+   * \brief This function will close the file
+   */
+  void close();
+  /**
+   * \brief This function will check to see if a file is open
+   * \return 1 if a file is open, 0 otherwise
+   */
+  int is_open() const { return isopen; };
+  /**
+   * \brief This function will remove all the files stored in the model image
+   * \note The model image can be cleared once all the Ecosystem objects have been created, to free the memory used to store the files
+   */
+  static void clearImage();
+  /**
+   * \brief This function will calculate a checksum of the files stored in the model image
+   * \param exclude is the name of a file that should not be included in the checksum (or NULL)
+   * \return checksum
+   * \note This is used to check that information stored on disk from an earlier run was created from the same model files
+   */
+  static unsigned long checksum(const char* exclude);
+private:
+  /**
+   * \brief This is the stringbuf containing the data from the file that is open
+   */
+  stringbuf buffer;
+  /**
+   * \brief This is the flag used to denote whether a file is open or not
+   */
+  int isopen;
+  /**
+   * \brief This is the model image, containing the data from each file that has been read, indexed by the name of the file
+   */
+  static map<string, string> image;
+};
+
+#endif
@@ -63,6 +63,7 @@ public:
    * \brief This function will check to see if the ModelVariable value has changed
    * \param TimeInfo is the TimeClass for the current model
    * \return 1 if the values have changed, 0 otherwise
+   * \note On the first timestep a formula is only considered to have changed if its value is different from the previous simulation
    */
   int didChange(const TimeClass* const TimeInfo);
   /**
@@ -91,6 +92,15 @@ private:
    * \brief This is the value of the ModelVariable
    */
   double value;
+  /**
+   * \brief This is the flag used to denote whether the value of a formula has changed since the previous simulation
+   * \note Cached values that are based on this ModelVariable only need to be recalculated on the first timestep of the simulation if this is set
+   */
+  int changed;
+  /**
+   * \brief This is the timestep when the ModelVariable value was last updated
+   */
+  int updatetime;
 };
 
 #endif
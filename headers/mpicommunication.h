@@ -0,0 +1,104 @@
+#ifndef mpicommunication_h
+#define mpicommunication_h
+
+#include "mpi.h"
+#include "doublematrix.h"
+#include "doublevector.h"
+
+class Ecosystem;
+
+/**
+ * \class MPICommunication
+ * \brief This is the class used to share the function evaluations from an optimisation between the MPI processes
+ *
+ * The first MPI process (the master) reads the model and runs the optimisation.  The other MPI processes (the slaves) also read the model, but only calculate the likelihood scores for the points that are sent to them by the master.  The points are sent to the slaves in batches, and a new batch is sent to each slave as soon as it has returned the results from the previous batch, so slower processes will be sent fewer points to evaluate.
+ */
+class MPICommunication {
+public:
+  /**
+   * \brief This is the default MPICommunication constructor
+   * \note This will initialise MPI, so this should be created before anything else in the model
+   */
+  MPICommunication();
+  /**
+   * \brief This is the default MPICommunication destructor
+   * \note This will finalise MPI, so the slave processes should already have been stopped
+   */
+  ~MPICommunication();
+  /**
+   * \brief This function will check whether the current process is the master process
+   * \return 1 if this is the master process, 0 otherwise
+   */
+  int isMaster() const { return (rank == 0); };
+  /**
+   * \brief This function will return the number of slave processes
+   * \return number of slave processes
+   */
+  int numSlaves() const { return size - 1; };
+  /**
+   * \brief This function will calculate the likelihood scores for the points sent from the master process, until the master process stops the slaves
+   * \param eco is the Ecosystem used to calculate the likelihood scores
+   */
+  void runSlave(Ecosystem* eco);
+  /**
+   * \brief This function will tell all the slave processes that there are no more points to evaluate
+   */
+  void stopSlaves();
+  /**
+   * \brief This function will calculate the likelihood scores for a batch of points on the slave processes
+   * \param val is the DoubleMatrix containing the values of all the parameters for each point
+   * \param f is the DoubleVector that will contain the likelihood score for each point
+   */
+  void Evaluate(const DoubleMatrix& val, DoubleVector& f);
+private:
+  /**
+   * \brief This function will send a batch of points to a slave process
+   * \param val is the DoubleMatrix containing the values of all the parameters for each point
+   * \param slave is the slave process to send the points to
+   * \param first is the first point (row of val) to be sent
+   * \param num is the number of points to be sent
+   */
+  void sendBatch(const DoubleMatrix& val, int slave, int first, int num);
+  /**
+   * \brief This is the identifier of the current MPI process
+   */
+  int rank;
+  /**
+   * \brief This is the total number of MPI processes
+   */
+  int size;
+  /**
+   * \brief This is the flag used to denote whether the slave processes have been stopped
+   */
+  int stopped;
+  /**
+   * \brief This is the buffer used to send the points to the slave processes
+   */
+  double* sendbuffer;
+  /**
+   * \brief This is the size of the buffer used to send the points to the slave processes
+   */
+  int sendsize;
+  /**
+   * \brief This is the buffer used to receive the likelihood scores from the slave processes
+   */
+  double* recvbuffer;
+  /**
+   * \brief This is the size of the buffer used to receive the likelihood scores from the slave processes
+   */
+  int recvsize;
+  /**
+   * \brief This is the MPI tag used when sending points to be evaluated
+   */
+  static const int WORKTAG = 1;
+  /**
+   * \brief This is the MPI tag used when sending the likelihood scores back to the master
+   */
+  static const int RESULTTAG = 2;
+  /**
+   * \brief This is the MPI tag used to stop the slave processes
+   */
+  static const int STOPTAG = 3;
+};
+
+#endif
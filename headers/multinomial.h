@@ -33,6 +33,21 @@ public:
    * \return likelihood
    */
   double calcLogLikelihood(const DoubleVector& data, const DoubleVector& dist);
+  /**
+   * \brief This is the function that calculates a log likelihood score by comparing 2 vectors based on a multinomial distribution, using a precalculated value for the terms that only depend on the input data
+   * \param data is the DoubleVector containing the input data
+   * \param dist is the DoubleVector containing the modelled data
+   * \param sumlog is the value of the terms that only depend on the input data, as returned by calcDataConstant
+   * \return likelihood
+   */
+  double calcLogLikelihood(const DoubleVector& data, const DoubleVector& dist, double sumlog);
+  /**
+   * \brief This function will calculate the terms of the log likelihood score that only depend on the input data
+   * \param data is the DoubleVector containing the input data
+   * \return the sum of the log factorials of the input data, less the log factorial of the sum of the input data
+   * \note The input data doesnt change during the optimisation, so this only needs to be calculated once
+   */
+  double calcDataConstant(const DoubleVector& data) const;
   /**
    * \brief This will return the log likelihood score
    * \return loglikelihood
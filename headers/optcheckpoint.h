@@ -0,0 +1,196 @@
+#ifndef optcheckpoint_h
+#define optcheckpoint_h
+
+#include "doublematrix.h"
+#include "populationmatrix.h"
+#include "doublevector.h"
+#include "intvector.h"
+#include "gadget.h"
+#include <vector>
+
+/**
+ * \class OptCheckpoint
+ * \brief This is the class used to store the state of the optimisation in a checkpoint file, so that a long optimisation run can be restarted from the checkpoint
+ *
+ * The checkpoint file contains the number of the current optimisation algorithm in the list of algorithms that are used, the state of the model at the start of that optimisation algorithm and, if the algorithm has stored it, the complete internal state of the optimisation algorithm at the start of one of its iterations.  When the optimisation is restarted from the checkpoint file, the algorithms that had finished are skipped and the current algorithm continues from the iteration that was stored, so the restarted optimisation will give exactly the same results as an optimisation run that had not been interrupted.
+ *
+ * The optimisation algorithms store their state by calling Start() at the start of each iteration and, if that returns 1, calling Transfer() for each of the variables that make up the state of the algorithm followed by Finish().  The same code is used to restore the state of the algorithm, since Transfer() will read the variables from the checkpoint file when the optimisation is being restarted.
+ *
+ * \note The C library random number generator used by the Hooke & Jeeves algorithm cannot be stored, so the random numbers used during the optimisation are counted and the same number of random numbers are generated when the optimisation is restarted.  This will only give the same random numbers if the random number generator has been seeded with the same value
+ * \note The checkpoint file is a binary file, and can only be used on the same type of computer and with the same model files
+ */
+class OptCheckpoint {
+public:
+  /**
+   * \brief This function will set the file that the state of the optimisation will be stored in
+   * \param filename is the name of the checkpoint file
+   * \param interval is the number of seconds between storing the state of the optimisation
+   * \param sum is the checksum of the model files, used to check that the checkpoint file is used with the same model
+   * \param numvar is the number of model parameters
+   * \param numopt is the number of optimisation algorithms
+   */
+  static void setFile(const char* filename, int interval, unsigned long sum, int numvar, int numopt);
+  /**
+   * \brief This function will read the state of the optimisation from a checkpoint file, so that the optimisation can be restarted
+   * \param filename is the name of the checkpoint file
+   * \param sum is the checksum of the model files, used to check that the checkpoint file was created from the same model
+   * \param numvar is the number of model parameters
+   * \param numopt is the number of optimisation algorithms
+   */
+  static void readFile(const char* filename, unsigned long sum, int numvar, int numopt);
+  /**
+   * \brief This function will store or restore the state of the model at the start of an optimisation algorithm
+   * \param opt is the number of the optimisation algorithm that is about to start
+   * \return 1 if the optimisation algorithm should be run, 0 if it had finished before the checkpoint was stored
+   */
+  static int startOptimisation(int opt);
+  /**
+   * \brief This function will check whether the state of the optimisation algorithm should be stored or restored at the start of the current iteration
+   * \param type is the type of the optimisation algorithm (see OptType)
+   * \return 1 if the state of the optimisation algorithm should be transferred, 0 otherwise
+   */
+  static int Start(int type);
+  /**
+   * \brief This function will finish storing the state of the optimisation algorithm, and write it to the checkpoint file, or finish restoring the state of the optimisation algorithm
+   */
+  static void Finish();
+  /**
+   * \brief This function will discard the stored state of the current optimisation algorithm, for algorithms that cannot be restarted part way through
+   */
+  static void Discard();
+  /**
+   * \brief This function will store or restore an integer value
+   * \param value is the value
+   */
+  static void Transfer(int& value);
+  /**
+   * \brief This function will store or restore an unsigned integer value
+   * \param value is the value
+   */
+  static void Transfer(unsigned& value);
+  /**
+   * \brief This function will store or restore a double value
+   * \param value is the value
+   */
+  static void Transfer(double& value);
+  /**
+   * \brief This function will store or restore the values in an IntVector
+   * \param vec is the IntVector, which will be resized if needed
+   */
+  static void Transfer(IntVector& vec);
+  /**
+   * \brief This function will store or restore the values in a DoubleVector
+   * \param vec is the DoubleVector, which will be resized if needed
+   */
+  static void Transfer(DoubleVector& vec);
+  /**
+   * \brief This function will store or restore the values in a DoubleMatrix
+   * \param mat is the DoubleMatrix, which will be resized if needed
+   */
+  static void Transfer(DoubleMatrix& mat);
+  /**
+   * \brief This function will store or restore the values in a PopulationMatrix
+   * \param mat is the PopulationMatrix, which will be resized if needed
+   */
+  static void Transfer(PopulationMatrix& mat);
+  /**
+   * \brief This function will return a random number from the C library random number generator, and count the number of random numbers that have been used
+   * \return random number
+   */
+  static int randomInteger();
+  /**
+   * \brief This function will return the flag used to denote whether the state of the optimisation is being restored
+   * \return flag
+   */
+  static int isRestoring() { return (mode == READ); };
+private:
+  /**
+   * \brief This function will store or restore a block of memory
+   * \param data is the block of memory
+   * \param num is the number of bytes
+   */
+  static void transferBytes(void* data, int num);
+  /**
+   * \brief This function will write the stored state of the optimisation to the checkpoint file
+   * \param inopt is the flag used to denote whether the state of the current optimisation algorithm should be written
+   */
+  static void writeFile(int inopt);
+  /**
+   * \brief This function will store or restore the number of random numbers that have been used, generating any random numbers needed to restore the state of the random number generator
+   */
+  static void transferRandom();
+  /**
+   * \brief This denotes whether the state is being stored or restored
+   */
+  enum TransferMode { NONE = 0, WRITE, READ };
+  /**
+   * \brief This is the name of the checkpoint file that the state will be written to
+   */
+  static char* outfilename;
+  /**
+   * \brief This is the number of seconds between storing the state of the optimisation
+   */
+  static int interval;
+  /**
+   * \brief This is the time that the state of the optimisation was last stored
+   */
+  static time_t lasttime;
+  /**
+   * \brief This is the checksum of the model files
+   */
+  static unsigned long checksum;
+  /**
+   * \brief This is the number of model parameters
+   */
+  static int numvariables;
+  /**
+   * \brief This is the number of optimisation algorithms
+   */
+  static int numoptimisations;
+  /**
+   * \brief This is the number of the current optimisation algorithm
+   */
+  static int current;
+  /**
+   * \brief This is the number of the optimisation algorithm that will be restarted
+   */
+  static int restart;
+  /**
+   * \brief This is the flag used to denote whether there is a stored state of the optimisation algorithm to restore
+   */
+  static int pending;
+  /**
+   * \brief This denotes whether the state is being stored or restored
+   */
+  static TransferMode mode;
+  /**
+   * \brief This is the state of the model at the start of the current optimisation algorithm
+   */
+  static vector<char> startbuffer;
+  /**
+   * \brief This is the buffer that the state is stored in before it is written to the checkpoint file
+   */
+  static vector<char> buffer;
+  /**
+   * \brief This is the contents of the checkpoint file that the state is restored from
+   */
+  static vector<char> restorebuffer;
+  /**
+   * \brief This is the current position in the contents of the checkpoint file
+   */
+  static unsigned int position;
+  /**
+   * \brief This is the position of the state of the model at the start of the optimisation algorithm in the contents of the checkpoint file
+   */
+  static unsigned int startposition;
+  /**
+   * \brief This is the number of random numbers that have been used
+   */
+  static int numrandom;
+  /**
+   * \brief This is the last random number that has been used
+   */
+  static int lastrandom;
+};
+
+#endif
@@ -4,12 +4,14 @@
 #include <vector>
 #include "maininfo.h"
 #include "doublematrix.h"
+#include "populationmatrix.h"
 #include "doublevector.h"
 #include "intvector.h"
 #include "intmatrix.h"
+#include "optcheckpoint.h"
 #include "seq_optimize_template.h"
 
-enum OptType { OPTHOOKE = 1, OPTSIMANN, OPTBFGS, OPTPSO, OPTDE };
+enum OptType { OPTHOOKE = 1, OPTSIMANN, OPTBFGS, OPTPSO, OPTDE, OPTSURROGATE };
 
 /**
  * \class OptInfo
@@ -60,6 +62,14 @@ public:
    * \return type
    */
   OptType getType() const { return type; };
+  /**
+   * \brief This function will store or restore the results from the optimisation algorithm using the optimisation checkpoint
+   */
+  void transferResults() {
+    OptCheckpoint::Transfer(converge);
+    OptCheckpoint::Transfer(iters);
+    OptCheckpoint::Transfer(score);
+  };
 protected:
   /**
    * \brief This is the flag used to denote whether the optimisation converged or not
@@ -146,6 +156,7 @@ private:
   double bestNearby(DoubleVector& delta, DoubleVector& point, double prevbest, IntVector& param);
   /**
    * \brief This function implemented the reproducible version with OpenMP will calculate the best point that can be found close to the current point
+   * \note The function evaluations are taken from a shared queue by each thread, and the results are committed in the same order as the serial version, so this will work for any number of threads
    * \param delta is the DoubleVector of the steps to take when looking for the best point
    * \param point is the DoubleVector that will contain the parameters corresponding to the best function value found from the search
    * \param prevbest is the current best point value
@@ -153,6 +164,16 @@ private:
    * \return the best function value found from the search
    */
   double bestNearbyRepro(DoubleVector& delta, DoubleVector& point, double prevbest, IntVector& param);
+  /**
+   * \brief This function implemented the reproducible version with batches of function evaluations will calculate the best point that can be found close to the current point
+   * \note The +delta/-delta probes for the next coords are evaluated as a batch, and the results are committed in the same order as the serial version, so this will give the same point as bestNearbyRepro
+   * \param delta is the DoubleVector of the steps to take when looking for the best point
+   * \param point is the DoubleVector that will contain the parameters corresponding to the best function value found from the search
+   * \param prevbest is the current best point value
+   * \param param is the IntVector containing the order that the parameters should be searched in
+   * \return the best function value found from the search
+   */
+  double bestNearbyBatch(DoubleVector& delta, DoubleVector& point, double prevbest, IntVector& param);
   /**
      * \brief This function implemented the speculative version with OpenMP will calculate the best point that can be found close to the current point
      * \param delta is the DoubleVector of the steps to take when looking for the best point
@@ -162,6 +183,42 @@ private:
      * \return the best function value found from the search
      */
   double bestNearbySpec(DoubleVector& delta, DoubleVector& point, double prevbest, IntVector& param);
+  /**
+   * \brief This function will store the likelihood scores of the speculative probes around the point reached by a pattern move, so that bestNearbyRepro doesn't need to evaluate them again
+   * \param v is the DoubleMatrix containing the points that were evaluated with the pattern move
+   * \param f is the DoubleVector containing the likelihood scores of the points that were evaluated
+   * \param first is the row of v containing the first probe
+   * \param last is the row of v after the last probe
+   */
+  void storeProbes(const DoubleMatrix& v, const DoubleVector& f, int first, int last);
+  /**
+   * \brief This function will look for a point in the stored probes
+   * \param point is the DoubleVector containing the point to look for
+   * \param f will contain the likelihood score of the point, if it was found
+   * \return 1 if the point was found, 0 otherwise
+   */
+  int findProbe(const DoubleVector& point, double& f);
+  /**
+   * \brief This function will evaluate the pattern move as a line search, at 1, 2 and 4 times the step, together with any speculative probes around the point reached by the pattern move
+   * \param point is the DoubleVector containing the point reached by a pattern move of 1 times the step, which will contain the accepted point
+   * \param step is the DoubleVector containing the step of the pattern move
+   * \param lowerb is the DoubleVector containing the lower bounds of the parameters
+   * \param upperb is the DoubleVector containing the upper bounds of the parameters
+   * \param delta is the DoubleVector of the steps that will be taken when looking for the best point around the accepted point
+   * \param param is the IntVector containing the order that the parameters will be searched in
+   * \param numprobes is the number of speculative +delta/-delta probes to evaluate around the point reached by the pattern move
+   * \return the likelihood score at the accepted point
+   */
+  double patternLineSearch(DoubleVector& point, const DoubleVector& step, const DoubleVector& lowerb,
+    const DoubleVector& upperb, const DoubleVector& delta, const IntVector& param, int numprobes);
+  /**
+   * \brief This is the DoubleMatrix of the speculative probes that have been evaluated
+   */
+  DoubleMatrix probes;
+  /**
+   * \brief This is the DoubleVector of the likelihood scores for the speculative probes
+   */
+  DoubleVector probef;
   /**
    * \brief This is the maximum number of iterations for the Hooke & Jeeves optimisation
    */
@@ -182,6 +239,10 @@ private:
    * \brief This is the limit when checking if a parameter is stuck on the bound
    */
   double bndcheck;
+  /**
+   * \brief This is the flag to denote whether the pattern moves are evaluated as a line search (default 0, single pattern move)
+   */
+  int linesearch;
 };
 
 /**
@@ -241,6 +302,11 @@ public:
   virtual void newValue(int nvars, int l, IntVector& param, DoubleVector& trialx,
   		DoubleVector& x, DoubleVector& lowerb, DoubleVector& upperb, DoubleVector& vm);
 private:
+  /**
+   * \brief This is the function that will calculate the likelihood score using the parallel tempering version of the Simulated Annealing optimiser, with one chain at each temperature
+   * \note The trial points for all the chains are evaluated together, so the chains are run in parallel when Gadget is run in parallel
+   */
+  void OptimiseLikelihoodTempering();
   /**
    * \brief This is the temperature reduction factor
    */
@@ -289,6 +355,14 @@ private:
    * \brief This is the flag to denote whether the parameters should be scaled or not (default 0, not scale)
    */
   int scale;
+  /**
+   * \brief This is the number of chains used for the parallel tempering version of the algorithm (default 0, no parallel tempering)
+   */
+  int chains;
+  /**
+   * \brief This is the ratio between the temperatures of neighbouring chains for the parallel tempering version of the algorithm
+   */
+  double tempratio;
 };
 
 /**
@@ -326,13 +400,15 @@ public:
    */
   virtual void OptimiseLikelihood();
 #ifdef _OPENMP
-//#ifdef SPECULATIVE
   /**
-  * \brief This function call the sequential function. BFGS isn't implemented with OpenMP
-  */
+   * \brief This is the function that will calculate the likelihood score using the BFGS optimiser, with the gradient and linesearch calculations parallelized with OpenMP
+   * \note The points found are the same as for the sequential version
+   */
   virtual void OptimiseLikelihoodOMP();
+  /**
+   * \brief This function calls OptimiseLikelihoodOMP, since the parallel BFGS is already reproducible
+   */
   virtual void OptimiseLikelihoodREP();
-//#endif
 #endif
 private:
   /**
@@ -342,6 +418,28 @@ private:
    * \param newgrad is the DoubleVector that will contain the gradient vector for the current point
    */
   void gradient(DoubleVector& point, double pointvalue, DoubleVector& newgrad);
+#ifdef _OPENMP
+  /**
+   * \brief This function will numerically calculate the gradient of the function at the current point, sharing the function evaluations between the OpenMP threads
+   * \param point is the DoubleVector that contains the parameters corresponding to the current function value
+   * \param pointvalue is the current function value
+   * \param newgrad is the DoubleVector that will contain the gradient vector for the current point
+   */
+  void gradientOMP(DoubleVector& point, double pointvalue, DoubleVector& newgrad);
+  /**
+   * \brief This function will perform the Armijo linesearch, evaluating several step lengths at the same time with OpenMP
+   * \param x is the DoubleVector that contains the current point
+   * \param search is the DoubleVector that contains the search direction
+   * \param fx is the function value at the current point
+   * \param searchgrad is the Armijo halt criteria for a unit step length
+   * \param betan is the initial step length, which will contain the accepted step length
+   * \param trialx is the DoubleVector that will contain the accepted point
+   * \param tmpf will contain the function value at the accepted point
+   * \return 1 if a point meeting the Armijo criteria was found, 0 otherwise
+   */
+  int linesearchOMP(const DoubleVector& x, const DoubleVector& search, double fx,
+    double searchgrad, double& betan, DoubleVector& trialx, double& tmpf);
+#endif
   /**
    * \brief This function will calculate the smallest eigenvalue of the inverse Hessian matrix
    * \param M is the DoubleMatrix containing the inverse Hessian matrix
@@ -380,6 +478,14 @@ private:
    * \brief This is the halt criteria for the gradient accuracy term
    */
   double gradeps;
+  /**
+   * \brief This is the flag used to denote whether the gradient and linesearch calculations are parallelized with OpenMP
+   */
+  int parallel;
+  /**
+   * \brief This is the number of function evaluations done by the OpenMP threads
+   */
+  int numevals;
 };
 
 
@@ -413,11 +519,18 @@ private:
  int growth_trend_popul;
  int num_restart;
  int size;
+ int steadystate; // whether the parallel search updates the population after each evaluation (default 0, after each generation)
 
  void   growth_trend_manager();
  double F_manager(int step);
  double calc_adapt_parameters(int step);
  void   position_within_bounds(DoubleMatrix& pos, DoubleMatrix& vel, DoubleVector& lowerb, DoubleVector& upperb, int i, int d);
+ void   transferState(); // store or restore the state of the search in the checkpoint file
+#ifdef _OPENMP
+ void   steadyState(PopulationMatrix& pos, PopulationMatrix& vel, PopulationMatrix& pos_new, PopulationMatrix& pos_b,
+          DoubleVector& fit, DoubleVector& fit_b, DoubleVector& bestx, double& bestf, int& bestindex,
+          DoubleVector& lowerb, DoubleVector& upperb, DoubleVector& init, int& steps, int& offset); // parallel search that updates the population after each evaluation
+#endif
 };
  
 /**
@@ -557,13 +670,134 @@ private:
   * \brief This is the flag to denote whether the parameters should be scaled or not (default 0, not scale)
   */
  int scale;
+ /**
+  * \brief This is the flag to denote whether the parallel search updates the swarm after each evaluation or not (default 0, after each iteration)
+  */
+ int steadystate;
  double calc_inertia_adapt_dyn(int);
  void inform_global(IntMatrix& , DoubleMatrix& , DoubleMatrix& , DoubleVector& , DoubleVector& , int );
  void growth_trend_manager();
  double w_manager(int step);
  void position_within_bounds(DoubleMatrix&, DoubleMatrix&, DoubleVector&, DoubleVector&, int , int );
+ void transferState(); // store or restore the state of the search in the checkpoint file
  typedef void (OptInfoPso::*Inform_fun)(IntMatrix&, DoubleMatrix&, DoubleMatrix&, DoubleVector&, DoubleVector&,  int); // neighborhood update function
  typedef double (OptInfoPso::*Calc_inertia_fun)(int); // inertia weight update function
+#ifdef _OPENMP
+ void steadyState(PopulationMatrix& pos, PopulationMatrix& vel, PopulationMatrix& pos_b, DoubleVector& fit, DoubleVector& fit_b,
+        DoubleVector& bestx, double& bestf, int& bestindex, DoubleVector& lowerb, DoubleVector& upperb,
+        DoubleVector& init, int& psosteps, int& offset, Calc_inertia_fun calc_inertia_fun); // parallel search that updates the swarm after each evaluation
+#endif
 
 };
+
+/**
+ * \class OptInfoSurrogate
+ * \brief This is the class used for the Surrogate optimisation
+ *
+ * The Surrogate optimisation is a trust region method that uses a cheap approximation to the likelihood function to decide which points should be evaluated by running the model.  All the points that have been evaluated are kept in an archive, and the approximation is fitted to the archived points that are closest to the current best point.  The approximation is either a quadratic function without the cross terms, or a cubic radial basis function with a linear term.  A large number of candidate points are generated inside the trust region around the best point, and the candidate points that have the lowest predicted likelihood scores, while being far from the points that have already been evaluated, are selected and evaluated as one batch.  If the batch contains a point that is a significant improvement on the best point, the trust region is moved to this point, and the trust region is expanded after several successes in a row.  The trust region is reduced after several failures in a row, and when the size of the trust region is less than the halt criteria then the algorithm accepts the best point as the "solution", and exits.
+ *
+ * Since fitting the approximation takes much less time than a model run, this algorithm will usually need fewer model runs than the Hooke & Jeeves algorithm to find a point close to the optimum.  The points in each batch are shared out between the copies of the model when Gadget is run in parallel.
+ *
+ * The Surrogate algorithm used in Gadget is derived from that presented by Regis and Shoemaker, ''Combining radial basis function surrogates and dynamic coordinate search in high-dimensional expensive black-box optimization'' in the 2013 (Vol. 45, pp. 529-555) issue of Engineering Optimization.
+ */
+class OptInfoSurrogate : public OptInfo {
+public:
+  /**
+   * \brief This is the default OptInfoSurrogate constructor
+   */
+  OptInfoSurrogate();
+  /**
+   * \brief This is the default OptInfoSurrogate destructor
+   */
+  virtual ~OptInfoSurrogate() {};
+  /**
+   * \brief This is the function used to read in the Surrogate parameters
+   * \param infile is the CommentStream to read the optimisation parameters from
+   * \param text is a text string used to compare parameter names
+   */
+  virtual void read(CommentStream& infile, char* text);
+  /**
+   * \brief This function will print information from the optimisation algorithm
+   * \param outfile is the ofstream that the optimisation information gets sent to
+   * \param prec is the precision to use in the output file
+   */
+  virtual void Print(ofstream& outfile, int prec);
+  /**
+   * \brief This is the function that will calculate the likelihood score using the Surrogate optimiser
+   */
+  virtual void OptimiseLikelihood();
+#ifdef _OPENMP
+  /**
+   * \brief This is the function that will calculate the likelihood score using the Surrogate optimiser, with each batch containing at least one point for each thread
+   * \note The points found depend on the number of threads that are used
+   */
+  virtual void OptimiseLikelihoodOMP();
+  /**
+   * \brief This is the function that will calculate the likelihood score using the Surrogate optimiser, with each batch shared out between the threads
+   * \note The points found are the same as for the sequential version
+   */
+  virtual void OptimiseLikelihoodREP();
+#endif
+private:
+  /**
+   * \brief This function will fit the approximation to the likelihood function
+   * \param u is the DoubleMatrix containing the normalised values of the points used to fit the approximation
+   * \param f is the DoubleVector containing the likelihood scores of the points used to fit the approximation
+   * \param coef is the DoubleVector that will contain the coefficients of the approximation
+   * \return 1 if the approximation could be fitted, 0 otherwise
+   */
+  int fitModel(const DoubleMatrix& u, const DoubleVector& f, DoubleVector& coef);
+  /**
+   * \brief This function will calculate the value of the approximation to the likelihood function at a point
+   * \param u is the DoubleMatrix containing the normalised values of the points used to fit the approximation
+   * \param coef is the DoubleVector containing the coefficients of the approximation
+   * \param point is the DoubleVector containing the normalised values of the point
+   * \return the predicted likelihood score
+   */
+  double predictModel(const DoubleMatrix& u, const DoubleVector& coef, const DoubleVector& point);
+  /**
+   * \brief This function will solve the matrix equation Ax = b using Gaussian elimination with partial pivoting
+   * \param A is the DoubleMatrix on the left hand side of the equation, which will be overwritten
+   * \param b is the DoubleVector on the right hand side of the equation, which will contain the solution
+   * \return 1 if the equation could be solved, 0 if the matrix is singular
+   */
+  int solveSystem(DoubleMatrix& A, DoubleVector& b);
+  /**
+   * \brief This is the maximum number of function evaluations for the Surrogate optimisation
+   */
+  int surrogateiter;
+  /**
+   * \brief This is the minimum size of the trust region, used as the halt criteria for the optimisation process
+   */
+  double surrogateeps;
+  /**
+   * \brief This is the initial size of the trust region, as a proportion of the distance between the bounds
+   */
+  double radius;
+  /**
+   * \brief This is the reduction factor for the size of the trust region
+   */
+  double rho;
+  /**
+   * \brief This is the number of points that are evaluated in each batch
+   */
+  int batchsize;
+  /**
+   * \brief This is the maximum number of archived points used to fit the approximation
+   */
+  int maxpoints;
+  /**
+   * \brief This is the flag to denote whether the approximation is a quadratic function (1, default) or a radial basis function (0)
+   */
+  int quadratic;
+  /**
+   * \brief This is the number of successful batches in a row before the trust region is expanded
+   */
+  int succtol;
+  /**
+   * \brief This is the number of failed batches in a row before the trust region is reduced (0 to calculate this from the number of parameters)
+   */
+  int failtol;
+};
+
 #endif
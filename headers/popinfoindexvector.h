@@ -13,7 +13,7 @@ public:
   /**
    * \brief This is the default PopInfoIndexVector constructor
    */
-  PopInfoIndexVector() { minpos = 0; size = 0; v = 0; };
+  PopInfoIndexVector() { minpos = 0; size = 0; v = 0; ownsdata = 1; };
   /**
    * \brief This is the PopInfoIndexVector constructor for a specified size
    * \param sz is the size of the vector to be created
@@ -45,6 +45,14 @@ public:
    * \param value is the value that will be entered for the new entries
    */
   void resize(int addsize, int newminpos, PopInfo value);
+  /**
+   * \brief This will set the vector to use storage that has been allocated elsewhere
+   * \param sz is the size of the vector
+   * \param newminpos is the index for the vector
+   * \param storage is the PopInfo array that will store the entries of the vector
+   * \note The storage will not be freed by the vector, and any existing entries of the vector are lost
+   */
+  void setStorage(int sz, int newminpos, PopInfo* storage);
   /**
    * \brief This will return the value of an element of the vector
    * \param pos is the element of the vector to be returned
@@ -100,6 +108,10 @@ protected:
    * \brief This is the indexed vector of PopInfo values
    */
   PopInfo* v;
+  /**
+   * \brief This is the flag used to denote whether the storage for the vector is freed when the vector is deleted
+   */
+  int ownsdata;
 };
 
 #endif
@@ -0,0 +1,92 @@
+#ifndef populationmatrix_h
+#define populationmatrix_h
+
+#include "doublematrix.h"
+
+/**
+ * \class PopulationMatrix
+ * \brief This class implements a DoubleMatrix where all the rows are stored in one contiguous block of memory
+ *
+ * This is used to store the populations of points used by the DE and PSO optimisation algorithms.  Each row starts on a cache line boundary, and the block of memory is allocated with spare capacity, so rows can be added when the population grows without allocating memory for each new row.
+ * \note The rows of the matrix can be used as DoubleVector objects, but they must not be resized
+ */
+class PopulationMatrix : public DoubleMatrix {
+public:
+  /**
+   * \brief This is the default PopulationMatrix constructor
+   */
+  PopulationMatrix();
+  /**
+   * \brief This is the PopulationMatrix constructor for a specified size
+   * \param nr is the number of rows to be created
+   * \param nc is the length of each row to be created
+   * \param initial is the initial value for all the entries of the matrix
+   */
+  PopulationMatrix(int nr, int nc, double initial);
+  /**
+   * \brief This is the PopulationMatrix constructor that creates a copy of an existing PopulationMatrix
+   * \param initial is the PopulationMatrix to copy
+   */
+  PopulationMatrix(const PopulationMatrix& initial);
+  /**
+   * \brief This is the PopulationMatrix destructor
+   * \note This will free all the memory allocated to the matrix
+   */
+  ~PopulationMatrix();
+  /**
+   * \brief This will add new rows to the matrix
+   * \param add is the number of new rows to the matrix
+   * \param length is the length of the new rows, which must be the same as the existing rows
+   * \param value is the value that will be entered for the new entries
+   * \note The capacity of the matrix is doubled when it is full, so the existing rows are only moved occasionally
+   */
+  void AddRows(int add, int length, double value);
+  /**
+   * \brief This will reset the matrix
+   * \note This will delete every row from the matrix and free the memory allocated to the matrix
+   */
+  void Reset();
+  /**
+   * \brief This will return the number of rows that the matrix can hold without allocating more memory
+   * \return the capacity of the matrix
+   */
+  int Capacity() const { return capacity; };
+  /**
+   * \brief This operator will set the matrix equal to an existing PopulationMatrix
+   * \param d is the PopulationMatrix to copy
+   */
+  PopulationMatrix& operator = (const PopulationMatrix& d);
+private:
+  /**
+   * \brief This will delete a row from the matrix, which is not used for a PopulationMatrix
+   * \param pos is the row of the matrix to be deleted
+   */
+  void Delete(int pos);
+  /**
+   * \brief This will move the rows of the matrix to a new block of memory
+   * \param newcapacity is the number of rows that the new block of memory can hold
+   */
+  void setCapacity(int newcapacity);
+  /**
+   * \brief This is the length of each row of the matrix
+   */
+  int ncol;
+  /**
+   * \brief This is the distance between the start of each row, padded to a whole number of cache lines
+   */
+  int stride;
+  /**
+   * \brief This is the number of rows that the matrix can hold
+   */
+  int capacity;
+  /**
+   * \brief This is the memory that has been allocated for the matrix
+   */
+  double* memory;
+  /**
+   * \brief This is the start of the first row, aligned to a cache line boundary
+   */
+  double* block;
+};
+
+#endif
@@ -44,6 +44,19 @@ public:
    * \note This function is not used for this likelihood component
    */
   virtual void addLikelihood(const TimeClass* const TimeInfo);
+  /**
+   * \brief This function will check whether the ProgLikelihood component needs to be calculated on a given timestep
+   * \param year is the year of the timestep to check
+   * \param step is the step of the timestep to check
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if the step is the assessment step, 0 otherwise
+   */
+  virtual int isActive(int year, int step, const TimeClass* const TimeInfo) const { return (step == assessmentstep); };
+  /**
+   * \brief This function will check whether the ProgLikelihood component only reads the model
+   * \return 0, since the total allowable catch is set for the fleets
+   */
+  virtual int isReadOnly() const { return 0; };
   void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks);
   void Reset(const Keeper* const keeper);
   void Reset(const TimeClass* const TimeInfo);
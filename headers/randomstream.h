@@ -0,0 +1,67 @@
+#ifndef randomstream_h
+#define randomstream_h
+
+/**
+ * \class RandomStream
+ * \brief This is the class used to generate a stream of random numbers, where each random number is calculated from a key, the number of the stream and the position in the stream
+ *
+ * Since each random number does not depend on the previous random number, the random numbers for each member of the population used by the DE and PSO optimisation algorithms can be generated within the parallel loops, instead of being generated in advance and stored.  The random numbers for each member of the population are the same whatever the number of threads that are used.
+ * \note The key should be taken from the random number generator used by the optimisation algorithm at the start of each iteration, so that the random numbers are different for each iteration
+ */
+class RandomStream {
+public:
+  /**
+   * \brief This is the RandomStream constructor
+   * \param k is the key for the random numbers
+   * \param s is the number of the stream
+   */
+  RandomStream(unsigned k, unsigned s) { key = k; stream = s; counter = 0; };
+  /**
+   * \brief This is the default RandomStream destructor
+   */
+  ~RandomStream() {};
+  /**
+   * \brief This function will return the next random number from the stream
+   * \return random number in the range [0, 1)
+   */
+  double Uniform() { return (double)(this->nextValue()) / 4294967296.0; };
+  /**
+   * \brief This function will return the next random integer from the stream
+   * \param n is the number of possible values
+   * \return random integer in the range [0, n)
+   */
+  int Integer(int n) { return (int)(this->Uniform() * n); };
+private:
+  /**
+   * \brief This function will mix the bits of a 32 bit integer
+   * \param x is the integer to be mixed
+   * \return mixed integer
+   */
+  static unsigned mixBits(unsigned x) {
+    x = (x ^ (x >> 16)) * 0x7feb352dU;
+    x = (x ^ (x >> 15)) * 0x846ca68bU;
+    return (x ^ (x >> 16)) & 0xffffffffU;
+  };
+  /**
+   * \brief This function will calculate the next 32 bit random integer from the stream
+   * \return random integer
+   */
+  unsigned nextValue() {
+    counter++;
+    return mixBits(mixBits(mixBits(counter * 0x9e3779b9U) ^ stream) + key);
+  };
+  /**
+   * \brief This is the key for the random numbers
+   */
+  unsigned key;
+  /**
+   * \brief This is the number of the stream
+   */
+  unsigned stream;
+  /**
+   * \brief This is the position in the stream
+   */
+  unsigned counter;
+};
+
+#endif
@@ -260,6 +260,24 @@ public:
 	void setNrej(int nrej) {_nrej = nrej;};
 
 	double* getScore() const {return _score;}
+
+	//store or restore the state of the search that changes between iterations
+	void transferState() {
+		OptCheckpoint::Transfer(_seed);
+		OptCheckpoint::Transfer(_seedM);
+		OptCheckpoint::Transfer(_seedP);
+		OptCheckpoint::Transfer(_l);
+		OptCheckpoint::Transfer(_NT);
+		OptCheckpoint::Transfer(_NS);
+		OptCheckpoint::Transfer(_param);
+		OptCheckpoint::Transfer(_vm);
+		OptCheckpoint::Transfer(_t);
+		OptCheckpoint::Transfer(_nacp);
+		OptCheckpoint::Transfer(_nacc);
+		OptCheckpoint::Transfer(_nrej);
+		OptCheckpoint::Transfer(_naccmet);
+		OptCheckpoint::Transfer(_fstar);
+	}
 };
 
 /* IMPROVEMENTS:
@@ -272,7 +290,8 @@ public:
 
 /// Performs a reproducible optimization process, sequentially in seq_opt or in parallel in paral_opt
 template<class SEED_T, class PARAMS_T, class CONTROL_T, double Evaluator(
-		const PARAMS_T&), void BuildNewParams(SEED_T&, PARAMS_T&)>
+		const PARAMS_T&), void BatchEvaluator(const PARAMS_T* const*, double*, int),
+		void BuildNewParams(SEED_T&, PARAMS_T&)>
 class ReproducibleSearch {
 
 	const SEED_T initialSeed_;
@@ -347,6 +366,7 @@ public:
 		bool quit = false;
 
 		for (iters_ = 1; iters_ <= maxIters_; ++iters_) {
+			control_object.checkpoint(seed_, p_, funcval_, optimumValue_, iters_);
 			PARAMS_T p = p_;
 
 			BuildNewParams(seed_, p);
@@ -405,9 +425,12 @@ public:
 
 		ParalEvalItemStorage_t * const storage =
 				new ParalEvalItemStorage_t[paral_tokens]; //Guarda los datos de los diferentes threads
+		const PARAMS_T** const params = new const PARAMS_T*[paral_tokens];
+		double* const values = new double[paral_tokens];
 
 		int old_paral_tokens = paral_tokens;
 		for (iters_ = 1; iters_ <= maxIters_;) {
+			control_object.checkpoint(seed_, p_, funcval_, optimumValue_, iters_);
 
 			if ((seed_.getL() + paral_tokens -1) >= seed_.getNvars())
 				paral_tokens = seed_.getNvars() - seed_.getL();
@@ -424,10 +447,12 @@ public:
 			}
 			const double prev_val = funcval_;
 
-#pragma omp parallel for
-			for (int i = 0; i < paral_tokens; i++) {
-				storage[i].pei_.evaluateItem();
-			}
+			//the items are evaluated as a batch, shared out between the copies of the model
+			for (int i = 0; i < paral_tokens; i++)
+				params[i] = &storage[i].pei_.p_;
+			BatchEvaluator(params, values, paral_tokens);
+			for (int i = 0; i < paral_tokens; i++)
+				storage[i].pei_.value_ = values[i];
 
 			int j, i=0; //Notice that we need it after the loop
 			if (control_object.mustAccept(prev_val, storage[i].pei_.value_, storage[i].pei_.seed_, iters_+i)) {
@@ -468,6 +493,8 @@ public:
 		searchTime_ = t.tv_sec + t.tv_usec / 1000000.0;
 
 		delete[] storage;
+		delete[] params;
+		delete[] values;
 	}
 
 	/// Only used by sequential search when verbose
@@ -37,8 +37,10 @@ public:
    * \brief This will select the fleets and stocks required to calculate the survey index likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
    * \param Stocks is the StockPtrVector of all the available stocks
+   * \param planner is the AggregationPlanner used to share the aggregators between the likelihood components
    */
-  virtual void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks);
+  virtual void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+    AggregationPlanner* const planner);
   /**
    * \brief This function will print the SIByEffortOnStep information
    * \param outfile is the ofstream that all the model information gets sent to
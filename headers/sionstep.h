@@ -10,6 +10,7 @@
 #include "actionattimes.h"
 #include "agebandmatrix.h"
 #include "stockaggregator.h"
+#include "aggregationplanner.h"
 #include "regressionline.h"
 #include "hasname.h"
 #include "gadget.h"
@@ -56,12 +57,20 @@ public:
    * \brief This will select the fleets and stocks required to calculate the regression line
    * \param Fleets is the FleetPtrVector of all the available fleets
    * \param Stocks is the StockPtrVector of all the available stocks
+   * \param planner is the AggregationPlanner used to share the aggregators between the likelihood components
    */
-  virtual void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) = 0;
+  virtual void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+    AggregationPlanner* const planner) = 0;
   /**
    * \brief This function will reset the SIOnStep information
    */
   virtual void Reset();
+  /**
+   * \brief This function will reset the SIOnStep information from the current timestep onwards
+   * \param TimeInfo is the TimeClass for the current model
+   * \note This is used when the simulation is restarted part way through
+   */
+  void Reset(const TimeClass* const TimeInfo);
   /**
    * \brief This function will print the SIOnStep information
    * \param outfile is the ofstream that all the model information gets sent to
@@ -84,6 +93,14 @@ public:
    * \return SSE from the regession line
    */
   virtual double calcSSE();
+  /**
+   * \brief This function will check whether the survey index is calculated on a given timestep
+   * \param year is the year of the timestep to check
+   * \param step is the step of the timestep to check
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if there is survey index data for the timestep, 0 otherwise
+   */
+  int isActive(int year, int step, const TimeClass* const TimeInfo) const { return AAT.atTime(year, step, TimeInfo); };
   /**
    * \brief This will return the fit type for the regression line
    * \return fittype
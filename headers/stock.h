@@ -9,6 +9,7 @@
 #include "stockptrvector.h"
 #include "tagptrvector.h"
 #include "commentstream.h"
+#include "doublematrix.h"
 
 class Stock;
 class Keeper;
@@ -142,6 +143,16 @@ public:
    * \param TimeInfo is the TimeClass for the current model
    */
   virtual void Reset(const TimeClass* const TimeInfo);
+  /**
+   * \brief This function will store the model population at a checkpoint of the simulation
+   * \param id is the identifier of the checkpoint
+   */
+  void storeState(int id);
+  /**
+   * \brief This function will restore the model population that was stored at a checkpoint of the simulation
+   * \param id is the identifier of the checkpoint
+   */
+  void restoreState(int id);
   /**
    * \brief This function will print the model population
    * \param outfile is the ofstream that all the model information gets sent to
@@ -464,6 +475,11 @@ protected:
    * \brief This is the PopInfoVector used to temporarily store the population during the migration calculation
    */
   PopInfoVector tmpMigrate;
+  /**
+   * \brief This is the DoubleMatrix used to store the population at each checkpoint of the simulation
+   * \note Each row contains the number and mean weight for each area, age and length group in turn
+   */
+  DoubleMatrix storedAlkeys;
 };
 
 #endif
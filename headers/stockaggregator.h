@@ -7,6 +7,10 @@
 #include "conversionindexptrvector.h"
 #include "intmatrix.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /**
  * \class StockAggregator
  * \brief This is the class used to aggregate stock information
@@ -34,6 +38,14 @@ public:
    * \brief This function will aggregate the stock data
    */
   void Sum();
+  /**
+   * \brief This function will mark the aggregator as shared between likelihood components, so that the data is only aggregated once on each timestep
+   */
+  void setShared();
+  /**
+   * \brief This function will mark the aggregator as not summed for the current timestep
+   */
+  void clearSum() { summed = 0; };
   /**
    * \brief This will return the AgeBandMatrixPtrVector containing the aggregated stock information
    * \return total, the AgeBandMatrixPtrVector of aggregated stock information
@@ -69,6 +81,24 @@ protected:
    * \brief This is the AgeBandMatrix used to temporarily store information when aggregating the stocks
    */
   const AgeBandMatrix* alptr;
+  /**
+   * \brief This is the flag used to denote whether the aggregator is shared between likelihood components
+   */
+  int shared;
+  /**
+   * \brief This is the flag used to denote whether the shared aggregator has been summed on the current timestep
+   */
+  int summed;
+#ifdef _OPENMP
+  /**
+   * \brief This is the lock used to make sure that a shared aggregator is only summed by one likelihood component at a time
+   */
+  omp_lock_t sumlock;
+#endif
+  /**
+   * \brief This function will add up the stock data
+   */
+  void calcSum();
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include "commentstream.h"
 #include "charptrvector.h"
 #include "fleetpreyaggregator.h"
+#include "aggregationplanner.h"
 #include "doublematrixptrmatrix.h"
 #include "multinomial.h"
 #include "actionattimes.h"
@@ -36,11 +37,24 @@ public:
    * \param TimeInfo is the TimeClass for the current model
    */
   virtual void addLikelihood(const TimeClass* const TimeInfo);
+  /**
+   * \brief This function will check whether the StockDistribution component needs to be calculated on a given timestep
+   * \param year is the year of the timestep to check
+   * \param step is the step of the timestep to check
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if there is data for the timestep, 0 otherwise
+   */
+  virtual int isActive(int year, int step, const TimeClass* const TimeInfo) const;
   /**
    * \brief This function will reset the StockDistribution likelihood information
    * \param keeper is the Keeper for the current model
    */
   virtual void Reset(const Keeper* const keeper);
+  /**
+   * \brief This function will check whether the StockDistribution likelihood can be restarted part way through the simulation
+   * \return 1, since the modelled data is stored for each timestep
+   */
+  virtual int canRestart() const { return 1; };
   /**
    * \brief This function will print the summary StockDistribution likelihood information
    * \param outfile is the ofstream that all the model information gets sent to
@@ -61,8 +75,10 @@ public:
    * \brief This will select the fleets and stocks required to calculate the StockDistribution likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
    * \param Stocks is the StockPtrVector of all the available stocks
+   * \param planner is the AggregationPlanner used to share the aggregators between the likelihood components
    */
-  void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks);
+  void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+    AggregationPlanner* const planner);
 private:
   /**
    * \brief This function will read the StockDistribution data from the input file
@@ -74,6 +90,12 @@ private:
    */
   void readStockData(CommentStream& infile, const TimeClass* TimeInfo,
     int numarea, int numage, int numlen);
+  /**
+   * \brief This function will calculate the terms of the likelihood score that only depend on the observed data
+   * \param TimeInfo is the TimeClass for the current model
+   * \note The observed data doesnt change during the optimisation, so these terms only need to be calculated once
+   */
+  void prepareObservations(const TimeClass* const TimeInfo);
   /**
    * \brief This function will calculate the likelihood score for the current timestep based on a multinomial function
    * \return likelihood score
@@ -95,6 +117,16 @@ private:
    * \note The indices for this object are [time][area][stock][id] where id = age+(numage*length)
    */
   DoubleMatrixPtrMatrix modelDistribution;
+  /**
+   * \brief This is the DoubleMatrixPtrMatrix used to store the terms of the likelihood calculation that only depend on the observed data
+   * \note The indices for this object are [time][area], and the matrix stored is the data constants for each multinomial calculation or the observed proportions for the sum of squares function
+   */
+  DoubleMatrixPtrMatrix obsPrepared;
+  /**
+   * \brief This is the IntVector used to find the index of the likelihood data for each timestep
+   * \note This is -1 for the timesteps that have no likelihood data
+   */
+  IntVector timeMap;
   /**
    * \brief This is the DoubleMatrix used to store the calculated likelihood information
    * \note The indices for this object are [time][area]
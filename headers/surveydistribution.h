@@ -3,6 +3,7 @@
 
 #include "likelihood.h"
 #include "stockaggregator.h"
+#include "aggregationplanner.h"
 #include "doublematrixptrmatrix.h"
 #include "actionattimes.h"
 #include "formulavector.h"
@@ -40,11 +41,24 @@ public:
    * \param TimeInfo is the TimeClass for the current model
    */
   virtual void addLikelihood(const TimeClass* const TimeInfo);
+  /**
+   * \brief This function will check whether the SurveyDistribution component needs to be calculated on a given timestep
+   * \param year is the year of the timestep to check
+   * \param step is the step of the timestep to check
+   * \param TimeInfo is the TimeClass for the current model
+   * \return 1 if there is data for the timestep, 0 otherwise
+   */
+  virtual int isActive(int year, int step, const TimeClass* const TimeInfo) const;
   /**
    * \brief This function will reset the SurveyDistribution likelihood information
    * \param keeper is the Keeper for the current model
    */
   virtual void Reset(const Keeper* const keeper);
+  /**
+   * \brief This function will check whether the SurveyDistribution likelihood can be restarted part way through the simulation
+   * \return 1, since the modelled data is stored for each timestep
+   */
+  virtual int canRestart() const { return 1; };
   /**
    * \brief This function will print the summary SurveyDistribution likelihood information
    * \param outfile is the ofstream that all the model information gets sent to
@@ -54,8 +68,10 @@ public:
    * \brief This will select the fleets and stocks required to calculate the SurveyDistribution likelihood score
    * \param Fleets is the FleetPtrVector of all the available fleets
    * \param Stocks is the StockPtrVector of all the available stocks
+   * \param planner is the AggregationPlanner used to share the aggregators between the likelihood components
    */
-  void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks);
+  void setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+    AggregationPlanner* const planner);
   /**
    * \brief This function will print information from each SurveyDistribution calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
@@ -167,6 +183,11 @@ private:
    * \brief This is the IntVector used to store information about the steps when the likelihood score should be calculated
    */
   IntVector Steps;
+  /**
+   * \brief This is the IntVector used to find the index of the likelihood data for each timestep
+   * \note This is -1 for the timesteps that have no likelihood data
+   */
+  IntVector timeMap;
   /**
    * \brief This is the DoubleMatrixPtrMatrix used to store survey distribution information specified in the input file
    * \note The indices for this object are [time][area][age][length]
@@ -14,7 +14,7 @@ public:
   /**
    * \brief This is the default TimeVariable constructor
    */
-  TimeVariable() { value = 0.0; lastvalue = -1.0; };
+  TimeVariable() { value = 0.0; lastvalue = -1.0; timeid = 0; time = 0; };
   /**
    * \brief This is the default TimeVariable destructor
    */
@@ -41,6 +41,22 @@ public:
    * \param keeper is the Keeper for the current model
    */
   virtual void Reset(const Keeper* const keeper);
+  /**
+   * \brief This function will check whether the UnderStocking likelihood can be restarted part way through the simulation
+   * \return 1
+   */
+  virtual int canRestart() const { return 1; };
+  /**
+   * \brief This function will restore the UnderStocking likelihood information that was stored at a checkpoint
+   * \param id is the identifier of the checkpoint
+   * \param TimeInfo is the TimeClass for the current model
+   */
+  virtual void restoreState(int id, const TimeClass* const TimeInfo);
+  /**
+   * \brief This function will store the UnderStocking likelihood information at a checkpoint
+   * \param id is the identifier of the checkpoint
+   */
+  virtual void storeState(int id);
   /**
    * \brief This function will print summary information from each non-zero UnderStocking likelihood calculation
    * \param outfile is the ofstream that all the model likelihood information gets sent to
@@ -91,6 +107,10 @@ private:
    * \brief This is the DoubleVector used to store the calculated non-zero likelihood score
    */
   DoubleVector likelihoodValues;
+  /**
+   * \brief This is the IntVector used to store the number of non-zero likelihood scores at each checkpoint of the simulation
+   */
+  IntVector storedsize;
   /**
    * \brief This is the CharPtrVector used to store the names of the predators that will be checked for understocking
    */
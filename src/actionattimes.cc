@@ -133,3 +133,19 @@ int ActionAtTimes::atCurrentTime(const TimeClass* const TimeInfo) const {
       return 1;
   return 0;
 }
+
+int ActionAtTimes::atTime(int year, int step, const TimeClass* const TimeInfo) const {
+  if (everyStep)
+    return 1;
+  int i;
+  for (i = 0; i < Steps.Size(); i++)
+    if (Steps[i] == step)
+      return 1;
+  for (i = 0; i < Years.Size(); i++)
+    if (Years[i] == year)
+      return 1;
+  for (i = 0; i < TimeSteps.Size(); i++)
+    if (TimeSteps[i] == TimeInfo->calcSteps(year, step))
+      return 1;
+  return 0;
+}
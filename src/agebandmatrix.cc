@@ -7,34 +7,39 @@
 AgeBandMatrix::AgeBandMatrix(const AgeBandMatrix& initial)
   : minage(initial.minAge()), nrow(initial.Nrow()) {
 
-  int i;
+  v = 0;
+  data = 0;
   if (nrow > 0) {
-    v = new PopInfoIndexVector*[nrow];
+    int i, j;
+    IntVector minl(nrow, 0), size(nrow, 0);
+    for (i = 0; i < nrow; i++) {
+      minl[i] = initial.minLength(i + minage);
+      size[i] = initial[i + minage].Size();
+    }
+    this->allocateStorage(minl, size);
     for (i = 0; i < nrow; i++)
-      v[i] = new PopInfoIndexVector(initial[i + minage]);
-  } else
-    v = 0;
+      for (j = minl[i]; j < minl[i] + size[i]; j++)
+        v[i][j] = initial[i + minage][j];
+  }
 }
 
 AgeBandMatrix::AgeBandMatrix(int age, const IntVector& minl,
   const IntVector& size) : minage(age), nrow(size.Size()) {
 
-  int i;
-  if (nrow > 0) {
-    PopInfo nullpop;
-    v = new PopInfoIndexVector*[nrow];
-    for (i = 0; i < nrow; i++)
-      v[i] = new PopInfoIndexVector(size[i], minl[i], nullpop);
-  } else
-    v = 0;
+  v = 0;
+  data = 0;
+  if (nrow > 0)
+    this->allocateStorage(minl, size);
 }
 
 AgeBandMatrix::AgeBandMatrix(int age, const PopInfoMatrix& initial, int minl)
   : minage(age), nrow(initial.Nrow()) {
 
+  v = 0;
+  data = 0;
   if (nrow > 0) {
     int i, j, lower, upper;
-    v = new PopInfoIndexVector*[nrow];
+    IntVector lowerl(nrow, 0), size(nrow, 0);
     for (i = 0; i < nrow; i++) {
       lower = 0;
       upper = initial.Ncol(i) - 1;
@@ -42,27 +47,57 @@ AgeBandMatrix::AgeBandMatrix(int age, const PopInfoMatrix& initial, int minl)
         lower++;
       while (isZero(initial[i][upper].N) && (upper > lower))
         upper--;
-      v[i] = new PopInfoIndexVector(upper - lower + 1, lower + minl);
-      for (j = lower; j <= upper; j++)
-        (*v[i])[j + minl] = initial[i][j];
+      lowerl[i] = lower + minl;
+      size[i] = upper - lower + 1;
     }
-  } else
-    v = 0;
+
+    this->allocateStorage(lowerl, size);
+    for (i = 0; i < nrow; i++)
+      for (j = lowerl[i]; j < lowerl[i] + size[i]; j++)
+        v[i][j] = initial[i][j - minl];
+  }
 }
 
 AgeBandMatrix::AgeBandMatrix(int age, const PopInfoIndexVector& initial)
   : minage(age), nrow(1) {
 
-  v = new PopInfoIndexVector*[nrow];
-  v[0] = new PopInfoIndexVector(initial);
+  int j;
+  v = 0;
+  data = 0;
+  IntVector minl(1, initial.minCol()), size(1, initial.Size());
+  this->allocateStorage(minl, size);
+  for (j = initial.minCol(); j < initial.maxCol(); j++)
+    v[0][j] = initial[j];
 }
 
 AgeBandMatrix::~AgeBandMatrix() {
-  int i;
   if (v != 0) {
-    for (i = 0; i < nrow; i++)
-      delete v[i];
     delete[] v;
     v = 0;
   }
+  if (data != 0) {
+    delete[] data;
+    data = 0;
+  }
+}
+
+void AgeBandMatrix::allocateStorage(const IntVector& minl, const IntVector& size) {
+  int i, total = 0;
+  for (i = 0; i < nrow; i++)
+    if (size[i] > 0)
+      total += size[i];
+
+  //JMB all the age groups share one block of memory, so the population
+  //is stored contiguously in memory when looping over ages and lengths
+  if (total > 0)
+    data = new PopInfo[total];
+  v = new PopInfoIndexVector[nrow];
+  total = 0;
+  for (i = 0; i < nrow; i++) {
+    if (size[i] > 0) {
+      v[i].setStorage(size[i], minl[i], data + total);
+      total += size[i];
+    } else
+      v[i].setStorage(0, minl[i], 0);
+  }
 }
@@ -26,7 +26,7 @@ void AgeBandMatrix::Add(const AgeBandMatrix& Addition, const ConversionIndex &CI
       for (l = minl; l < maxl; l++) {
         pop = Addition[age][l - offset];
         pop *= ratio;
-        (*v[age - minage])[l] += pop;
+        v[age - minage][l] += pop;
       }
     }
 
@@ -39,7 +39,7 @@ void AgeBandMatrix::Add(const AgeBandMatrix& Addition, const ConversionIndex &CI
           pop = Addition[age][CI.getPos(l)];
           pop *= ratio;
           pop.N /= CI.getNumPos(l);  //JMB CI.getNumPos() should never be zero
-          (*v[age - minage])[l] += pop;
+          v[age - minage][l] += pop;
         }
       }
 
@@ -52,7 +52,7 @@ void AgeBandMatrix::Add(const AgeBandMatrix& Addition, const ConversionIndex &CI
           for (l = minl; l < maxl; l++) {
             pop = Addition[age][l];
             pop *= ratio;
-            (*v[age - minage])[CI.getPos(l)] += pop;
+            v[age - minage][CI.getPos(l)] += pop;
           }
         }
       }
@@ -65,17 +65,17 @@ void AgeBandMatrix::Subtract(const DoubleVector& Ratio, const ConversionIndex& C
   if (CI.isSameDl()) {
     int offset = CI.getOffset();
     for (i = 0; i < nrow; i++) {
-      j1 = max(v[i]->minCol(), CI.minLength());
-      j2 = min(v[i]->maxCol(), CI.maxLength());
+      j1 = max(v[i].minCol(), CI.minLength());
+      j2 = min(v[i].maxCol(), CI.maxLength());
       for (j = j1; j < j2; j++)
-        (*v[i])[j] *= Ratio[j - offset];
+        v[i][j] *= Ratio[j - offset];
     }
   } else {
     for (i = 0; i < nrow; i++) {
-      j1 = max(v[i]->minCol(), CI.minLength());
-      j2 = min(v[i]->maxCol(), CI.maxLength());
+      j1 = max(v[i].minCol(), CI.minLength());
+      j2 = min(v[i].maxCol(), CI.maxLength());
       for (j = j1; j < j2; j++)
-        (*v[i])[j] *= Ratio[CI.getPos(j)];
+        v[i][j] *= Ratio[CI.getPos(j)];
     }
   }
 }
@@ -83,8 +83,8 @@ void AgeBandMatrix::Subtract(const DoubleVector& Ratio, const ConversionIndex& C
 void AgeBandMatrix::Multiply(const DoubleVector& Ratio) {
   int i, j;
   for (i = 0; i < nrow; i++)
-    for (j = v[i]->minCol(); j < v[i]->maxCol(); j++)
-      (*v[i])[j] *= Ratio[i];
+    for (j = v[i].minCol(); j < v[i].maxCol(); j++)
+      v[i][j] *= Ratio[i];
 }
 
 void AgeBandMatrix::sumColumns(PopInfoVector& Result) const {
@@ -92,8 +92,8 @@ void AgeBandMatrix::sumColumns(PopInfoVector& Result) const {
   for (i = 0; i < Result.Size(); i++)
     Result[i].setToZero();
   for (i = 0; i < nrow; i++)
-    for (j = v[i]->minCol(); j < v[i]->maxCol(); j++)
-      Result[j] += (*v[i])[j];
+    for (j = v[i].minCol(); j < v[i].maxCol(); j++)
+      Result[j] += v[i][j];
 }
 
 void AgeBandMatrix::IncrementAge() {
@@ -104,40 +104,40 @@ void AgeBandMatrix::IncrementAge() {
 
   //for the oldest age group
   i = nrow - 1;
-  for (j = v[i]->minCol(); j < v[i]->maxCol(); j++)
-    (*v[i])[j] += (*v[i - 1])[j];
+  for (j = v[i].minCol(); j < v[i].maxCol(); j++)
+    v[i][j] += v[i - 1][j];
 
   //for the other age groups
   for (i = nrow - 2; i > 0; i--)
-    for (j = v[i]->minCol(); j < v[i]->maxCol(); j++)
-      (*v[i])[j] = (*v[i - 1])[j];
+    for (j = v[i].minCol(); j < v[i].maxCol(); j++)
+      v[i][j] = v[i - 1][j];
 
   //for the youngest age group
-  for (j = v[0]->minCol(); j < v[0]->maxCol(); j++)
-    (*v[0])[j].setToZero();
+  for (j = v[0].minCol(); j < v[0].maxCol(); j++)
+    v[0][j].setToZero();
 }
 
 void AgeBandMatrix::setToZero() {
   int i, j;
   for (i = 0; i < nrow; i++)
-    for (j = v[i]->minCol(); j < v[i]->maxCol(); j++)
-      (*v[i])[j].setToZero();
+    for (j = v[i].minCol(); j < v[i].maxCol(); j++)
+      v[i][j].setToZero();
 }
 
 void AgeBandMatrix::printNumbers(ofstream& outfile) const {
   int i, j;
   int maxcol = 0;
   for (i = 0; i < nrow; i++)
-    if (v[i]->maxCol() > maxcol)
-      maxcol = v[i]->maxCol();
+    if (v[i].maxCol() > maxcol)
+      maxcol = v[i].maxCol();
 
   for (i = 0; i < nrow; i++) {
     outfile << TAB;
-    for (j = 0; j < v[i]->minCol(); j++)
+    for (j = 0; j < v[i].minCol(); j++)
       outfile << setw(smallwidth) << 0.0 << sep;
-    for (j = v[i]->minCol(); j < v[i]->maxCol(); j++)
-      outfile << setw(smallwidth) << setprecision(smallprecision) << (*v[i])[j].N << sep;
-    for (j = v[i]->maxCol(); j < maxcol; j++)
+    for (j = v[i].minCol(); j < v[i].maxCol(); j++)
+      outfile << setw(smallwidth) << setprecision(smallprecision) << v[i][j].N << sep;
+    for (j = v[i].maxCol(); j < maxcol; j++)
       outfile << setw(smallwidth) << 0.0 << sep;
     outfile << endl;
   }
@@ -147,16 +147,16 @@ void AgeBandMatrix::printWeights(ofstream& outfile) const {
   int i, j;
   int maxcol = 0;
   for (i = 0; i < nrow; i++)
-    if (v[i]->maxCol() > maxcol)
-      maxcol = v[i]->maxCol();
+    if (v[i].maxCol() > maxcol)
+      maxcol = v[i].maxCol();
 
   for (i = 0; i < nrow; i++) {
     outfile << TAB;
-    for (j = 0; j < v[i]->minCol(); j++)
+    for (j = 0; j < v[i].minCol(); j++)
       outfile << setw(smallwidth) << 0.0 << sep;
-    for (j = v[i]->minCol(); j < v[i]->maxCol(); j++)
-      outfile << setw(smallwidth) << setprecision(smallprecision) << (*v[i])[j].W << sep;
-    for (j = v[i]->maxCol(); j < maxcol; j++)
+    for (j = v[i].minCol(); j < v[i].maxCol(); j++)
+      outfile << setw(smallwidth) << setprecision(smallprecision) << v[i][j].W << sep;
+    for (j = v[i].maxCol(); j < maxcol; j++)
       outfile << setw(smallwidth) << 0.0 << sep;
     outfile << endl;
   }
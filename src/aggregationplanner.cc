@@ -0,0 +1,121 @@
+#include "aggregationplanner.h"
+#include "mathfunc.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+
+static int isSameMatrix(const IntMatrix& a, const IntMatrix& b) {
+  int i, j;
+  if (a.Nrow() != b.Nrow())
+    return 0;
+  for (i = 0; i < a.Nrow(); i++) {
+    if (a.Ncol(i) != b.Ncol(i))
+      return 0;
+    for (j = 0; j < a.Ncol(i); j++)
+      if (a[i][j] != b[i][j])
+        return 0;
+  }
+  return 1;
+}
+
+static int isSameLengthGroup(const LengthGroupDivision* const a, const LengthGroupDivision* const b) {
+  int i;
+  if (a->numLengthGroups() != b->numLengthGroups())
+    return 0;
+  for (i = 0; i < a->numLengthGroups(); i++)
+    if ((!isEqual(a->minLength(i), b->minLength(i))) || (!isEqual(a->maxLength(i), b->maxLength(i))))
+      return 0;
+  return 1;
+}
+
+AggregationPlanner::~AggregationPlanner() {
+  int i;
+  for (i = 0; i < int(requests.size()); i++) {
+    if (requests[i]->saggr != 0)
+      delete requests[i]->saggr;
+    if (requests[i]->faggr != 0)
+      delete requests[i]->faggr;
+    delete requests[i]->LgrpDiv;
+    delete requests[i];
+  }
+}
+
+AggregationPlanner::Request* AggregationPlanner::findRequest(const FleetPtrVector& Fleets,
+  const StockPtrVector& Stocks, const LengthGroupDivision* const LgrpDiv,
+  const IntMatrix& Areas, const IntMatrix& Ages, int overcons) {
+
+  int i, j, same;
+  for (i = 0; i < int(requests.size()); i++) {
+    if ((requests[i]->overcons != overcons)
+        || (requests[i]->fleets.Size() != Fleets.Size())
+        || (requests[i]->stocks.Size() != Stocks.Size()))
+      continue;
+
+    //JMB the stocks and fleets have to be in the same order, since the order
+    //that the populations are added together can change the rounding errors
+    same = 1;
+    for (j = 0; j < Fleets.Size(); j++)
+      if (requests[i]->fleets[j] != Fleets[j])
+        same = 0;
+    for (j = 0; j < Stocks.Size(); j++)
+      if (requests[i]->stocks[j] != Stocks[j])
+        same = 0;
+
+    if (same && isSameMatrix(requests[i]->areas, Areas) && isSameMatrix(requests[i]->ages, Ages)
+        && isSameLengthGroup(requests[i]->LgrpDiv, LgrpDiv)) {
+      requests[i]->numuses++;
+      return requests[i];
+    }
+  }
+  return 0;
+}
+
+StockAggregator* AggregationPlanner::getStockAggregator(const StockPtrVector& Stocks,
+  const LengthGroupDivision* const LgrpDiv, const IntMatrix& Areas, const IntMatrix& Ages) {
+
+  FleetPtrVector nofleets;
+  Request* req = this->findRequest(nofleets, Stocks, LgrpDiv, Areas, Ages, -1);
+  if (req != 0)
+    return req->saggr;
+
+  req = new Request(nofleets, Stocks, LgrpDiv, Areas, Ages, -1);
+  req->saggr = new StockAggregator(Stocks, req->LgrpDiv, Areas, Ages);
+  req->saggr->setShared();
+  requests.push_back(req);
+  return req->saggr;
+}
+
+FleetPreyAggregator* AggregationPlanner::getFleetPreyAggregator(const FleetPtrVector& Fleets,
+  const StockPtrVector& Stocks, LengthGroupDivision* const LgrpDiv,
+  const IntMatrix& Areas, const IntMatrix& Ages, int overcons) {
+
+  Request* req = this->findRequest(Fleets, Stocks, LgrpDiv, Areas, Ages, overcons);
+  if (req != 0)
+    return req->faggr;
+
+  req = new Request(Fleets, Stocks, LgrpDiv, Areas, Ages, overcons);
+  req->faggr = new FleetPreyAggregator(Fleets, Stocks, req->LgrpDiv, Areas, Ages, overcons);
+  req->faggr->setShared();
+  requests.push_back(req);
+  return req->faggr;
+}
+
+void AggregationPlanner::newStep() {
+  int i;
+  for (i = 0; i < int(requests.size()); i++) {
+    if (requests[i]->saggr != 0)
+      requests[i]->saggr->clearSum();
+    if (requests[i]->faggr != 0)
+      requests[i]->faggr->clearSum();
+  }
+}
+
+void AggregationPlanner::logSummary() const {
+  int i, num = 0;
+  for (i = 0; i < int(requests.size()); i++)
+    num += requests[i]->numuses;
+  if (num > 0)
+    handle.logMessage(LOGMESSAGE, "Number of aggregators requested by the likelihood components", num);
+  if (num > int(requests.size()))
+    handle.logMessage(LOGMESSAGE, "Number of aggregators after removing the duplicate requests", int(requests.size()));
+}
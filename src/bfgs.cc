@@ -3,14 +3,21 @@
 #include "mathfunc.h"
 #include "doublematrix.h"
 #include "ecosystem.h"
+#include "evaluationengine.h"
 #include "gadget.h"
 #include "global.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* JMB this has been modified to work with the gadget object structure   */
 /* This means that the function has been replaced by a call to ecosystem */
 /* object, and we can use the vector objects that have been defined      */
 
 extern Ecosystem* EcoSystem;
+#ifdef _OPENMP
+extern Ecosystem** EcoSystems;
+#endif
 
 /* calculate the smallest eigenvalue of a matrix */
 double OptInfoBFGS::getSmallestEigenValue(DoubleMatrix M) {
@@ -87,8 +94,15 @@ void OptInfoBFGS::gradient(DoubleVector& point, double pointvalue, DoubleVector&
   double ftmp, tmpacc;
   int i, j;
   int nvars = point.Size();
-  DoubleVector gtmp(point);
 
+#ifdef _OPENMP
+  if (parallel) {
+    this->gradientOMP(point, pointvalue, newgrad);
+    return;
+  }
+#endif
+
+  DoubleVector gtmp(point);
   for (i = 0; i < nvars; i++) {
     for (j = 0; j < nvars; j++)
       gtmp[j] = point[j];
@@ -109,6 +123,7 @@ void OptInfoBFGS::OptimiseLikelihood() {
   double hy, yBy, temphy, tempyby, normgrad;
   double searchgrad, newf, tmpf, betan;
   int i, j, resetgrad, offset, armijo;
+  numevals = 0;
 
   handle.logMessage(LOGINFO, "\nStarting BFGS optimisation algorithm\n");
   int nvars = EcoSystem->numOptVariables();
@@ -143,7 +158,7 @@ void OptInfoBFGS::OptimiseLikelihood() {
 
   this->gradient(trialx, newf, grad);
   tmpf = newf;
-  offset = EcoSystem->getFuncEval();  // number of function evaluations done before loop
+  offset = EcoSystem->getFuncEval() + numevals;  // number of function evaluations done before loop
   sigma = -sigma; //JMB change sign of sigma (and consequently searchgrad)
   resetgrad = 0;
   for (i = 0; i < nvars; i++) {
@@ -152,7 +167,23 @@ void OptInfoBFGS::OptimiseLikelihood() {
   }
 
   while (1) {
-    iters = EcoSystem->getFuncEval() - offset;
+    //JMB store or restore the state of the optimisation at the start of each iteration
+    if (OptCheckpoint::Start(OPTBFGS)) {
+      OptCheckpoint::Transfer(x);
+      OptCheckpoint::Transfer(trialx);
+      OptCheckpoint::Transfer(bestx);
+      OptCheckpoint::Transfer(grad);
+      OptCheckpoint::Transfer(oldgrad);
+      OptCheckpoint::Transfer(invhess);
+      OptCheckpoint::Transfer(newf);
+      OptCheckpoint::Transfer(resetgrad);
+      OptCheckpoint::Transfer(offset);
+      OptCheckpoint::Transfer(numevals);
+      OptCheckpoint::Transfer(gradacc);
+      OptCheckpoint::Finish();
+    }
+
+    iters = EcoSystem->getFuncEval() + numevals - offset;
     if (isZero(newf)) {
       handle.logMessage(LOGINFO, "Error in BFGS optimisation after", iters, "function evaluations, f(x) = 0");
       converge = -1;
@@ -212,6 +243,10 @@ void OptInfoBFGS::OptimiseLikelihood() {
     armijo = 0;
     betan = step;
     if (searchgrad > verysmall) {
+#ifdef _OPENMP
+      if (parallel)
+        armijo = this->linesearchOMP(x, search, newf, searchgrad, betan, trialx, tmpf);
+#endif
       while ((armijo == 0) && (betan > rathersmall)) {
         for (i = 0; i < nvars; i++)
           trialx[i] = x[i] + (betan * search[i]);
@@ -247,7 +282,7 @@ void OptInfoBFGS::OptimiseLikelihood() {
       trialx[i] = x[i] * init[i];
     }
 
-    iters = EcoSystem->getFuncEval() - offset;
+    iters = EcoSystem->getFuncEval() + numevals - offset;
     EcoSystem->storeVariables(newf, trialx);
     handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
     handle.logMessage(LOGINFO, "The likelihood score is", newf, "at the point");
@@ -292,13 +327,92 @@ void OptInfoBFGS::OptimiseLikelihood() {
   }
 }
 
-/* bfgs isn't optimized with OpenMP, this method only call the sequential method*/
 #ifdef _OPENMP
-//#ifdef SPECULATIVE
+/* the forward difference gradient needs one function evaluation per parameter */
+/* and these are independent, so the perturbed points are evaluated as a batch, */
+/* shared out between the copies of the model.  The values are the same as     */
+/* those calculated by the sequential gradient function                        */
+void OptInfoBFGS::gradientOMP(DoubleVector& point, double pointvalue, DoubleVector& newgrad) {
+
+  int i, j;
+  int nvars = point.Size();
+  DoubleMatrix gtmp(nvars, nvars, 0.0);
+  DoubleVector ftmp(nvars, 0.0);
+  DoubleVector tmpacc(nvars, 0.0);
+
+  for (i = 0; i < nvars; i++) {
+    //JMB the scaled parameter values should aways be positive
+    if (point[i] < 0.0)
+      handle.logMessage(LOGINFO, "Error in BFGS - negative parameter when calculating the gradient", point[i]);
+
+    for (j = 0; j < nvars; j++)
+      gtmp[i][j] = point[j];
+    tmpacc[i] = gradacc * max(point[i], 1.0);
+    gtmp[i][i] += tmpacc[i];
+  }
+
+  EvaluationEngine::Evaluate(gtmp, ftmp, 0, nvars);
+  for (i = 0; i < nvars; i++)
+    newgrad[i] = (ftmp[i] - pointvalue) / tmpacc[i];
+  numevals += nvars;
+}
+
+/* the armijo linesearch evaluates the trial points betan, betan*beta, ... in   */
+/* turn until one of them is accepted.  Here the next numThr step lengths are   */
+/* evaluated at the same time and the first one (in the sequential order) that */
+/* meets the armijo condition is accepted, so the point found is the same as    */
+/* for the sequential linesearch.  Only the trial points that the sequential    */
+/* linesearch would have evaluated are counted as function evaluations         */
+int OptInfoBFGS::linesearchOMP(const DoubleVector& x, const DoubleVector& search,
+  double fx, double searchgrad, double& betan, DoubleVector& trialx, double& tmpf) {
+
+  int i, k, ntrials, numThr = omp_get_max_threads();
+  int nvars = x.Size();
+  double b;
+  DoubleMatrix trials(numThr, nvars, 0.0);
+  DoubleVector betas(numThr, 0.0);
+  DoubleVector f(numThr, 0.0);
+
+  while (betan > rathersmall) {
+    ntrials = 0;
+    b = betan;
+    while ((ntrials < numThr) && (b > rathersmall)) {
+      betas[ntrials] = b;
+      for (i = 0; i < nvars; i++)
+        trials[ntrials][i] = x[i] + (b * search[i]);
+      ntrials++;
+      b *= beta;
+    }
+
+    EvaluationEngine::Evaluate(trials, f, 0, ntrials);
+
+    for (k = 0; k < ntrials; k++) {
+      numevals++;
+      for (i = 0; i < nvars; i++)
+        trialx[i] = trials[k][i];
+      tmpf = f[k];
+      betan = betas[k];
+      if ((fx > tmpf) && ((fx - tmpf) > (betan * searchgrad)))
+        return 1;
+    }
+    betan = b;
+  }
+  return 0;
+}
+
 void OptInfoBFGS::OptimiseLikelihoodOMP() {
-	OptimiseLikelihood();
+  int i, numThr = omp_get_max_threads();
+  for (i = 0; i < numThr; i++) // scale the variables for the ecosystem of every thread
+    EcoSystems[i]->scaleVariables();
+
+  parallel = 1;
+  this->OptimiseLikelihood();
+  parallel = 0;
 }
+
+/* the parallel gradient and linesearch give the same results as the sequential */
+/* versions, so the speculative and reproducible versions are identical         */
 void OptInfoBFGS::OptimiseLikelihoodREP() {
-	OptimiseLikelihood();
+  this->OptimiseLikelihoodOMP();
 }
 #endif
@@ -136,6 +136,12 @@ void BoundLikelihood::Reset(const Keeper* const keeper) {
     handle.logMessage(LOGMESSAGE, "Reset boundlikelihood component", this->getName());
 }
 
+void BoundLikelihood::restoreState(int id, const TimeClass* const TimeInfo) {
+  //JMB the likelihood score is recalculated from the parameters before the simulation
+  likelihood = 0.0;
+  handle.setNaNFlag(0);  // reset the NaN count
+}
+
 void BoundLikelihood::addLikelihoodKeeper(const TimeClass* const TimeInfo, Keeper* const keeper) {
 
   int i;
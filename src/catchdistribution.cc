@@ -10,6 +10,7 @@
 #include "mathfunc.h"
 #include "stockprey.h"
 #include "ludecomposition.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -26,11 +27,12 @@ CatchDistribution::CatchDistribution(CommentStream& infile, const AreaClass* con
   char aggfilename[MaxStrLength];
   strncpy(datafilename, "", MaxStrLength);
   strncpy(aggfilename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   timeindex = 0;
   yearly = 0;
+  printmodel = 0;
   functionname = new char[MaxStrLength];
   strncpy(functionname, "", MaxStrLength);
 
@@ -222,6 +224,113 @@ CatchDistribution::CatchDistribution(CommentStream& infile, const AreaClass* con
       handle.logMessage(LOGWARN, "Warning in catchdistribution - unrecognised function", functionname);
       break;
   }
+
+  this->prepareObservations(TimeInfo);
+}
+
+void CatchDistribution::prepareObservations(const TimeClass* const TimeInfo) {
+  int i, area, age, len, numage, numlen;
+  double total;
+  DoubleMatrix* prep;
+
+  //JMB find the index of the likelihood data for each timestep
+  timeMap.resize(TimeInfo->numTotalSteps() + 1, -1);
+  for (i = 0; i < Years.Size(); i++)
+    timeMap[TimeInfo->calcSteps(Years[i], Steps[i])] = i;
+
+  for (i = 0; i < obsDistribution.Nrow(); i++) {
+    obsPrepared.resize();
+    for (area = 0; area < obsDistribution.Ncol(i); area++) {
+      const DoubleMatrix& obs = *obsDistribution[i][area];
+      numage = obs.Nrow();
+      numlen = obs.Ncol();
+      prep = 0;
+
+      switch (functionnumber) {
+        case 1:
+          if (numage == 1) {
+            prep = new DoubleMatrix(1, 1, 0.0);
+            (*prep)[0][0] = MN.calcDataConstant(obs[0]);
+          } else {
+            DoubleVector data(numage, 0.0);
+            prep = new DoubleMatrix(1, numlen, 0.0);
+            for (len = 0; len < numlen; len++) {
+              for (age = 0; age < numage; age++)
+                data[age] = obs[age][len];
+              (*prep)[0][len] = MN.calcDataConstant(data);
+            }
+          }
+          break;
+        case 4:
+          if (!yearly) {
+            total = 0.0;
+            for (age = 0; age < numage; age++)
+              for (len = 0; len < numlen; len++)
+                total += obs[age][len];
+            if (!(isZero(total)))
+              total = 1.0 / total;
+            prep = new DoubleMatrix(numage, numlen, 0.0);
+            for (age = 0; age < numage; age++)
+              for (len = 0; len < numlen; len++)
+                (*prep)[age][len] = obs[age][len] * total;
+          }
+          break;
+        case 5:
+          total = 0.0;
+          for (age = 0; age < numage; age++)
+            for (len = 0; len < numlen; len++)
+              total += obs[age][len];
+          if (isZero(total))
+            total = verybig;
+          else
+            total = 1.0 / total;
+          prep = new DoubleMatrix(numage, numlen, 0.0);
+          for (age = 0; age < numage; age++)
+            for (len = 0; len < numlen; len++)
+              (*prep)[age][len] = obs[age][len] * total;
+          break;
+        case 6:
+          prep = new DoubleMatrix(numage, numlen, 0.0);
+          for (age = 0; age < numage; age++) {
+            total = 0.0;
+            for (len = 0; len < numlen; len++)
+              total += obs[age][len];
+            if (isZero(total))
+              total = verybig;
+            else
+              total = 1.0 / total;
+            for (len = 0; len < numlen; len++)
+              (*prep)[age][len] = log((obs[age][len] * total) + verysmall);
+          }
+          break;
+        case 7:
+          if (!yearly) {
+            prep = new DoubleMatrix(1, 1, 0.0);
+            for (age = 0; age < numage; age++)
+              for (len = 0; len < numlen; len++)
+                (*prep)[0][0] += obs[age][len];
+          }
+          break;
+        case 8:
+          if (!yearly) {
+            prep = new DoubleMatrix(numage, numlen, 0.0);
+            for (len = 0; len < numlen; len++) {
+              total = 0.0;
+              for (age = 0; age < numage; age++)
+                total += obs[age][len];
+              if (!(isZero(total)))
+                total = 1.0 / total;
+              for (age = 0; age < numage; age++)
+                (*prep)[age][len] = obs[age][len] * total;
+            }
+          }
+          break;
+        default:
+          break;
+      }
+      obsPrepared[i].resize(prep);
+    }
+  }
 }
 
 void CatchDistribution::readDistributionData(CommentStream& infile,
@@ -333,12 +442,14 @@ CatchDistribution::~CatchDistribution() {
     for (j = 0; j < obsDistribution.Ncol(i); j++) {
       delete obsDistribution[i][j];
       delete modelDistribution[i][j];
+      if (obsPrepared[i][j] != 0)
+        delete obsPrepared[i][j];
     }
   for (i = 0; i < modelYearData.Size(); i++) {
     delete modelYearData[i];
     delete obsYearData[i];
   }
-  delete aggregator;
+  //JMB the aggregator is owned by the AggregationPlanner so dont delete it here
   delete LgrpDiv;
   delete[] functionname;
 }
@@ -427,11 +538,8 @@ void CatchDistribution::printLikelihood(ofstream& outfile, const TimeClass* cons
   if (!AAT.atCurrentTime(TimeInfo))
     return;
 
-  int i, area, age, len;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  int area, age, len;
+  timeindex = timeMap[TimeInfo->getTime()];
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in catchdistribution - invalid timestep");
 
@@ -453,7 +561,8 @@ void CatchDistribution::printLikelihood(ofstream& outfile, const TimeClass* cons
   }
 }
 
-void CatchDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
+void CatchDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+  AggregationPlanner* const planner) {
   int i, j, k, found, minage, maxage;
   FleetPtrVector fleets;
   StockPtrVector stocks;
@@ -554,7 +663,13 @@ void CatchDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVecto
       handle.logMessage(LOGWARN, "Warning in catchdistribution - maximum length group greater than stock length");
   }
 
-  aggregator = new FleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
+  aggregator = planner->getFleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
+}
+
+int CatchDistribution::isActive(int year, int step, const TimeClass* const TimeInfo) const {
+  if (isZero(weight))
+    return 0;
+  return AAT.atTime(year, step, TimeInfo);
 }
 
 void CatchDistribution::addLikelihood(const TimeClass* const TimeInfo) {
@@ -565,11 +680,7 @@ void CatchDistribution::addLikelihood(const TimeClass* const TimeInfo) {
   if ((handle.getLogLevel() >= LOGMESSAGE) && ((!yearly) || (TimeInfo->getStep() == TimeInfo->numSteps())))
     handle.logMessage(LOGMESSAGE, "Calculating likelihood score for catchdistribution component", this->getName());
 
-  int i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = timeMap[TimeInfo->getTime()];
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in catchdistribution - invalid timestep");
 
@@ -635,7 +746,7 @@ double CatchDistribution::calcLikMultinomial() {
       //only one age-group, so calculate multinomial based on length distribution
       likelihoodValues[timeindex][area] +=
         MN.calcLogLikelihood((*obsDistribution[timeindex][area])[0],
-          (*modelDistribution[timeindex][area])[0]);
+          (*modelDistribution[timeindex][area])[0], (*obsPrepared[timeindex][area])[0][0]);
 
     } else {
       //many age-groups, so calculate multinomial based on age distribution per length group
@@ -644,7 +755,8 @@ double CatchDistribution::calcLikMultinomial() {
           dist[age] = (*modelDistribution[timeindex][area])[age][len];
           data[age] = (*obsDistribution[timeindex][area])[age][len];
         }
-        likelihoodValues[timeindex][area] += MN.calcLogLikelihood(data, dist);
+        likelihoodValues[timeindex][area] +=
+          MN.calcLogLikelihood(data, dist, (*obsPrepared[timeindex][area])[0][len]);
       }
     }
   }
@@ -661,27 +773,31 @@ double CatchDistribution::calcLikPearson(const TimeClass* const TimeInfo) {
    * for the stock and the catch data.*/
 
   double totallikelihood = 0.0;
-  int age, len, area;
+  double lik, model;
+  int age, len, area, maxlen;
 
   for (area = 0; area < areas.Nrow(); area++) {
     likelihoodValues[timeindex][area] = 0.0;
 
-    //JMB - changed to remove the need to store minrow and mincol stuff ...
-    for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
-      for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
+    //JMB the modelled distribution is only needed for the yearly data or for printing
+    if ((yearly) || (printmodel))
+      for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
+        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
+          (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
 
     if (!yearly) { //calculate likelihood on all steps
+      //JMB calculate the likelihood score directly from the aggregated data
+      lik = 0.0;
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
-        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          likelihoodValues[timeindex][area] +=
-            ((*modelDistribution[timeindex][area])[age][len] -
-            (*obsDistribution[timeindex][area])[age][len]) *
-            ((*modelDistribution[timeindex][area])[age][len] -
-            (*obsDistribution[timeindex][area])[age][len]) /
-            fabs(((*modelDistribution[timeindex][area])[age][len] + epsilon));
+        const PopInfoIndexVector& modelage = (*alptr)[area][age];
+        const DoubleVector& obsage = (*obsDistribution[timeindex][area])[age];
+        maxlen = (*alptr)[area].maxLength(age);
+        for (len = (*alptr)[area].minLength(age); len < maxlen; len++) {
+          model = modelage[len].N;
+          lik += (model - obsage[len]) * (model - obsage[len]) / fabs((model + epsilon));
         }
       }
+      likelihoodValues[timeindex][area] = lik;
       totallikelihood += likelihoodValues[timeindex][area];
 
     } else { //calculate likelihood on year basis
@@ -722,25 +838,31 @@ double CatchDistribution::calcLikGamma(const TimeClass* const TimeInfo) {
   //This function is scale independent.
 
   double totallikelihood = 0.0;
-  int age, len, area;
+  double lik, model;
+  int age, len, area, maxlen;
 
   for (area = 0; area < areas.Nrow(); area++) {
     likelihoodValues[timeindex][area] = 0.0;
 
-    //JMB - changed to remove the need to store minrow and mincol stuff ...
-    for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
-      for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
+    //JMB the modelled distribution is only needed for the yearly data or for printing
+    if ((yearly) || (printmodel))
+      for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
+        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
+          (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
 
     if (!yearly) { //calculate likelihood on all steps
+      //JMB calculate the likelihood score directly from the aggregated data
+      lik = 0.0;
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
-        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          likelihoodValues[timeindex][area] +=
-            (*obsDistribution[timeindex][area])[age][len] /
-            ((*modelDistribution[timeindex][area])[age][len] + epsilon) +
-            log((*modelDistribution[timeindex][area])[age][len] + epsilon);
+        const PopInfoIndexVector& modelage = (*alptr)[area][age];
+        const DoubleVector& obsage = (*obsDistribution[timeindex][area])[age];
+        maxlen = (*alptr)[area].maxLength(age);
+        for (len = (*alptr)[area].minLength(age); len < maxlen; len++) {
+          model = modelage[len].N + epsilon;
+          lik += obsage[len] / model + log(model);
         }
       }
+      likelihoodValues[timeindex][area] = lik;
       totallikelihood += likelihoodValues[timeindex][area];
 
     } else { //calculate likelihood on year basis
@@ -787,18 +909,18 @@ double CatchDistribution::calcLikLog(const TimeClass* const TimeInfo) {
     totalmodel = 0.0;
     totaldata = 0.0;
 
-    //JMB - changed to remove the need to store minrow and mincol stuff ...
-    for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
-      for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
+    //JMB the modelled distribution is only needed for the yearly data or for printing
+    if ((yearly) || (printmodel))
+      for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
+        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
+          (*modelDistribution[timeindex][area])[age][len] = (*alptr)[area][age][len].N;
 
     if (!yearly) { //calculate likelihood on all steps
-      for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
-        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          totalmodel += (*modelDistribution[timeindex][area])[age][len];
-          totaldata += (*obsDistribution[timeindex][area])[age][len];
-        }
-      }
+      for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
+        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
+          totalmodel += (*alptr)[area][age][len].N;
+
+      totaldata = (*obsPrepared[timeindex][area])[0][0];
       ratio = log(totaldata / totalmodel);
       likelihoodValues[timeindex][area] += (ratio * ratio);
 
@@ -836,39 +958,41 @@ double CatchDistribution::calcLikLog(const TimeClass* const TimeInfo) {
 
 double CatchDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
 
-  double temp, totallikelihood, totalmodel, totaldata;
-  int age, len, area;
+  double temp, lik, totallikelihood, totalmodel, totaldata;
+  int age, len, area, maxlen;
 
   totallikelihood = 0.0;
   for (area = 0; area < areas.Nrow(); area++) {
     likelihoodValues[timeindex][area] = 0.0;
 
-    for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
-      for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+    //JMB the modelled distribution is only needed for the yearly data or for printing
+    if ((yearly) || (printmodel))
+      for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
+        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
+          (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
 
     totalmodel = 0.0;
     totaldata = 0.0;
     if (!yearly) { //calculate likelihood on all steps
-      for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
-        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          totalmodel += (*modelDistribution[timeindex][area])[age][len];
-          totaldata += (*obsDistribution[timeindex][area])[age][len];
-        }
-      }
+      for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
+        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
+          totalmodel += ((*alptr)[area][age][len]).N;
 
       if (!(isZero(totalmodel)))
         totalmodel = 1.0 / totalmodel;
-      if (!(isZero(totaldata)))
-        totaldata = 1.0 / totaldata;
 
+      //the observed proportions have already been calculated
+      lik = 0.0;
       for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
-        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-          temp = (((*obsDistribution[timeindex][area])[age][len] * totaldata)
-            - ((*modelDistribution[timeindex][area])[age][len] * totalmodel));
-          likelihoodValues[timeindex][area] += (temp * temp);
+        const PopInfoIndexVector& modelage = (*alptr)[area][age];
+        const DoubleVector& obsage = (*obsPrepared[timeindex][area])[age];
+        maxlen = (*alptr)[area].maxLength(age);
+        for (len = (*alptr)[area].minLength(age); len < maxlen; len++) {
+          temp = obsage[len] - (modelage[len].N * totalmodel);
+          lik += (temp * temp);
         }
       }
+      likelihoodValues[timeindex][area] = lik;
       totallikelihood += likelihoodValues[timeindex][area];
 
     } else { //calculate likelihood on year basis
@@ -925,28 +1049,26 @@ double CatchDistribution::calcLikStratified(const TimeClass* const TimeInfo) {
   for (area = 0; area < areas.Nrow(); area++) {
     likelihoodValues[timeindex][area] = 0.0;
 
-    for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
-      for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
+    //JMB the modelled distribution is only needed for the yearly data or for printing
+    if ((yearly) || (printmodel))
+      for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++)
+        for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
+          (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
 
     if (!yearly) { //calculate likelihood on all steps
       //calculate an age distribution for each length class
       for (len = 0; len < numlen; len++) {
         totalmodel = 0.0;
-        totaldata = 0.0;
-        for (age = 0; age < numage; age++) {
-          totalmodel += (*modelDistribution[timeindex][area])[age][len];
-          totaldata += (*obsDistribution[timeindex][area])[age][len];
-        }
+        for (age = 0; age < numage; age++)
+          totalmodel += ((*alptr)[area][age][len]).N;
 
         if (!(isZero(totalmodel)))
           totalmodel = 1.0 / totalmodel;
-        if (!(isZero(totaldata)))
-          totaldata = 1.0 / totaldata;
 
+        //the observed proportions have already been calculated
         for (age = 0; age < numage; age++) {
-          temp = (((*obsDistribution[timeindex][area])[age][len] * totaldata)
-            - ((*modelDistribution[timeindex][area])[age][len] * totalmodel));
+          temp = ((*obsPrepared[timeindex][area])[age][len]
+            - (((*alptr)[area][age][len]).N * totalmodel));
           likelihoodValues[timeindex][area] += (temp * temp);
         }
       }
@@ -1025,7 +1147,7 @@ void CatchDistribution::calcCorrelation() {
 double CatchDistribution::calcLikMVNormal() {
 
   double totallikelihood = 0.0;
-  double sumdata, sumdist;
+  double sumdist;
   int age, len, area;
 
   if ((illegal) || (LU.isIllegal()) || isZero(sigma))
@@ -1033,21 +1155,15 @@ double CatchDistribution::calcLikMVNormal() {
 
   DoubleVector diff(LgrpDiv->numLengthGroups(), 0.0);
   for (area = 0; area < areas.Nrow(); area++) {
-    sumdata = 0.0;
     sumdist = 0.0;
     likelihoodValues[timeindex][area] = 0.0;
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
         (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
-        sumdata += (*obsDistribution[timeindex][area])[age][len];
         sumdist += (*modelDistribution[timeindex][area])[age][len];
       }
     }
 
-    if (isZero(sumdata))
-      sumdata = verybig;
-    else
-      sumdata = 1.0 / sumdata;
     if (isZero(sumdist))
       sumdist = verybig;
     else
@@ -1056,7 +1172,7 @@ double CatchDistribution::calcLikMVNormal() {
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
       diff.setToZero();
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++)
-        diff[len] = ((*obsDistribution[timeindex][area])[age][len] * sumdata)
+        diff[len] = (*obsPrepared[timeindex][area])[age][len]
                     - ((*modelDistribution[timeindex][area])[age][len] * sumdist);
 
       likelihoodValues[timeindex][area] += diff * LU.Solve(diff);
@@ -1071,7 +1187,7 @@ double CatchDistribution::calcLikMVNormal() {
 double CatchDistribution::calcLikMVLogistic() {
 
   double totallikelihood = 0.0;
-  double sumdata = 0.0, sumdist = 0.0, sumnu = 0.0;
+  double sumdist = 0.0, sumnu = 0.0;
   int age, len, area, p;
 
   p = LgrpDiv->numLengthGroups();
@@ -1080,18 +1196,12 @@ double CatchDistribution::calcLikMVLogistic() {
   for (area = 0; area < areas.Nrow(); area++) {
     likelihoodValues[timeindex][area] = 0.0;
     for (age = (*alptr)[area].minAge(); age <= (*alptr)[area].maxAge(); age++) {
-      sumdata = 0.0;
       sumdist = 0.0;
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
         (*modelDistribution[timeindex][area])[age][len] = ((*alptr)[area][age][len]).N;
-        sumdata += (*obsDistribution[timeindex][area])[age][len];
         sumdist += (*modelDistribution[timeindex][area])[age][len];
       }
 
-      if (isZero(sumdata))
-        sumdata = verybig;
-      else
-        sumdata = 1.0 / sumdata;
       if (isZero(sumdist))
         sumdist = verybig;
       else
@@ -1100,7 +1210,7 @@ double CatchDistribution::calcLikMVLogistic() {
       sumnu = 0.0;
       nu.setToZero();
       for (len = (*alptr)[area].minLength(age); len < (*alptr)[area].maxLength(age); len++) {
-        nu[len] = log(((*obsDistribution[timeindex][area])[age][len] * sumdata) + verysmall)
+        nu[len] = (*obsPrepared[timeindex][area])[age][len]
                   - log(((*modelDistribution[timeindex][area])[age][len] * sumdist) + verysmall);
 
         sumnu += nu[len];
@@ -6,6 +6,7 @@
 #include "areatime.h"
 #include "fleet.h"
 #include "stock.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -23,7 +24,7 @@ CatchInKilos::CatchInKilos(CommentStream& infile, const AreaClass* const Area,
   strncpy(text, "", MaxStrLength);
   strncpy(datafilename, "", MaxStrLength);
   strncpy(aggfilename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   functionname = new char[MaxStrLength];
@@ -126,6 +127,16 @@ CatchInKilos::CatchInKilos(CommentStream& infile, const AreaClass* const Area,
   datafile.clear();
 }
 
+void CatchInKilos::restoreState(int id, const TimeClass* const TimeInfo) {
+  Likelihood::restoreState(id, TimeInfo);
+  //JMB the modelled data is summed over the timesteps so the data for the
+  //rest of the simulation needs to be reset
+  int i;
+  for (i = 0; i < Years.Size(); i++)
+    if ((Years[i] > TimeInfo->getYear()) || ((Years[i] == TimeInfo->getYear()) && (Steps[i] >= TimeInfo->getStep())))
+      modelDistribution[i].setToZero();
+}
+
 void CatchInKilos::Reset(const Keeper* const keeper) {
   Likelihood::Reset(keeper);
   if (isZero(weight))
@@ -171,6 +182,12 @@ double CatchInKilos::calcLikSumSquares(const TimeClass* const TimeInfo) {
   return totallikelihood;
 }
 
+int CatchInKilos::isActive(int year, int step, const TimeClass* const TimeInfo) const {
+  if (isZero(weight))
+    return 0;
+  return AAT.atTime(year, step, TimeInfo);
+}
+
 void CatchInKilos::addLikelihood(const TimeClass* const TimeInfo) {
 
   if ((!(AAT.atCurrentTime(TimeInfo))) || (isZero(weight)))
@@ -8,6 +8,7 @@
 #include "stockprey.h"
 #include "mathfunc.h"
 #include "readaggregation.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -24,7 +25,7 @@ CatchStatistics::CatchStatistics(CommentStream& infile, const AreaClass* const A
   char aggfilename[MaxStrLength];
   strncpy(datafilename, "", MaxStrLength);
   strncpy(aggfilename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   timeindex = 0;
@@ -330,6 +331,12 @@ void CatchStatistics::readStatisticsData(CommentStream& infile,
   }
 
   AAT.addActions(Years, Steps, TimeInfo);
+
+  //JMB find the index of the likelihood data for each timestep
+  timeMap.resize(TimeInfo->numTotalSteps() + 1, -1);
+  for (i = 0; i < Years.Size(); i++)
+    timeMap[TimeInfo->calcSteps(Years[i], Steps[i])] = i;
+
   if (count == 0)
     handle.logMessage(LOGWARN, "Warning in catchstatistics - found no data in the data file for", this->getName());
   if (reject != 0)
@@ -349,7 +356,7 @@ CatchStatistics::~CatchStatistics() {
     delete[] lenindex[i];
   for (i = 0; i < ageindex.Size(); i++)
     delete[] ageindex[i];
-  delete aggregator;
+  //JMB the aggregator is owned by the AggregationPlanner so dont delete it here
   for (i = 0; i < numbers.Size(); i++) {
     delete numbers[i];
     delete obsMean[i];
@@ -390,7 +397,8 @@ void CatchStatistics::Print(ofstream& outfile) const {
   outfile.flush();
 }
 
-void CatchStatistics::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
+void CatchStatistics::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+  AggregationPlanner* const planner) {
   int i, j, k, found, minage, maxage;
   FleetPtrVector fleets;
   StockPtrVector stocks;
@@ -500,20 +508,22 @@ void CatchStatistics::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector&
       handle.logMessage(LOGWARN, "Warning in catchstatistics - maximum length group greater than stock length");
   }
 
-  aggregator = new FleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
+  aggregator = planner->getFleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
 }
 
 
+int CatchStatistics::isActive(int year, int step, const TimeClass* const TimeInfo) const {
+  if (isZero(weight))
+    return 0;
+  return AAT.atTime(year, step, TimeInfo);
+}
+
 void CatchStatistics::addLikelihood(const TimeClass* const TimeInfo) {
 
   if ((!(AAT.atCurrentTime(TimeInfo))) || (isZero(weight)))
     return;
 
-  int i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = timeMap[TimeInfo->getTime()];
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in catchstatistics - invalid timestep");
 
@@ -627,11 +637,8 @@ void CatchStatistics::printLikelihood(ofstream& outfile, const TimeClass* const
   if (!AAT.atCurrentTime(TimeInfo))
     return;
 
-  int i, area, age, length;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  int area, age, length;
+  timeindex = timeMap[TimeInfo->getTime()];
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in catchstatistics - invalid timestep");
 
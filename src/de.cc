@@ -13,9 +13,12 @@
 #include "intvector.h"
 #include "errorhandler.h"
 #include "ecosystem.h"
+#include "evaluationengine.h"
 #include "global.h"
 #include <float.h>
 #include "runid.h"
+#include "populationmatrix.h"
+#include "randomstream.h"
 
 #ifdef _OPENMP
 #include "omp.h"
@@ -60,10 +63,10 @@ void OptInfoDE::OptimiseLikelihood() {
 
 // SOLVER
     printf("SOLVER DE\n");
-    DoubleMatrix pos(size, nvars, 0.0);  // new population    
-    DoubleMatrix vel(size, nvars, 0.0);    // velocity matrix
-    DoubleMatrix pos_new(size, nvars, 0.0);  // new population
-    DoubleMatrix pos_b(size, nvars, 0.0);  // best position matrix
+    PopulationMatrix pos(size, nvars, 0.0);  // new population    
+    PopulationMatrix vel(size, nvars, 0.0);    // velocity matrix
+    PopulationMatrix pos_new(size, nvars, 0.0);  // new population
+    PopulationMatrix pos_b(size, nvars, 0.0);  // best position matrix
     DoubleVector fit(size); // particle fitness vector
     DoubleVector fit_b(size); // best fitness vector
     IntMatrix comm(size, size, 0); // communications:who informs who rows : those who inform cols : those who are informed
@@ -73,6 +76,7 @@ void OptInfoDE::OptimiseLikelihood() {
     double prob;
     double dist;
     double a, b;
+    unsigned key; // key for the random numbers used in each iteration
     double rho1, rho2; //random numbers (coefficients)
     double w; //current omega
     int steps = 0; //!= iters?
@@ -145,35 +149,20 @@ void OptInfoDE::OptimiseLikelihood() {
     }
 
 
-    double ***rand;
-    rand = (double ***) calloc(size,sizeof(double **));
-    for (i = 0; i < size; i++) {
-	rand[i] = (double **) calloc(nvars,sizeof(double *)); 
-        for (d = 0; d < nvars; d++) rand[i][d] = (double *) calloc(2,sizeof(double));
-    }
-	
-    double **randDE;
-    randDE = (double **) calloc(size,sizeof(double *));
-    for (i=0; i< size; i++)
-	randDE[i] = (double *) calloc(nvars+4,sizeof(double));
-
-    for (i = 1; i < size; i++) {
-	for (d = 0; d < nvars; d++) {
-		rand[i][d][0] = rand_r(&seed);
-                rand[i][d][1] = rand_r(&seed);
-	}
-    }
+    //JMB the random numbers for each particle are calculated from its own stream
+    key = rand_r(&seed);
 
 
     for (i = 1; i < size; i++) {
         ostringstream spos, svel;
         spos << "Initial position of particle " << i << " [";
         svel << "Initial velocity of particle " << i << " [";
+        RandomStream rs(key, i);
         // for each dimension
         for (d = 0; d < nvars; d++) {
             // generate two numbers within the specified range and around trialx
-            a = lowerb[d] + (upperb[d] - lowerb[d]) * (rand[i][d][0] * 1.0 / RAND_MAX);
-            b = lowerb[d] + (upperb[d] - lowerb[d]) * (rand[i][d][1] * 1.0 / RAND_MAX);
+            a = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
+            b = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
 
             // initialize position
             pos[i][d] = a;
@@ -205,6 +194,23 @@ void OptInfoDE::OptimiseLikelihood() {
     steps = 0;
 
     while (1) {
+        //JMB store or restore the state of the optimisation at the start of each iteration
+        if (OptCheckpoint::Start(OPTDE)) {
+          this->transferState();
+          OptCheckpoint::Transfer(pos);
+          OptCheckpoint::Transfer(vel);
+          OptCheckpoint::Transfer(pos_new);
+          OptCheckpoint::Transfer(pos_b);
+          OptCheckpoint::Transfer(fit);
+          OptCheckpoint::Transfer(fit_b);
+          OptCheckpoint::Transfer(bestx);
+          OptCheckpoint::Transfer(best.bestf);
+          OptCheckpoint::Transfer(best.index);
+          OptCheckpoint::Transfer(steps);
+          OptCheckpoint::Transfer(offset);
+          OptCheckpoint::Finish();
+        }
+
 //        handle.logMessage(LOGINFO, "PSO optimisation after", psosteps * size, "\n");
         if (isZero(best.bestf)) {
             iters=0;
@@ -261,24 +267,6 @@ void OptInfoDE::OptimiseLikelihood() {
            		vel.AddRows(growth_popul, nvars, 0.0);
            		fit.resize(growth_popul, 0.0);
            		fit_b.resize(growth_popul, 0.0);
-			if (growth_popul < 0 ) {
-           			for (i = size; i < size+growth_popul; i++) {
-           			    for (d = 0; d < nvars; d++) cfree(rand[i][d]);
-               			    cfree(rand[i]);
-				    cfree(randDE[i]);
-           			}
-           			rand   = (double ***) realloc(rand,(size+growth_popul)*sizeof(double));
-				randDE = (double **)  realloc(randDE, (size+growth_popul)*sizeof(double));
-			} else {
-	                	rand = (double ***) realloc(rand,(size+growth_popul)*sizeof(double));
-                                randDE = (double **)  realloc(randDE, (size+growth_popul)*sizeof(double));
-	                	for (i = size; i < size+growth_popul; i++) {
-	                	      rand[i]   = (double **) calloc(nvars,sizeof(double *));
-				      randDE[i] = (double *)  calloc(nvars+4 ,sizeof(double));
-	                	      for (d = 0; d < nvars; d++) rand[i][d] = (double *) calloc(2,sizeof(double));
-	                	}
-			}
-		
 		}
 			
 		if (nrestarts == 1 ) {
@@ -287,19 +275,14 @@ void OptInfoDE::OptimiseLikelihood() {
 		else if (nrestarts == 0 ) {
 			init_reset=size;
 		}
-			
-           	for (i = init_reset; i < (size+growth_popul); i++) {
-                	for (d = 0; d < nvars; d++) {
-                       		rand[i][d][0] = (rand_r(&seed) * 1.0) / RAND_MAX;
-                       		rand[i][d][1] = (rand_r(&seed) * 1.0) / RAND_MAX;
-                	}
-           	}
+		key = rand_r(&seed);
 
 
            	for (i=init_reset;i<(size+growth_popul);i++){
+	             RandomStream rs(key, i);
 	             for (d = 0; d < nvars; d++) {
-                        	a = lowerb[d] + (upperb[d] - lowerb[d]) * rand[i][d][0];
-                        	b = lowerb[d] + (upperb[d] - lowerb[d]) * rand[i][d][1];
+                        	a = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
+                        	b = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
 	                	pos[i][d]   = a ;
 	                	pos_b[i][d] = a ;
 	                	vel[i][d]   = (a - b) / 2.;
@@ -311,40 +294,28 @@ void OptInfoDE::OptimiseLikelihood() {
            	growth_popul=0;
 		STATE=0;
 	}
-        for (i = 0; i < size; i++) {
-		p1 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-		do  
-			p2 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-		while (p2 == p1);
-                do 
-                        p3 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-                while ((p3 == p1) || (p3 == p2));
-                do 
-                        p4 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-                while ((p4 == p3) || (p4 == p2) || (p4 == p1));
-		randDE[i][0]= (double) p1;
-                randDE[i][1]= (double) p2;
-                randDE[i][2]= (double) p3;
-                randDE[i][3]= (double) p4;
-		for (d = 0; d < nvars; d++) {
-			rand[i][d][0] = (rand_r(&seed) * 1.0) / RAND_MAX;
-			rand[i][d][1] = (rand_r(&seed) * 1.0) / RAND_MAX;
-	                randDE[i][d+4]= (rand_r(&seed) * 1.0) / RAND_MAX;
-		}		
-        }
+        //JMB the random numbers for each particle are calculated from its own stream
+        key = rand_r(&seed);
 
         for (i = 0; i < size; i++) {
 //      handle.logMessage(LOGDEBUG, "In parallel",omp_get_thread_num(),"\n");
             ostringstream spos, svel;
             spos << "New position of particle " << i << " [";
             svel << "New velocity of particle " << i << " [";
-	    p1= (int) randDE[i][0];
-	    p2= (int) randDE[i][1];
-	    p3= (int) randDE[i][2];
-	    p4= (int) randDE[i][3];
+            RandomStream rs(key, i);
+            p1 = rs.Integer(size);
+            do
+                p2 = rs.Integer(size);
+            while (p2 == p1);
+            do
+                p3 = rs.Integer(size);
+            while ((p3 == p1) || (p3 == p2));
+            do
+                p4 = rs.Integer(size);
+            while ((p4 == p3) || (p4 == p2) || (p4 == p1));
 
 		for (d = 0; d < nvars; d++) {
-	                prob = randDE[i][d+4];
+	                prob = rs.Uniform();
 			if (prob < CR ) {
                                 if (STATE == 2)
                                         pos_new[i][d] = bestx[d]    + F *  ( pos[p1][d] - pos[p2][d] ) + F *  ( pos[p3][d] - pos[p4][d] );
@@ -409,15 +380,6 @@ void OptInfoDE::OptimiseLikelihood() {
 	steps++;
     } // while (newf < bestf)
     
-    for (i = 0; i < size; i++) {
-		for ( d = 0; d < nvars; d ++ ) {
-			cfree(rand[i][d]);
-		}
-		cfree(rand[i]);
-		cfree(randDE[i]);
-    }
-    cfree(rand);
-    cfree(randDE);
 	
     iters=0;
     for (d = 0; d < numThr; d++) 
@@ -463,10 +425,10 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
     double timestop;
     size= (int) (nvars);
     
-    DoubleMatrix pos(size, nvars, 0.0);    // position matrix
-    DoubleMatrix vel(size, nvars, 0.0);    // velocity matrix
-    DoubleMatrix pos_new(size, nvars, 0.0);  // new population
-    DoubleMatrix pos_b(size, nvars, 0.0);  // best position matrix
+    PopulationMatrix pos(size, nvars, 0.0);    // position matrix
+    PopulationMatrix vel(size, nvars, 0.0);    // velocity matrix
+    PopulationMatrix pos_new(size, nvars, 0.0);  // new population
+    PopulationMatrix pos_b(size, nvars, 0.0);  // best position matrix
     DoubleVector fit(size); // particle fitness vector
     DoubleVector fit_b(size); // best fitness vector
     IntMatrix comm(size, size, 0); // communications:who informs who rows : those who inform cols : those who are informed
@@ -476,6 +438,7 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
     double prob;
     double dist;
     double a, b;
+    unsigned key; // key for the random numbers used in each iteration
     int steps = 0; //!= iters?
     ostringstream spos, svel;
     iter_without_improv_global_best=0;
@@ -523,7 +486,7 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
             }
      }
 
-    best.bestf = EcoSystems[0]->SimulateAndUpdate(x);
+    best.bestf = EvaluationEngine::Evaluate(x);
     best.index = 0;
 
     if (best.bestf != best.bestf) { //check for NaN
@@ -534,7 +497,7 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
     }
 
 
-    offset = EcoSystems[0]->getFuncEval(); //number of function evaluations done before loop
+    offset = EvaluationEngine::numEvaluations(); //number of function evaluations done before loop
     iters = 0;
 
 // Initialize the particles
@@ -550,7 +513,7 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
         b = lowerb[d] + (upperb[d] - lowerb[d]) * (rand_r(&seed) * 1.0 / RAND_MAX);
         vel[i][d] = (a - b) / 2.;
     }
-    fit[i] = EcoSystems[0]->SimulateAndUpdate(pos[i]);
+    fit[i] = EvaluationEngine::Evaluate(pos[i]);
     
 
     fit_b[i] = fit[i]; // this is also the personal best
@@ -561,38 +524,20 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
     }
 
 
-    // REPO
-    double ***rand;
-    rand = (double ***) calloc(size,sizeof(double **));
-    for (i = 0; i < size; i++) {
-	rand[i] = (double **) calloc(nvars,sizeof(double *)); 
-        for (d = 0; d < nvars; d++) rand[i][d] = (double *) calloc(2,sizeof(double));
-    }
-	
-    double **randDE;
-    randDE = (double **) calloc(size,sizeof(double *));
-    for (i=0; i< size; i++)
-	randDE[i] = (double *) calloc(nvars+4,sizeof(double));
-
-    for (i = 1; i < size; i++) {
-	for (d = 0; d < nvars; d++) {
-		rand[i][d][0] = rand_r(&seed);
-                rand[i][d][1] = rand_r(&seed);
-	}
-    }
-
-    // REPO
+    //JMB the random numbers for each particle are calculated from its own stream
+    key = rand_r(&seed);
 
 #pragma omp parallel for default(shared) private(i,d,a,b) schedule(dynamic,1)
     for (i = 1; i < size; i++) {
         ostringstream spos, svel;
         spos << "Initial position of particle " << i << " [";
         svel << "Initial velocity of particle " << i << " [";
+        RandomStream rs(key, i);
         // for each dimension
         for (d = 0; d < nvars; d++) {
             // generate two numbers within the specified range and around trialx
-            a = lowerb[d] + (upperb[d] - lowerb[d]) * (rand[i][d][0] * 1.0 / RAND_MAX);
-            b = lowerb[d] + (upperb[d] - lowerb[d]) * (rand[i][d][1] * 1.0 / RAND_MAX);
+            a = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
+            b = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
 
             // initialize position
             pos[i][d] = a;
@@ -603,8 +548,8 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
             spos << pos[i][d] << " ";
             svel << vel[i][d] << " ";
         }
-        fit[i] = EcoSystems[omp_get_thread_num ()]->SimulateAndUpdate(pos[i]);
      }
+     EvaluationEngine::Evaluate(pos, fit, 1, size);
 
      for (i = 1; i < size; i++) {
         fit_b[i] = fit[i]; // this is also the personal best
@@ -623,13 +568,35 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
 // RUN ALGORITHM
     steps = 0;
 
+    //JMB the steady state search updates the population as soon as each trial has been evaluated
+    if ((steadystate) && (EcoSystem->runDistributed()))
+        handle.logMessage(LOGWARN, "Warning in DE - steady state search not available with distributed function evaluations");
+    else if (steadystate) {
+        this->steadyState(pos, vel, pos_new, pos_b, fit, fit_b, bestx, best.bestf, best.index, lowerb, upperb, init, steps, offset);
+        return;
+    }
+
     while (1) {
+        //JMB store or restore the state of the optimisation at the start of each iteration
+        if (OptCheckpoint::Start(OPTDE)) {
+          this->transferState();
+          OptCheckpoint::Transfer(pos);
+          OptCheckpoint::Transfer(vel);
+          OptCheckpoint::Transfer(pos_new);
+          OptCheckpoint::Transfer(pos_b);
+          OptCheckpoint::Transfer(fit);
+          OptCheckpoint::Transfer(fit_b);
+          OptCheckpoint::Transfer(bestx);
+          OptCheckpoint::Transfer(best.bestf);
+          OptCheckpoint::Transfer(best.index);
+          OptCheckpoint::Transfer(steps);
+          OptCheckpoint::Transfer(offset);
+          OptCheckpoint::Finish();
+        }
+
 //        handle.logMessage(LOGINFO, "PSO optimisation after", psosteps * size, "\n");
         if (isZero(best.bestf)) {
-            iters=0;
-            for (d = 0; d < numThr; d++)
-                 iters = iters + (EcoSystems[d]->getFuncEval());
-            iters= iters - offset;
+            iters = EvaluationEngine::numEvaluations() - offset;
 
             handle.logMessage(LOGINFO, "Error in DE optimisation after", iters, "function evaluations, f(x) = 0");
             converge = -1;
@@ -637,17 +604,14 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
         }
         /* if too many function evaluations occur, terminate the algorithm */
         if (steps > iter) {
-            iters=0;
-            for (d = 0; d < numThr; d++)
-                 iters = iters + (EcoSystems[d]->getFuncEval());
-	    iters= iters - offset;
+            iters = EvaluationEngine::numEvaluations() - offset;
 
             handle.logMessage(LOGINFO, "\nStopping DE optimisation algorithm\n");
             handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
             handle.logMessage(LOGINFO, "The optimisation stopped because the maximum number of PSO steps was reached");
             handle.logMessage(LOGINFO, "was reached and NOT because an optimum was found for this run");
 
-            score = EcoSystems[0]->SimulateAndUpdate(bestx);
+            score = EvaluationEngine::Evaluate(bestx);
             for (i = 0; i < nvars; i++)
                 bestx[i] = bestx[i] * init[i];
             handle.logMessage(LOGINFO, "\nPSO finished with a likelihood score of", score);
@@ -659,7 +623,7 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
         if (best.bestf <= goal) {
             handle.logMessage(LOGINFO, "\nStopping DE optimisation algorithm\n");
             handle.logMessage(LOGINFO, "Goal achieved!!! @ step ", steps);
-            score = EcoSystems[0]->SimulateAndUpdate(bestx);
+            score = EvaluationEngine::Evaluate(bestx);
             handle.logMessage(LOGINFO, "\nPSO finished with a likelihood score of", score);
             break;
         }
@@ -678,24 +642,6 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
            		vel.AddRows(growth_popul, nvars, 0.0);
            		fit.resize(growth_popul, 0.0);
            		fit_b.resize(growth_popul, 0.0);
-			if (growth_popul < 0 ) {
-           			for (i = size; i < size+growth_popul; i++) {
-           			    for (d = 0; d < nvars; d++) cfree(rand[i][d]);
-               			    cfree(rand[i]);
-				    cfree(randDE[i]);
-           			}
-           			rand   = (double ***) realloc(rand,(size+growth_popul)*sizeof(double));
-				randDE = (double **)  realloc(randDE, (size+growth_popul)*sizeof(double));
-			} else {
-	                	rand = (double ***) realloc(rand,(size+growth_popul)*sizeof(double));
-                                randDE = (double **)  realloc(randDE, (size+growth_popul)*sizeof(double));
-	                	for (i = size; i < size+growth_popul; i++) {
-	                	      rand[i]   = (double **) calloc(nvars,sizeof(double *));
-				      randDE[i] = (double *)  calloc(nvars+4 ,sizeof(double));
-	                	      for (d = 0; d < nvars; d++) rand[i][d] = (double *) calloc(2,sizeof(double));
-	                	}
-			}
-		
 		}
 			
 		if (nrestarts == 1 ) {
@@ -704,53 +650,30 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
 		else if (nrestarts == 0 ) {
 			init_reset=size;
 		}
-	
-           	for (i = init_reset; i < (size+growth_popul); i++) {
-                	for (d = 0; d < nvars; d++) {
-                       		rand[i][d][0] = (rand_r(&seed) * 1.0) / RAND_MAX;
-                       		rand[i][d][1] = (rand_r(&seed) * 1.0) / RAND_MAX;
-                	}
-           	}
+		key = rand_r(&seed);
 
 #pragma omp parallel for default(shared) private(i,d,a,b) schedule(dynamic,1)	   
            	for (i=init_reset;i<(size+growth_popul);i++){
+	             RandomStream rs(key, i);
 	             for (d = 0; d < nvars; d++) {
-                        	a = lowerb[d] + (upperb[d] - lowerb[d]) * rand[i][d][0];
-                        	b = lowerb[d] + (upperb[d] - lowerb[d]) * rand[i][d][1];
+                        	a = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
+                        	b = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
 	                	pos[i][d]   = a ;
 	                	pos_b[i][d] = a ;
 	                	vel[i][d]   = (a - b) / 2.;
 	             }
-                     fit[i]   = EcoSystems[omp_get_thread_num()]->SimulateAndUpdate(pos[i]);
-                     fit_b[i] = fit[i];
 	   	}
+	   	EvaluationEngine::Evaluate(pos, fit, init_reset, size+growth_popul);
+	   	for (i=init_reset;i<(size+growth_popul);i++)
+	   	     fit_b[i] = fit[i];
            	size=size+growth_popul;
            	growth_popul=0;
 		STATE=0;
 	}
 	
 
-        for (i = 0; i < size; i++) {
-		p1 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-		do  
-			p2 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-		while (p2 == p1);
-                do 
-                        p3 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-                while ((p3 == p1) || (p3 == p2));
-                do 
-                        p4 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-                while ((p4 == p3) || (p4 == p2) || (p4 == p1));
-		randDE[i][0]= (double) p1;
-                randDE[i][1]= (double) p2;
-                randDE[i][2]= (double) p3;
-                randDE[i][3]= (double) p4;
-		for (d = 0; d < nvars; d++) {
-			rand[i][d][0] = (rand_r(&seed) * 1.0) / RAND_MAX;
-			rand[i][d][1] = (rand_r(&seed) * 1.0) / RAND_MAX;
-	                randDE[i][d+4]= (rand_r(&seed) * 1.0) / RAND_MAX;
-		}		
-        }
+        //JMB the random numbers for each particle are calculated from its own stream
+        key = rand_r(&seed);
 
 #pragma omp parallel for default(shared) private(i,d,p1,p2,p3,p4,prob) schedule(dynamic,1)
         for (i = 0; i < size; i++) {
@@ -758,12 +681,19 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
             ostringstream spos, svel;
             spos << "New position of particle " << i << " [";
             svel << "New velocity of particle " << i << " [";
-	    p1= (int) randDE[i][0];
-	    p2= (int) randDE[i][1];
-	    p3= (int) randDE[i][2];
-	    p4= (int) randDE[i][3];
+            RandomStream rs(key, i);
+            p1 = rs.Integer(size);
+            do
+                p2 = rs.Integer(size);
+            while (p2 == p1);
+            do
+                p3 = rs.Integer(size);
+            while ((p3 == p1) || (p3 == p2));
+            do
+                p4 = rs.Integer(size);
+            while ((p4 == p3) || (p4 == p2) || (p4 == p1));
   	    for (d = 0; d < nvars; d++) {
-	                prob = randDE[i][d+4];
+	                prob = rs.Uniform();
 			if (prob < CR ) {
 				// DE/best/2
 				if (STATE == 2)
@@ -781,9 +711,8 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
 				position_within_bounds(pos_new,vel,lowerb,upperb,i,d);
 			}
 	    }
-	    
-	    fit[i] = EcoSystems[omp_get_thread_num()]->SimulateAndUpdate(pos_new[i]);
         }
+        EvaluationEngine::Evaluate(pos_new, fit, 0, size);
 
 	
 	for (i = 0; i < size; i++) {
@@ -817,11 +746,7 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
 			consecutive_iters_global_best++; 
 			improv_with_stack_global_best=0;
 		}
-                iters=0;
-                for (d = 0; d < numThr; d++){
-                    iters = iters + (EcoSystems[d]->getFuncEval());
-		}
-                iters = iters - offset;
+                iters = EvaluationEngine::numEvaluations() - offset;
                 handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
                 handle.logMessage(LOGINFO, "The likelihood score is", best.bestf, "at the point");
         EcoSystem->writeBestValues();
@@ -833,21 +758,8 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
 	steps++;
     } // while (newf < bestf)
     
-    for (i = 0; i < size; i++) {
-		for ( d = 0; d < nvars; d ++ ) {
-			cfree(rand[i][d]);
-		}
-		cfree(rand[i]);
-		cfree(randDE[i]);
-    }
-    cfree(rand);
-    cfree(randDE);
 	
-    iters=0;
-    for (d = 0; d < numThr; d++) 
-    	iters = iters + (EcoSystems[d]->getFuncEval());
-    
-    iters = iters - offset;
+    iters = EvaluationEngine::numEvaluations() - offset;
     handle.logMessage(LOGINFO, "Existing DE after ", iters, "function evaluations ...");
     for (d = 0; d < nvars; d++)
         bestx[d] = bestx[d] * init[d];
@@ -855,6 +767,287 @@ void OptInfoDE::OptimiseLikelihoodOMP() {
     EcoSystem->writeBestValues();
     
 }
+
+/**
+ *  * \brief steady state version of the parallel DE, where each trial is committed to the
+ *  * population as soon as it has been evaluated and the next trial is then generated
+ *  *
+ *  * The trials are committed in the order that they were generated, and each trial is
+ *  * generated a fixed number of commits before it is committed, so the search will give
+ *  * the same results for the same seed and the same number of threads
+ *   */
+void OptInfoDE::steadyState(PopulationMatrix& pos, PopulationMatrix& vel, PopulationMatrix& pos_new, PopulationMatrix& pos_b,
+    DoubleVector& fit, DoubleVector& fit_b, DoubleVector& bestx, double& bestf, int& bestindex,
+    DoubleVector& lowerb, DoubleVector& upperb, DoubleVector& init, int& steps, int& offset) {
+
+    int i, d, s, p1, p2, p3, p4;
+    double prob, a, b;
+    int numThr = omp_get_max_threads();
+    int queuesize = 2 * numThr;      // number of trials generated before they are committed
+    PopulationMatrix trials(queuesize, nvars, 0.0);
+    IntVector target(queuesize, 0);  // member of the population that each trial is for
+    DoubleVector trialf(queuesize, 0.0);
+    IntVector done(queuesize, 0);
+    int generated = 0;  // number of trials generated since the population was (re)started
+    int next = 0;       // next trial to be evaluated
+    int commit = 0;     // next trial to be committed to the population
+    int ninit = 0;      // number of trials for the new members of a restarted population
+    int init_reset = 0;
+    int epoch = 0;      // used to discard the trials that were evaluated before a restart
+    int boundary = 1;   // start of a new generation
+    int improved = 0;
+    int finished = 0;
+    int stop = 0;
+
+    handle.logMessage(LOGINFO, "Starting steady state DE with", queuesize, "trials in the queue");
+
+#pragma omp parallel private(i, d, s, p1, p2, p3, p4, prob, a, b)
+  {
+    int j = -1, e = 0, quit = 0;
+    double f = 0.0;
+    DoubleVector v(nvars, 0.0);
+    while (1) {
+#pragma omp critical (desteady)
+      {
+        if ((j != -1) && (e == epoch) && (!finished)) {
+          trialf[j % queuesize] = f;
+          done[j % queuesize] = 1;
+        }
+        j = -1;
+
+        while (!finished) {
+          if (boundary) {
+            boundary = 0;
+            //JMB store or restore the state of the optimisation at the start of each generation
+            if (OptCheckpoint::Start(OPTDE)) {
+              this->transferState();
+              OptCheckpoint::Transfer(pos);
+              OptCheckpoint::Transfer(vel);
+              OptCheckpoint::Transfer(pos_new);
+              OptCheckpoint::Transfer(pos_b);
+              OptCheckpoint::Transfer(fit);
+              OptCheckpoint::Transfer(fit_b);
+              OptCheckpoint::Transfer(bestx);
+              OptCheckpoint::Transfer(bestf);
+              OptCheckpoint::Transfer(bestindex);
+              OptCheckpoint::Transfer(steps);
+              OptCheckpoint::Transfer(offset);
+              OptCheckpoint::Transfer(trials);
+              OptCheckpoint::Transfer(target);
+              OptCheckpoint::Transfer(generated);
+              OptCheckpoint::Transfer(commit);
+              OptCheckpoint::Transfer(ninit);
+              OptCheckpoint::Transfer(init_reset);
+              if (OptCheckpoint::isRestoring()) {
+                //JMB the trials in the queue will be evaluated again
+                queuesize = trials.Nrow();
+                trialf = DoubleVector(queuesize, 0.0);
+                done = IntVector(queuesize, 0);
+                next = commit;
+              }
+              OptCheckpoint::Finish();
+            }
+
+            if (isZero(bestf)) {
+              stop = -1;
+              finished = 1;
+              break;
+            }
+            if (steps > iter) {
+              stop = 1;
+              finished = 1;
+              break;
+            }
+            F = calc_adapt_parameters(steps);
+            if (bestf <= goal) {
+              finished = 1;
+              break;
+            }
+            improved = 0;
+
+            // If state var is equal to 3, the algorithm restart its population
+            if (STATE == 3) {
+              iter_without_improv_global_best = 0;
+              improv_with_stack_global_best = 0;
+              init_reset = 0;
+              if (growth_popul != 0) {
+                pos.AddRows(growth_popul, nvars, 0.0);
+                pos_new.AddRows(growth_popul, nvars, 0.0);
+                pos_b.AddRows(growth_popul, nvars, 0.0);
+                vel.AddRows(growth_popul, nvars, 0.0);
+                fit.resize(growth_popul, 0.0);
+                fit_b.resize(growth_popul, 0.0);
+              }
+              if (nrestarts == 1)
+                init_reset = 0;
+              else if (nrestarts == 0)
+                init_reset = size;
+
+              for (i = init_reset; i < (size + growth_popul); i++) {
+                for (d = 0; d < nvars; d++) {
+                  a = lowerb[d] + (upperb[d] - lowerb[d]) * ((rand_r(&seed) * 1.0) / RAND_MAX);
+                  b = lowerb[d] + (upperb[d] - lowerb[d]) * ((rand_r(&seed) * 1.0) / RAND_MAX);
+                  pos[i][d] = a;
+                  pos_b[i][d] = a;
+                  vel[i][d] = (a - b) / 2.;
+                }
+              }
+              ninit = (size + growth_popul > init_reset ? size + growth_popul - init_reset : 0);
+              size = size + growth_popul;
+              growth_popul = 0;
+              STATE = 0;
+
+              //JMB the trials in the queue were generated from the old population
+              epoch++;
+              generated = next = commit = 0;
+              for (i = 0; i < done.Size(); i++)
+                done[i] = 0;
+            }
+          }
+
+          //JMB keep the queue full, so each trial is generated at the same point in the search
+          while (generated < commit + queuesize) {
+            s = generated % queuesize;
+            if (generated < ninit) {
+              //JMB the new members of the population only need to be evaluated
+              target[s] = init_reset + generated;
+              trials[s] = pos[target[s]];
+            } else {
+              i = (generated - ninit) % size;
+              target[s] = i;
+              p1 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
+              do
+                p2 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
+              while (p2 == p1);
+              do
+                p3 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
+              while ((p3 == p1) || (p3 == p2));
+              do
+                p4 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
+              while ((p4 == p3) || (p4 == p2) || (p4 == p1));
+              for (d = 0; d < nvars; d++) {
+                prob = (rand_r(&seed) * 1.0) / RAND_MAX;
+                if (prob < CR) {
+                  // DE/best/2
+                  if (STATE == 2)
+                    pos_new[i][d] = bestx[d] + F * (pos[p1][d] - pos[p2][d]) + F * (pos[p3][d] - pos[p4][d]);
+                  // DE/current-to-rand/1
+                  if (STATE == 0)
+                    pos_new[i][d] = pos[i][d] + F * (pos[p1][d] - pos[i][d]) + F * (pos[p2][d] - pos[p3][d]);
+                  // DE/rand-to-best/1
+                  if (STATE == 4)
+                    pos_new[i][d] = pos[p3][d] + F * (bestx[d] - pos[p3][d]) + F * (pos[p1][d] - pos[p2][d]);
+                  // DE/current-to-best/1/bin
+                  if ((STATE == 1) || (STATE == 3))
+                    pos_new[i][d] = pos[i][d] + F * (bestx[d] - pos[i][d]) + F * (pos[p1][d] - pos[p2][d]);
+                  position_within_bounds(pos_new, vel, lowerb, upperb, i, d);
+                }
+              }
+              trials[s] = pos_new[i];
+            }
+            generated++;
+          }
+
+          s = commit % queuesize;
+          if (!done[s])
+            break;
+
+          //JMB commit the next trial to the population
+          done[s] = 0;
+          i = target[s];
+          fit[i] = trialf[s];
+          if (commit < ninit) {
+            fit_b[i] = fit[i];
+          } else {
+            if (fit[i] < fit_b[i]) {
+              fit_b[i] = fit[i];
+              pos[i] = trials[s];
+            }
+            if (fit[i] < bestf) {
+              improved = 1;
+              bestindex = i;
+              bestf = fit[i];
+              for (d = 0; d < nvars; d++)
+                bestx[d] = trials[s][d] * init[d];
+              EcoSystem->storeVariables(bestf, bestx);
+              bestx = trials[s];
+            }
+          }
+          commit++;
+
+          if ((commit > ninit) && (((commit - ninit) % size) == 0)) {
+            //JMB this is the end of a generation of the population
+            if (improved == 1) {
+              iter_without_improv_global_best = 0;
+              if (((( previous_fbest_fitness - bestf ) / previous_fbest_fitness)*100 <= threshold_acept ) &&
+                  (previous_fbest_fitness != DBL_MAX)) {
+                improv_with_stack_global_best++;
+                consecutive_iters_global_best = 0;
+              } else {
+                consecutive_iters_global_best++;
+                improv_with_stack_global_best = 0;
+              }
+              iters = EvaluationEngine::numEvaluations() - offset;
+              handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
+              handle.logMessage(LOGINFO, "The likelihood score is", bestf, "at the point");
+              EcoSystem->writeBestValues();
+              previous_fbest_fitness = bestf;
+            } else {
+              iter_without_improv_global_best++;
+              consecutive_iters_global_best = 0;
+            }
+            steps++;
+            boundary = 1;
+          }
+        }
+
+        if ((!finished) && (next < generated)) {
+          j = next;
+          e = epoch;
+          v = trials[j % queuesize];
+          next++;
+        }
+        quit = finished;
+      }
+
+      if (j != -1)
+        f = EvaluationEngine::Evaluate(v);
+      else if (quit)
+        break;
+    }
+  }
+
+    iters = EvaluationEngine::numEvaluations() - offset;
+
+    if (stop == -1) {
+        handle.logMessage(LOGINFO, "Error in DE optimisation after", iters, "function evaluations, f(x) = 0");
+        converge = -1;
+        return;
+    }
+
+    handle.logMessage(LOGINFO, "\nStopping DE optimisation algorithm\n");
+    if (stop == 1) {
+        handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+        handle.logMessage(LOGINFO, "The optimisation stopped because the maximum number of DE steps was reached");
+        handle.logMessage(LOGINFO, "was reached and NOT because an optimum was found for this run");
+
+        score = EvaluationEngine::Evaluate(bestx);
+        for (i = 0; i < nvars; i++)
+            bestx[i] = bestx[i] * init[i];
+        handle.logMessage(LOGINFO, "\nDE finished with a likelihood score of", score);
+        EcoSystem->storeVariables(score, bestx);
+        return;
+    }
+
+    handle.logMessage(LOGINFO, "Goal achieved!!! @ step ", steps);
+    score = EvaluationEngine::Evaluate(bestx);
+    handle.logMessage(LOGINFO, "\nDE finished with a likelihood score of", score);
+    handle.logMessage(LOGINFO, "Existing DE after ", iters, "function evaluations ...");
+    for (d = 0; d < nvars; d++)
+        bestx[d] = bestx[d] * init[d];
+    EcoSystem->storeVariables(bestf, bestx);
+    EcoSystem->writeBestValues();
+}
 #endif
 
 void OptInfoDE::growth_trend_manager() {
@@ -995,3 +1188,22 @@ void OptInfoDE::position_within_bounds(DoubleMatrix& pos, DoubleMatrix& vel, Dou
                     }
 }
 
+
+/**
+ *  * \brief store or restore the state of the search in the checkpoint file
+ *   */
+void OptInfoDE::transferState() {
+    OptCheckpoint::Transfer(seed);
+    OptCheckpoint::Transfer(F);
+    OptCheckpoint::Transfer(CR);
+    OptCheckpoint::Transfer(previous_fbest_fitness);
+    OptCheckpoint::Transfer(iter_without_improv_global_best);
+    OptCheckpoint::Transfer(improv_with_stack_global_best);
+    OptCheckpoint::Transfer(consecutive_iters_global_best);
+    OptCheckpoint::Transfer(STATE);
+    OptCheckpoint::Transfer(nrestarts);
+    OptCheckpoint::Transfer(growth_trend);
+    OptCheckpoint::Transfer(growth_popul);
+    OptCheckpoint::Transfer(growth_trend_popul);
+    OptCheckpoint::Transfer(size);
+}
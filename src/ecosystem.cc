@@ -1,5 +1,8 @@
 #include "ecosystem.h"
 #include "runid.h"
+#include "modelfile.h"
+#include "evaluationcache.h"
+#include "evaluationengine.h"
 #include "global.h"
 #include <ctime>
 #include <string>
@@ -14,6 +17,10 @@
 extern Ecosystem** EcoSystems;
 //extern StochasticData* data;
 #endif
+#ifdef GADGET_MPI
+#include "mpicommunication.h"
+extern MPICommunication* MPIComm;
+#endif
 extern volatile int interrupted_print;
 
 time_t starttime, stoptime;
@@ -24,13 +31,14 @@ Ecosystem::Ecosystem(const MainInfo& main) : printinfo(main.getPI()) {
   //interrupted = 0;
   likelihood = 0.0;
   keeper = new Keeper;
+  planner = new AggregationPlanner;
 
   // initialise counter used when printing output files
   printcount = printinfo.getPrintIteration() - 1;
 
   // read the model specification from the main file
   char* filename = main.getMainGadgetFile();
-  ifstream infile;
+  ModelFile infile;
   infile.open(filename, ios::in);
   CommentStream commin(infile);
   handle.checkIfFailure(infile, filename);
@@ -59,10 +67,66 @@ Ecosystem::Ecosystem(const MainInfo& main) : printinfo(main.getPI()) {
       optvec.resize(new OptInfoHooke());
     }
   }
+  //JMB the simulation can only be restarted part way through if the state
+  //of the model at the checkpoints can be stored and restored
+  checkpointvalid = 0;
+  //JMB the evaluation cache is only used when optimising
+  evalcache = (main.runOptimise() && main.getEvalCache());
+  cachehit = 0;
+  multistart = (main.runOptimise() ? main.getMultiStart() : 0);
+  multistarttol = main.getMultiStartTolerance();
+  if (multistart == 1)
+    multistart = 0;
+  simcheckpoint = main.getSimCheckpoint();
+  if (simcheckpoint > 0) {
+    int i, year;
+    if (tagvec.Size() > 0) {
+      handle.logMessage(LOGWARN, "Warning - cannot store checkpoints during the simulation for models with tagging experiments");
+      simcheckpoint = 0;
+    }
+    for (i = 0; i < likevec.Size(); i++) {
+      if ((simcheckpoint > 0) && (!likevec[i]->canRestart())) {
+        handle.logMessage(LOGWARN, "Warning - cannot store checkpoints during the simulation with likelihood component", likevec[i]->getName());
+        simcheckpoint = 0;
+      }
+    }
+
+    if (simcheckpoint > 0) {
+      for (year = TimeInfo->getFirstYear() + simcheckpoint; year <= TimeInfo->getLastYear(); year += simcheckpoint)
+        if (TimeInfo->calcSteps(year, 1) <= TimeInfo->numTotalSteps())
+          checkpointtime.resize(1, TimeInfo->calcSteps(year, 1));
+      firstuse.resize(keeper->numVariables(), 1);
+      keeper->getFirstUse(firstuse);
+      handle.logMessage(LOGMESSAGE, "Storing checkpoints during the simulation, number of checkpoints", checkpointtime.Size());
+    }
+  }
+
 #ifdef _OPENMP
   runParallel=main.runParallel();
 
+  //JMB tagging experiments are moved between the stocks on all areas at once
+  //and the quota fleets share the calculated quota between the areas
+  runAreaParallel = main.runAreaParallel();
+  if ((Area->numAreas() < 2) || (tagvec.Size() > 0))
+    runAreaParallel = 0;
+  if (runAreaParallel) {
+    int i;
+    for (i = 0; i < fleetvec.Size(); i++)
+      if (fleetvec[i]->getType() == QUOTAFLEET)
+        runAreaParallel = 0;
+  }
+  runLikeParallel = main.runLikeParallel();
+
   if (!omp_in_parallel()){
+    if (main.runAreaParallel()) {
+      if (runAreaParallel)
+        handle.logMessage(LOGINFO, "Updating the areas in parallel during each simulation with", omp_get_max_threads(), "threads");
+      else
+        handle.logMessage(LOGWARN, "Warning - cannot update the areas in parallel for models with only one area, with tagging experiments or with quota fleets");
+    }
+    if (runLikeParallel)
+      handle.logMessage(LOGINFO, "Calculating the likelihood components in parallel during each simulation with", omp_get_max_threads(), "threads");
+
   	if (main.runOptimise())
 	{
     		switch(runParallel){
@@ -97,6 +161,7 @@ Ecosystem::~Ecosystem() {
     delete printvec[i];
   for (i = 0; i < likevec.Size(); i++)
     delete likevec[i];
+  delete planner;
   for (i = 0; i < tagvec.Size(); i++)
     delete tagvec[i];
   for (i = 0; i < basevec.Size(); i++)
@@ -133,6 +198,7 @@ void Ecosystem::writeStatus(const char* filename) const {
 
 void Ecosystem::Reset() {
   int i;
+  checkpointvalid = 0;
   TimeInfo->Reset();
   for (i = 0; i < likevec.Size(); i++)
     likevec[i]->Reset(keeper);
@@ -141,8 +207,33 @@ void Ecosystem::Reset() {
 }
 
 void Ecosystem::Optimise() {
-  int i;
-  for (i = 0; i < optvec.Size(); i++) {
+  int i, j, k, numstart, run = 0;
+  numstart = max(multistart, 1);
+  IntVector opt(keeper->numVariables(), 0);
+  DoubleVector val(keeper->numVariables(), 0.0);
+  keeper->getOptFlags(opt);
+  if (multistart) {
+    handle.logMessage(LOGINFO, "\nOptimising the likelihood score from", multistart, "starting points");
+    this->drawStartingPoints();
+  }
+
+  for (k = 0; k < numstart; k++) {
+    for (i = 0; i < optvec.Size(); i++) {
+	  //JMB skip the optimisation algorithms that had finished before the checkpoint was stored
+	  if (!OptCheckpoint::startOptimisation(k * optvec.Size() + i))
+		  continue;
+	  //JMB skip the optimisation algorithms for a starting point that has been stopped early
+	  if ((multistart) && (startstop[k]))
+		  continue;
+	  if ((multistart) && (i == 0)) {
+	    handle.logMessage(LOGINFO, "\nStarting the optimisation from starting point", k + 1);
+	    handle.logMessage(LOGINFO, startval[k]);
+	    keeper->getCurrentValues(val);
+	    this->setOptValues(startval[k], val, opt);
+	    keeper->Update(val);
+	    keeper->storeVariables(0.0, startval[k]);
+	  }
+	  run = 1;
 	  time(&starttime);
 #ifdef _OPENMP
           if (runParallel){
@@ -174,33 +265,186 @@ void Ecosystem::Optimise() {
 #endif
 	  time(&stoptime);
     this->writeOptValues();
+
+    if (multistart) {
+      //JMB stop the optimisation from this starting point if the score is worse than the
+      //best score found from the earlier starting points after the same algorithm
+      double score, best = 0.0;
+      int found = 0;
+      score = keeper->getBestLikelihoodScore();
+      if (isZero(score))
+        score = this->getLikelihood();
+      keeper->getOptBestValues(startbestval[k]);
+      startscore[k][i] = score;
+      startdone[k] = i + 1;
+      for (j = 0; j < k; j++) {
+        if ((startdone[j] > i) && ((!found) || (startscore[j][i] < best))) {
+          best = startscore[j][i];
+          found = 1;
+        }
+      }
+      if ((found) && (i < optvec.Size() - 1) && (score > best + multistarttol * fabs(best))) {
+        handle.logMessage(LOGINFO, "\nStopping the optimisation from starting point", k + 1);
+        handle.logMessage(LOGINFO, "The likelihood score is worse than the best score found after this algorithm", best);
+        startstop[k] = 1;
+      }
+    }
+    }
   }
+  OptCheckpoint::startOptimisation(numstart * optvec.Size());
+
+  if (multistart) {
+    //JMB the final values of the parameters are the best point found from all the starting points
+    double best = 0.0;
+    int bestk = -1;
+    for (k = 0; k < numstart; k++) {
+      i = startdone[k] - 1;
+      if ((i >= 0) && ((bestk < 0) || (startscore[k][i] < best))) {
+        best = startscore[k][i];
+        bestk = k;
+      }
+    }
+    if (bestk >= 0) {
+      handle.logMessage(LOGINFO, "\nThe best point was found from starting point", bestk + 1);
+      handle.logMessage(LOGINFO, "The overall likelihood score is", best);
+      keeper->getCurrentValues(val);
+      this->setOptValues(startbestval[bestk], val, opt);
+      keeper->Update(val);
+      keeper->storeVariables(best, startbestval[bestk]);
+    }
+  }
+
+  if (evalcache) {
+    handle.logMessage(LOGINFO, "\nNumber of points found in the evaluation cache", EvaluationCache::numFound());
+    handle.logMessage(LOGINFO, "Number of points stored in the evaluation cache", EvaluationCache::numPoints());
+  }
+  //JMB the last score was found in the cache, or every optimisation algorithm had finished
+  //before the checkpoint was stored, or the best point was found from an earlier starting
+  //point, so the modelled population needs to be calculated for the final values of the parameters
+  if ((cachehit) || (!run) || (multistart))
+    this->Simulate(0);
 }
 
-double Ecosystem::SimulateAndUpdate(const DoubleVector& x) {
+void Ecosystem::setOptValues(const DoubleVector& x, DoubleVector& val, const IntVector& opt) const {
+  int i, j = 0;
+  for (i = 0; i < val.Size(); i++) {
+    if (opt[i]) {
+      val[i] = x[j];
+      j++;
+    }
+  }
+}
+
+void Ecosystem::drawStartingPoints() {
+  int i, j, p, tmp, nopt;
+  nopt = keeper->numOptVariables();
+  DoubleVector lower(nopt, 0.0), upper(nopt, 0.0);
+  DoubleVector val(keeper->numVariables(), 0.0);
+  IntVector opt(keeper->numVariables(), 0);
+  IntVector order(multistart - 1, 0);
+  keeper->getCurrentValues(val);
+  keeper->getOptFlags(opt);
+  keeper->getOptLowerBounds(lower);
+  keeper->getOptUpperBounds(upper);
+
+  startval.Reset();
+  startbestval.Reset();
+  startscore.Reset();
+  startval.AddRows(multistart, nopt, 0.0);
+  startbestval.AddRows(multistart, nopt, 0.0);
+  startscore.AddRows(multistart, optvec.Size(), 0.0);
+  startdone.Reset();
+  startdone.resize(multistart, 0);
+  startstop.Reset();
+  startstop.resize(multistart, 0);
+
+  //JMB the first starting point is the point given in the input file
+  j = 0;
+  for (i = 0; i < val.Size(); i++) {
+    if (opt[i]) {
+      startval[0][j] = val[i];
+      j++;
+    }
+  }
+
+  //JMB each of the other starting points is in a different part of the range of each parameter,
+  //and the random numbers are counted so a restarted optimisation will use the same points
+  for (j = 0; j < nopt; j++) {
+    for (i = 0; i < order.Size(); i++)
+      order[i] = i;
+    for (i = order.Size() - 1; i > 0; i--) {
+      p = OptCheckpoint::randomInteger() % (i + 1);
+      tmp = order[i];
+      order[i] = order[p];
+      order[p] = tmp;
+    }
+    for (i = 0; i < order.Size(); i++)
+      startval[i + 1][j] = lower[j] + (upper[j] - lower[j]) *
+        (order[i] + (OptCheckpoint::randomInteger() / (RAND_MAX + 1.0))) / order.Size();
+  }
+}
+
+void Ecosystem::getUpdatedValues(const DoubleVector& x, DoubleVector& val) {
   int i, j;
 
-  if (funceval == 0) {
+  if (optflag.Size() != keeper->numVariables()) {
     // JMB - only need to create these vectors once
     initialval.resize(keeper->numVariables(), 0.0);
-    currentval.resize(keeper->numVariables(), 0.0);
     optflag.resize(keeper->numVariables(), 0);
     keeper->getOptFlags(optflag);
-    
   }
 
   j = 0;
-  keeper->getCurrentValues(currentval);
+  keeper->getCurrentValues(val);
   keeper->getInitialValues(initialval);
-  for (i = 0; i < currentval.Size(); i++) {
+  for (i = 0; i < val.Size(); i++) {
     if (optflag[i]) {
-      currentval[i] = x[j] * initialval[i];
+      val[i] = x[j] * initialval[i];
       j++;
     }
   }
+}
 
+double Ecosystem::SimulateAndUpdate(const DoubleVector& x) {
+  int i;
+  if (currentval.Size() != keeper->numVariables())
+    currentval.resize(keeper->numVariables(), 0.0);
+
+  this->getUpdatedValues(x, currentval);
   keeper->Update(currentval);
-  this->Simulate(0);  //dont print whilst optimising
+
+  cachehit = 0;
+  if (evalcache) {
+    if (cachescore.Size() != likevec.Size() + currentval.Size()) {
+      cachescore.resize(likevec.Size() + currentval.Size() - cachescore.Size(), 0.0);
+      cachevalues.resize(currentval.Size() - cachevalues.Size(), 0.0);
+    }
+    cachehit = EvaluationCache::Find(currentval, cachescore);
+  }
+
+  if (cachehit) {
+    //JMB the likelihood score is calculated in the same order as in Simulate
+    likelihood = 0.0;
+    for (i = 0; i < likevec.Size(); i++) {
+      likevec[i]->setUnweightedLikelihood(cachescore[i]);
+      likelihood += likevec[i]->getLikelihood();
+    }
+    //JMB the boundlikelihood component may have moved parameters back within the bounds
+    for (i = 0; i < currentval.Size(); i++)
+      cachevalues[i] = cachescore[likevec.Size() + i];
+    keeper->Update(cachevalues);
+
+  } else {
+    this->Simulate(0);  //dont print whilst optimising
+    if (evalcache) {
+      keeper->getCurrentValues(cachevalues);
+      for (i = 0; i < likevec.Size(); i++)
+        cachescore[i] = likevec[i]->getUnweightedLikelihood();
+      for (i = 0; i < currentval.Size(); i++)
+        cachescore[likevec.Size() + i] = cachevalues[i];
+      EvaluationCache::Store(currentval, cachescore);
+    }
+  }
 
   if (printinfo.getPrint()) {
     printcount++;
@@ -214,21 +458,23 @@ double Ecosystem::SimulateAndUpdate(const DoubleVector& x) {
   return likelihood;
 }
 
+#ifdef _OPENMP
+int Ecosystem::runDistributed() const {
+#ifdef GADGET_MPI
+  return ((MPIComm != 0) && (MPIComm->numSlaves() > 0));
+#else
+  return 0;
+#endif
+}
+#endif
+
 void Ecosystem::writeOptValues() {
   int i;
   DoubleVector tmpvec(likevec.Size(), 0.0);
   for (i = 0; i < likevec.Size(); i++)
     tmpvec[i] = likevec[i]->getUnweightedLikelihood();
 
-  int iters = 0;
-#ifdef _OPENMP
-  if (runParallel){
-  	int numThr = omp_get_max_threads ( );
-    	for (i = 0; i < numThr; i++)
-  	  iters += EcoSystems[i]->getFuncEval();
-  }
-#endif
-  handle.logMessage(LOGINFO, "\nAfter a total of", funceval+iters, "function evaluations the best point found is");
+  handle.logMessage(LOGINFO, "\nAfter a total of", EvaluationEngine::numEvaluations(), "function evaluations the best point found is");
   keeper->writeBestValues();
   handle.logMessage(LOGINFO, "\nThe scores from each likelihood component are");
   handle.logMessage(LOGINFO, tmpvec);
@@ -245,10 +491,95 @@ void Ecosystem::writeInitialInformation(const char* const filename) {
   keeper->writeInitialInformation(likevec);
 }
 
+void Ecosystem::openEvalCache(const char* filename, unsigned long sum) {
+  EvaluationCache::openFile(filename, sum, keeper->numVariables(), likevec.Size());
+}
+
+void Ecosystem::openOptCheckpoint(const char* outfilename, int interval, const char* infilename, unsigned long sum) {
+  if (infilename != NULL)
+    OptCheckpoint::readFile(infilename, sum, keeper->numVariables(), max(multistart, 1) * optvec.Size());
+  if (outfilename != NULL)
+    OptCheckpoint::setFile(outfilename, interval, sum, keeper->numVariables(), max(multistart, 1) * optvec.Size());
+}
+
+void Ecosystem::transferCheckpoint() {
+  int i;
+  double bestlikelihood = keeper->getBestLikelihoodScore();
+  DoubleVector val(keeper->numVariables(), 0.0);
+  DoubleVector bestval(keeper->numOptVariables(), 0.0);
+  IntVector evals;
+  DoubleMatrix threadval, threadinit;
+  keeper->getCurrentValues(val);
+  keeper->getOptBestValues(bestval);
+#ifdef _OPENMP
+  int numThr = omp_get_max_threads();
+  if (runParallel) {
+    evals.resize(numThr, 0);
+    threadval.AddRows(numThr, keeper->numVariables(), 0.0);
+    threadinit.AddRows(numThr, keeper->numVariables(), 0.0);
+    for (i = 0; i < numThr; i++) {
+      evals[i] = EcoSystems[i]->funceval;
+      EcoSystems[i]->keeper->getCurrentValues(threadval[i]);
+      EcoSystems[i]->keeper->getInitialValues(threadinit[i]);
+    }
+  }
+#endif
+
+  OptCheckpoint::Transfer(funceval);
+  OptCheckpoint::Transfer(evals);
+  OptCheckpoint::Transfer(threadval);
+  OptCheckpoint::Transfer(threadinit);
+  OptCheckpoint::Transfer(val);
+  OptCheckpoint::Transfer(bestval);
+  OptCheckpoint::Transfer(bestlikelihood);
+  for (i = 0; i < optvec.Size(); i++)
+    optvec[i]->transferResults();
+  if (multistart) {
+    OptCheckpoint::Transfer(startval);
+    OptCheckpoint::Transfer(startbestval);
+    OptCheckpoint::Transfer(startscore);
+    OptCheckpoint::Transfer(startdone);
+    OptCheckpoint::Transfer(startstop);
+  }
+
+  if (OptCheckpoint::isRestoring()) {
+    keeper->Update(val);
+    keeper->storeVariables(bestlikelihood, bestval);
+#ifdef _OPENMP
+    //JMB the number of function evaluations is only used for the output
+    //so the optimisation can be restarted with a different number of threads
+    if (runParallel) {
+      for (i = 0; i < numThr; i++)
+        EcoSystems[i]->funceval = (evals.Size() == numThr ? evals[i] : 0);
+      if (evals.Size() != numThr)
+        for (i = 0; i < evals.Size(); i++)
+          EcoSystems[0]->funceval += evals[i];
+
+      //JMB the copies of the model keep their own scaling of the variables
+      //between optimisation algorithms, so this needs to be restored too
+      if (threadval.Nrow() == numThr) {
+        for (i = 0; i < numThr; i++) {
+          EcoSystems[i]->keeper->setInitialValues(threadinit[i]);
+          EcoSystems[i]->keeper->Update(threadval[i]);
+        }
+      } else
+        for (i = 0; i < numThr; i++)
+          EcoSystems[i]->keeper->Update(val);
+    }
+#endif
+  }
+}
+
 void Ecosystem::writeValues() {
   keeper->writeValues(likevec, printinfo.getPrecision());
 }
 
+#ifdef _OPENMP
+void Ecosystem::writeValues(Ecosystem* eco) {
+  keeper->writeValues(eco->getValues(), eco->likevec, eco->getLikelihood(), printinfo.getPrecision());
+}
+#endif
+
 void Ecosystem::writeParams(const char* const filename, int prec) const {
   if ((funceval > 0) && (interrupted_print == 0)) {
     //JMB - print the final values to any output files specified
@@ -258,3 +589,51 @@ void Ecosystem::writeParams(const char* const filename, int prec) const {
   }
   keeper->writeParams(optvec, filename, prec, interrupted_print);
 }
+
+void Ecosystem::writeMultiStart(const char* const filename, int prec) const {
+  if (!multistart)
+    return;
+
+  int i, j, k, p, w;
+  ofstream outfile;
+  outfile.open(filename, ios::out);
+  handle.checkIfFailure(outfile, filename);
+  handle.Open(filename);
+
+  p = prec;
+  if (prec == 0)
+    p = largeprecision;
+  w = p + 4;
+
+  ParameterVector sw(keeper->numVariables());
+  IntVector opt(keeper->numVariables(), 0);
+  keeper->getSwitches(sw);
+  keeper->getOptFlags(opt);
+
+  outfile << "; ";
+  RUNID.Print(outfile);
+  outfile << "; the results of the optimisation from " << multistart << " starting points\n"
+    << "; the starting point, the number of optimisation algorithms that finished for this starting point,\n"
+    << "; the best likelihood score found and the best values of the optimised parameters found\n"
+    << "start\talgorithms\tscore";
+  for (i = 0; i < sw.Size(); i++)
+    if (opt[i])
+      outfile << TAB << sw[i].getName();
+  outfile << endl;
+
+  for (k = 0; k < multistart; k++) {
+    outfile << k + 1 << TAB << startdone[k] << TAB << TAB << setw(w) << setprecision(p);
+    if (startdone[k] > 0)
+      outfile << startscore[k][startdone[k] - 1];
+    else
+      outfile << 0.0;
+    for (j = 0; j < startbestval.Ncol(k); j++)
+      outfile << TAB << setw(w) << setprecision(p) << startbestval[k][j];
+    if (startstop[k])
+      outfile << " ; stopped early";
+    outfile << endl;
+  }
+  handle.Close();
+  outfile.close();
+  outfile.clear();
+}
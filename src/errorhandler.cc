@@ -69,16 +69,20 @@ void ErrorHandler::setLogFile(const char* filename) {
 
 void ErrorHandler::Open(const char* filename) {
   this->logMessage(LOGMESSAGE, "Opening file", filename);
+#pragma omp critical (files)
   files->storeString(filename);
 }
 
 void ErrorHandler::Close() {
-  if (loglevel >= LOGMESSAGE) {
-    char* strFilename = files->sendTop();
-    this->logMessage(LOGMESSAGE, "Closing file", strFilename);
-    delete[] strFilename;
+#pragma omp critical (files)
+  {
+    if (loglevel >= LOGMESSAGE) {
+      char* strFilename = files->sendTop();
+      this->logMessage(LOGMESSAGE, "Closing file", strFilename);
+      delete[] strFilename;
+    }
+    files->clearString();
   }
-  files->clearString();
 }
 
 void ErrorHandler::logMessage(LogLevel mlevel, const char* msg) {
@@ -0,0 +1,132 @@
+#include "evaluationcache.h"
+#include "errorhandler.h"
+#include "global.h"
+#include <cfloat>
+
+map<vector<double>, vector<double> > EvaluationCache::cache;
+ofstream EvaluationCache::outfile;
+int EvaluationCache::numfound = 0;
+
+int EvaluationCache::Find(const DoubleVector& val, DoubleVector& score) {
+  int i, found = 0;
+  vector<double> key(val.Size());
+  for (i = 0; i < val.Size(); i++)
+    key[i] = val[i];
+
+  map<vector<double>, vector<double> >::const_iterator it;
+#pragma omp critical (evalcache)
+  {
+    it = cache.find(key);
+    if (it != cache.end()) {
+      for (i = 0; i < score.Size(); i++)
+        score[i] = it->second[i];
+      numfound++;
+      found = 1;
+    }
+  }
+  return found;
+}
+
+void EvaluationCache::Store(const DoubleVector& val, const DoubleVector& score) {
+  int i, finite = 1;
+  vector<double> key(val.Size());
+  vector<double> entry(score.Size());
+  for (i = 0; i < val.Size(); i++)
+    key[i] = val[i];
+  for (i = 0; i < score.Size(); i++) {
+    entry[i] = score[i];
+    //JMB infinite or NaN scores cannot be read back from the cache file
+    if ((score[i] != score[i]) || (score[i] > DBL_MAX) || (score[i] < -DBL_MAX))
+      finite = 0;
+  }
+
+#pragma omp critical (evalcache)
+  {
+    if (cache.insert(make_pair(key, entry)).second && finite && outfile.is_open())
+      writePoint(key, entry);
+  }
+}
+
+void EvaluationCache::writePoint(const vector<double>& key, const vector<double>& entry) {
+  unsigned int i;
+  //JMB 17 significant digits are needed to read back exactly the same values
+  outfile << setprecision(17);
+  for (i = 0; i < key.size(); i++)
+    outfile << key[i] << sep;
+  outfile << TAB;
+  for (i = 0; i < entry.size(); i++)
+    outfile << sep << entry[i];
+  outfile << endl;
+}
+
+void EvaluationCache::openFile(const char* filename, unsigned long sum, int numvar, int numlike) {
+  int i, count, newfile, rewrite;
+  unsigned long filesum;
+  int filevar, filelike;
+  char text[MaxStrLength];
+  strncpy(text, "", MaxStrLength);
+  vector<double> key(numvar);
+  vector<double> entry(numlike + numvar);
+
+  ifstream infile;
+  infile.open(filename, ios::in);
+  count = 0;
+  newfile = 1;
+  rewrite = 0;
+  if ((!infile.fail()) && (infile.peek() != EOF)) {
+    newfile = 0;
+    handle.Open(filename);
+    infile >> text >> filesum >> filevar >> filelike >> ws;
+    if ((infile.fail()) || (strcasecmp(text, "evaluationcache") != 0))
+      handle.logFileMessage(LOGFAIL, "failed to read the evaluation cache header");
+    if ((filesum != sum) || (filevar != numvar) || (filelike != numlike))
+      handle.logFileMessage(LOGFAIL, "the evaluation cache was created from a different model");
+
+    while (!infile.eof()) {
+      for (i = 0; i < numvar; i++)
+        infile >> key[i];
+      for (i = 0; i < numlike + numvar; i++)
+        infile >> entry[i];
+      if (infile.fail()) {
+        //JMB the last line may be incomplete if the previous run was stopped
+        handle.logMessage(LOGWARN, "Warning in evaluationcache - failed to read the last point from the cache file");
+        rewrite = 1;
+        break;
+      }
+      infile >> ws;
+      cache.insert(make_pair(key, entry));
+      count++;
+    }
+    handle.Close();
+    handle.logMessage(LOGMESSAGE, "Read evaluation cache file - number of points", count);
+  }
+
+  infile.close();
+  infile.clear();
+  if (rewrite)
+    outfile.open(filename, ios::out);
+  else
+    outfile.open(filename, ios::app);
+  handle.checkIfFailure(outfile, filename);
+  if (newfile || rewrite) {
+    //JMB this is a new cache file, so write the header information
+    outfile << "evaluationcache" << sep << sum << sep << numvar << sep << numlike << endl;
+    map<vector<double>, vector<double> >::const_iterator it;
+    for (it = cache.begin(); it != cache.end(); it++)
+      writePoint(it->first, it->second);
+  }
+}
+
+void EvaluationCache::closeFile() {
+  if (outfile.is_open()) {
+    outfile.close();
+    outfile.clear();
+  }
+}
+
+int EvaluationCache::numPoints() {
+  int num;
+#pragma omp critical (evalcache)
+  num = cache.size();
+  return num;
+}
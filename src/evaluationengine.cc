@@ -0,0 +1,223 @@
+#include "evaluationengine.h"
+#include "ecosystem.h"
+#include "errorhandler.h"
+#include "global.h"
+#include <map>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef GADGET_MPI
+#include "mpicommunication.h"
+extern MPICommunication* MPIComm;
+#endif
+
+extern Ecosystem* EcoSystem;
+
+Ecosystem** EvaluationEngine::replicas = 0;
+int EvaluationEngine::numreplicas = 0;
+#ifdef _OPENMP
+omp_lock_t* EvaluationEngine::locks = 0;
+#else
+IntVector EvaluationEngine::busy;
+#endif
+int EvaluationEngine::usecache = 0;
+DoubleMatrix EvaluationEngine::pending;
+DoubleVector EvaluationEngine::results;
+int EvaluationEngine::numdone = 0;
+int EvaluationEngine::numwaiting = 0;
+
+void EvaluationEngine::setReplicas(Ecosystem** eco, int num) {
+#ifdef _OPENMP
+  int i;
+  if (locks != 0) {
+    for (i = 0; i < numreplicas; i++)
+      omp_destroy_lock(&locks[i]);
+    delete[] locks;
+    locks = 0;
+  }
+  if (num > 0) {
+    locks = new omp_lock_t[num];
+    for (i = 0; i < num; i++)
+      omp_init_lock(&locks[i]);
+  }
+#else
+  busy.Reset();
+  busy.resize(num, 0);
+#endif
+  replicas = eco;
+  numreplicas = num;
+}
+
+int EvaluationEngine::checkOut() {
+  int i;
+#ifdef _OPENMP
+  //JMB try the copy of the model with the same number as the thread first,
+  //since it is the copy that is most likely to be in the cache of this core
+  int first = omp_get_thread_num() % numreplicas;
+  for (i = 0; i < numreplicas; i++)
+    if (omp_test_lock(&locks[(first + i) % numreplicas]))
+      return (first + i) % numreplicas;
+
+  //JMB all the copies are being used, so wait for this copy to be checked in
+  //instead of spinning until one of the copies is free
+  omp_set_lock(&locks[first]);
+  return first;
+#else
+  for (i = 0; i < numreplicas; i++) {
+    if (!busy[i]) {
+      busy[i] = 1;
+      return i;
+    }
+  }
+  handle.logMessage(LOGFAIL, "Error in evaluationengine - no copy of the model is free");
+  return -1;
+#endif
+}
+
+void EvaluationEngine::checkIn(int id) {
+#ifdef _OPENMP
+  omp_unset_lock(&locks[id]);
+#else
+  busy[id] = 0;
+#endif
+}
+
+double EvaluationEngine::Evaluate(const DoubleVector& x) {
+  if (numreplicas == 0)
+    return EcoSystem->SimulateAndUpdate(x);
+
+  double f;
+  int id = checkOut();
+  f = replicas[id]->SimulateAndUpdate(x);
+  checkIn(id);
+  return f;
+}
+
+void EvaluationEngine::Evaluate(const DoubleMatrix& x, DoubleVector& f, int first, int last) {
+  int i, k, num = last - first;
+  if (num <= 0)
+    return;
+
+  //JMB a point that is repeated in the batch is only simulated once when the
+  //evaluation cache is used, since the later copies would be found in the cache
+  IntVector same(num, -1);
+  int numsame = 0;
+  if (usecache) {
+    map<vector<double>, int> index;
+    vector<double> key(x.Ncol(first));
+    for (k = first; k < last; k++) {
+      for (i = 0; i < x.Ncol(k); i++)
+        key[i] = x[k][i];
+      map<vector<double>, int>::iterator it = index.find(key);
+      if (it == index.end())
+        index.insert(make_pair(key, k));
+      else {
+        same[k - first] = it->second;
+        numsame++;
+      }
+    }
+  }
+
+  if (numreplicas == 0) {
+    for (k = first; k < last; k++)
+      if (same[k - first] == -1)
+        f[k] = EcoSystem->SimulateAndUpdate(x[k]);
+    for (k = first; k < last; k++)
+      if (same[k - first] != -1)
+        f[k] = f[same[k - first]];
+    if (numsame > 0)
+      EcoSystem->countFuncEval(numsame);
+    return;
+  }
+
+#ifdef GADGET_MPI
+  if (EcoSystem->runDistributed()) {
+    //JMB the slaves are sent the values of all the model parameters, which
+    //are calculated (and counted) by the copies of the model on this process
+    DoubleMatrix val(num, replicas[0]->numVariables(), 0.0);
+    DoubleVector tmpf(num, 0.0);
+    for (k = 0; k < num; k++) {
+      replicas[k % numreplicas]->getUpdatedValues(x[first + k], val[k]);
+      replicas[k % numreplicas]->countFuncEval(1);
+    }
+    MPIComm->Evaluate(val, tmpf);
+    for (k = 0; k < num; k++)
+      f[first + k] = tmpf[k];
+    return;
+  }
+#endif
+
+  //JMB only the points that are not repeated are shared between the threads,
+  //so that each thread gets an equal share of the model runs
+  int id, numrun = num - numsame;
+  IntVector run(numrun, 0);
+  i = 0;
+  for (k = first; k < last; k++)
+    if (same[k - first] == -1)
+      run[i++] = k;
+
+  if (numrun <= numreplicas) {
+#pragma omp parallel for num_threads(numrun) schedule(static, 1) private(id, k)
+    for (i = 0; i < numrun; i++) {
+      k = run[i];
+      id = checkOut();
+      f[k] = replicas[id]->SimulateAndUpdate(x[k]);
+      checkIn(id);
+    }
+  } else {
+#pragma omp parallel for schedule(dynamic, 1) private(id, k)
+    for (i = 0; i < numrun; i++) {
+      k = run[i];
+      id = checkOut();
+      f[k] = replicas[id]->SimulateAndUpdate(x[k]);
+      checkIn(id);
+    }
+  }
+
+  for (k = first; k < last; k++)
+    if (same[k - first] != -1)
+      f[k] = f[same[k - first]];
+  if (numsame > 0)
+    replicas[0]->countFuncEval(numsame);
+}
+
+int EvaluationEngine::Submit(const DoubleVector& x) {
+  //JMB start a new list of points once all the earlier scores have been collected
+  if (numwaiting == 0) {
+    pending.Reset();
+    results.Reset();
+    numdone = 0;
+  }
+  pending.AddRows(1, x.Size(), 0.0);
+  pending[pending.Nrow() - 1] = x;
+  results.resize(1, 0.0);
+  numwaiting++;
+  return pending.Nrow() - 1;
+}
+
+int EvaluationEngine::isReady(int ticket) {
+  return ((ticket >= 0) && (ticket < numdone));
+}
+
+void EvaluationEngine::Flush() {
+  Evaluate(pending, results, numdone, pending.Nrow());
+  numdone = pending.Nrow();
+}
+
+double EvaluationEngine::Wait(int ticket) {
+  if ((ticket < 0) || (ticket >= pending.Nrow()))
+    handle.logMessage(LOGFAIL, "Error in evaluationengine - received invalid ticket", ticket);
+  if (!isReady(ticket))
+    Flush();
+  numwaiting--;
+  return results[ticket];
+}
+
+int EvaluationEngine::numEvaluations() {
+  int i, num = EcoSystem->getFuncEval();
+  for (i = 0; i < numreplicas; i++)
+    num += replicas[i]->getFuncEval();
+  return num;
+}
@@ -9,6 +9,7 @@
 #include "readfunc.h"
 #include "readword.h"
 #include "errorhandler.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -19,7 +20,7 @@ Fleet::Fleet(CommentStream& infile, const char* givenname, const AreaClass* cons
   type = ftype;
   char text[MaxStrLength];
   strncpy(text, "", MaxStrLength);
-  ifstream subfile;
+  ModelFile subfile;
   CommentStream subcomment(subfile);
   int tmpint = 0;
   Formula multscaler;
@@ -11,7 +11,8 @@ FleetPreyAggregator::FleetPreyAggregator(const FleetPtrVector& Fleets,
   const StockPtrVector& Stocks, LengthGroupDivision* const Lgrpdiv,
   const IntMatrix& Areas, const IntMatrix& Ages, int overcons)
   : LgrpDiv(Lgrpdiv), areas(Areas), ages(Ages), overconsumption(overcons),
-    doescatch(Fleets.Size(), Stocks.Size(), 0), suitptr(0), alptr(0) {
+    doescatch(Fleets.Size(), Stocks.Size(), 0), suitptr(0), alptr(0),
+    shared(0), summed(0) {
 
   int i, j;
   //JMB its simpler to just store pointers to the predators
@@ -44,6 +45,10 @@ FleetPreyAggregator::~FleetPreyAggregator() {
   int i;
   for (i = 0; i < CI.Size(); i++)
     delete CI[i];
+#ifdef _OPENMP
+  if (shared)
+    omp_destroy_lock(&sumlock);
+#endif
 }
 
 void FleetPreyAggregator::Print(ofstream& outfile) const {
@@ -78,8 +83,33 @@ int FleetPreyAggregator::checkCatchData() {
   return 0;
 }
 
+void FleetPreyAggregator::setShared() {
+#ifdef _OPENMP
+  if (!shared)
+    omp_init_lock(&sumlock);
+#endif
+  shared = 1;
+}
+
 void FleetPreyAggregator::Sum() {
+  //JMB a shared aggregator only needs to be summed once on each timestep, and
+  //the lock stops the likelihood components that are calculated in parallel
+  //from summing it at the same time
+  if (shared) {
+#ifdef _OPENMP
+    omp_set_lock(&sumlock);
+#endif
+    if (!summed)
+      this->calcSum();
+    summed = 1;
+#ifdef _OPENMP
+    omp_unset_lock(&sumlock);
+#endif
+  } else
+    this->calcSum();
+}
 
+void FleetPreyAggregator::calcSum() {
   int f, g, h, i, j, k, r, z;
   int predl = 0;  //JMB there is only ever one length group ...
   double ratio;
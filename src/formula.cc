@@ -465,6 +465,24 @@ void Formula::Inform(Keeper* keeper) {
   }
 }
 
+void Formula::setFirstUse(Keeper* keeper, int time) const {
+  switch (type) {
+    case CONSTANT:
+      break;
+    case PARAMETER:
+      keeper->setFirstUse(value, time);
+      break;
+    case FUNCTION:
+      unsigned int i;
+      for (i = 0; i < argList.size(); i++)
+        (*argList[i]).setFirstUse(keeper, time);
+      break;
+    default:
+      handle.logMessage(LOGFAIL, "Error in formula - unrecognised type", type);
+      break;
+  }
+}
+
 void Formula::Interchange(Formula& newF, Keeper* keeper) const {
   while (newF.argList.size() > 0)
     newF.argList.pop_back();
@@ -5,22 +5,57 @@
 #include "errorhandler.h"
 #include "stochasticdata.h"
 #include "interrupthandler.h"
+#include "modelfile.h"
+#include "evaluationcache.h"
+#include "evaluationengine.h"
 #include "global.h"
 #ifdef _OPENMP
 #include <omp.h>
 #endif
+#ifdef GADGET_MPI
+#include "mpicommunication.h"
+#endif
 
 Ecosystem* EcoSystem;
 StochasticData* data = 0;
 Ecosystem** EcoSystems;
 MainInfo _main;
+#ifdef GADGET_MPI
+MPICommunication* MPIComm = 0;
+#endif
 
 volatile int interrupted = 0;
 volatile int interrupted_print = 0;
 
+#ifdef _OPENMP
+//create the copies of the model that are used by each thread
+void createEcosystems() {
+  int i, numThr = omp_get_max_threads();
+  handle.logMessage(LOGINFO, "Info - initialise ", numThr," EcoSystems ");
+  EcoSystems = new Ecosystem*[numThr];
+#pragma omp parallel for shared(EcoSystems,_main,data,handle)
+  for (i = 0; i < numThr; i++) {
+    handle.logMessage(LOGINFO, "Info - Ecosystem ", i);
+    if (_main.getInitialParamGiven()) {
+      EcoSystems[i] = new Ecosystem(_main);
+      EcoSystems[i]->Update(data);
+      EcoSystems[i]->checkBounds();
+    }
+    EcoSystems[i]->Initialise();
+  }
+  EvaluationEngine::setReplicas(EcoSystems, numThr);
+  //the copies have been created from the model image, which is no longer needed
+  ModelFile::clearImage();
+}
+#endif
+
 
 int main(int aNumber, char* const aVector[]) {
   int check = 0;
+#ifdef GADGET_MPI
+  //JMB this needs to be done before anything else is read
+  MPIComm = new MPICommunication();
+#endif
   //Initialise random number generator with system time [MNAA 02.02.26]
   srand((int)time(NULL));
 
@@ -50,10 +85,45 @@ int main(int aNumber, char* const aVector[]) {
 
   _main.read(aNumber, aVector);
   _main.checkUsage(inputdir, workingdir);
+#ifdef GADGET_MPI
+  if (!MPIComm->isMaster()) {
+    //JMB the slaves only calculate the likelihood scores for the master
+    handle.setLogLevel(1);
+    if (!_main.runOptimise()) {
+      delete MPIComm;
+      return EXIT_SUCCESS;
+    }
+  } else if (_main.runOptimise() && (MPIComm->numSlaves() > 0)) {
+    //JMB the master uses one copy of the model for each slave
+    if (!_main.runParallel())
+      _main.setRunParallel(2);
+    omp_set_num_threads(MPIComm->numSlaves());
+  }
+#endif
 
   if (chdir(inputdir) != 0)
     handle.logMessage(LOGFAIL, "Error - failed to change input directory to", inputdir);
   EcoSystem = new Ecosystem(_main);
+  //JMB the evaluation cache file can only be used with the same model files
+  unsigned long modelsum = 0;
+  if (_main.runOptimise() && (_main.getEvalCacheFile() != NULL))
+    modelsum = ModelFile::checksum(_main.getOptInfoFile());
+  //JMB the optimisation checkpoint file can only be used with the same model and optimisation files
+  unsigned long optsum = 0;
+  if (_main.runOptimise() && ((_main.getOptCheckpointFile() != NULL) || (_main.getOptRestartFile() != NULL)))
+    optsum = ModelFile::checksum(NULL);
+#ifdef _OPENMP
+  //JMB the parameter sets from a simulation run can be run in parallel
+  int sweep = (_main.runStochastic() && !(_main.runNetwork()) && _main.getInitialParamGiven() && _main.runParallel());
+  if (sweep && _main.runPrint() && (EcoSystem->numPrinters() > 0)) {
+    handle.logMessage(LOGWARN, "Warning - cannot print the model output when running the parameter sets in parallel");
+    sweep = 0;
+  }
+
+  //the model image is kept to create the copies used by the parallel optimisation
+  if (!((_main.runOptimise() || sweep) && _main.runParallel()))
+#endif
+    ModelFile::clearImage();
 
 #ifdef INTERRUPT_HANDLER
   //JMB dont register interrupt if doing a network run
@@ -63,6 +133,9 @@ int main(int aNumber, char* const aVector[]) {
 
   if (chdir(workingdir) != 0)
     handle.logMessage(LOGFAIL, "Error - failed to change working directory to", workingdir);
+#ifdef GADGET_MPI
+  if (MPIComm->isMaster())
+#endif
   if ((_main.getPI()).getPrint())
     EcoSystem->writeInitialInformation((_main.getPI()).getOutputFile());
 
@@ -100,6 +173,31 @@ int main(int aNumber, char* const aVector[]) {
       if ((_main.getPI()).getPrint())
         EcoSystem->writeValues();
 
+#ifdef _OPENMP
+      if (sweep) {
+        //JMB the next parameter sets are shared out between the copies of the model
+        //and the output is written in the same order as the parameter sets are read
+        int i, num, numThr = omp_get_max_threads();
+        handle.logMessage(LOGINFO, "Simulating the parameter sets in parallel with", numThr, "threads");
+        createEcosystems();
+        while (data->isDataLeft()) {
+          num = 0;
+          while ((num < numThr) && (data->isDataLeft())) {
+            data->readNextLine();
+            EcoSystems[num]->Update(data);
+            num++;
+          }
+
+#pragma omp parallel for num_threads(num) schedule(static, 1)
+          for (i = 0; i < num; i++)
+            EcoSystems[i]->Simulate(0);
+
+          if ((_main.getPI()).getPrint())
+            for (i = 0; i < num; i++)
+              EcoSystem->writeValues(EcoSystems[i]);
+        }
+      } else
+#endif
       while (data->isDataLeft()) {
         data->readNextLine();
         EcoSystem->Update(data);
@@ -142,31 +240,34 @@ int main(int aNumber, char* const aVector[]) {
 		  handle.logMessage(LOGFAIL, "Error - no parameter input file specified");
 
 	  EcoSystem->Initialise();
+#ifdef GADGET_MPI
+	  if (!MPIComm->isMaster()) {
+		  MPIComm->runSlave(EcoSystem);
+		  delete data;
+		  delete EcoSystem;
+		  delete MPIComm;
+		  return EXIT_SUCCESS;
+	  }
+#endif
 	  if (_main.printInitial()) {
 		  EcoSystem->Reset();  //JMB only need to call reset() before the print commands
 		  EcoSystem->writeStatus(_main.getPrintInitialFile());
 	  	  }
+	  if (_main.getEvalCacheFile() != NULL)
+		  EcoSystem->openEvalCache(_main.getEvalCacheFile(), modelsum);
+	  EvaluationEngine::setCache(_main.getEvalCache());
+	  if ((_main.getOptCheckpointFile() != NULL) || (_main.getOptRestartFile() != NULL))
+		  EcoSystem->openOptCheckpoint(_main.getOptCheckpointFile(), _main.getOptCheckpointTime(), _main.getOptRestartFile(), optsum);
 
 #ifdef _OPENMP
-          if (_main.runParallel()){
-	  	int numThr = omp_get_max_threads ( );
-		handle.logMessage(LOGINFO, "Info - initialise ", numThr," EcoSystems ");
-	  	EcoSystems = new Ecosystem*[numThr];
-	  	int i;
-#pragma omp parallel for shared(EcoSystems,_main,data,handle)
-	  	for (i=0; i<numThr; i++)
-	  	{
-		        handle.logMessage(LOGINFO, "Info - Ecosystem ", i);
-	                if (_main.getInitialParamGiven()) {
-		  	    EcoSystems[i] = new Ecosystem(_main);
-		  	    EcoSystems[i]->Update(data);
-		            EcoSystems[i]->checkBounds();
-			}
-		  	EcoSystems[i]->Initialise();
-	  	}
-	  	}
+	  if (_main.runParallel())
+		  createEcosystems();
 #endif
 	  EcoSystem->Optimise();
+	  EvaluationCache::closeFile();
+#ifdef GADGET_MPI
+	  MPIComm->stopSlaves();
+#endif
 	  delete data;
 	  if (_main.getForcePrint())
 		  EcoSystem->Simulate(_main.getForcePrint());
@@ -179,11 +280,16 @@ int main(int aNumber, char* const aVector[]) {
   //JMB print final values of parameters
   if (!(_main.runNetwork()))
     EcoSystem->writeParams((_main.getPI()).getParamOutFile(), (_main.getPI()).getPrecision());
+  if (_main.runOptimise() && !(_main.runNetwork()))
+    EcoSystem->writeMultiStart(_main.getMultiStartFile(), (_main.getPI()).getPrecision());
 
   if (check)
     free(workingdir);
 
   delete EcoSystem;
   handle.logFinish();
+#ifdef GADGET_MPI
+  delete MPIComm;
+#endif
   return EXIT_SUCCESS;
 }
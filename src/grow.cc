@@ -18,26 +18,26 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const Matrix& Wgrowth) {
 	maxlgrp = Lgrowth.Nrow();
 
 	for (i = 0; i < nrow; i++) {
-		int maxCol = v[i]->maxCol();
-		int minCol = v[i]->minCol();
+		int maxCol = v[i].maxCol();
+		int minCol = v[i].minCol();
 		//the part that grows to or above the highest length group
 		num = 0.0;
 		wt = 0.0;
 
 		for (lgrp = maxCol - 1; lgrp >= maxCol - maxlgrp; lgrp--) {
 			for (grow = maxCol - lgrp - 1; grow < maxlgrp; grow++) {
-				tmp = Lgrowth[grow][lgrp] * (*v[i])[lgrp].N;
+				tmp = Lgrowth[grow][lgrp] * v[i][lgrp].N;
 				num += tmp;
-				wt += tmp * (Wgrowth[grow][lgrp] + (*v[i])[lgrp].W);
+				wt += tmp * (Wgrowth[grow][lgrp] + v[i][lgrp].W);
 			}
 		}
 
 		lgrp = maxCol - 1;
 		if (isZero(num) || (wt < verysmall)) {
-			(*v[i])[lgrp].setToZero();
+			v[i][lgrp].setToZero();
 		} else {
-			(*v[i])[lgrp].W = wt / num;
-			(*v[i])[lgrp].N = num;
+			v[i][lgrp].W = wt / num;
+			v[i][lgrp].N = num;
 		}
 
 		//the central diagonal part of the length division
@@ -45,16 +45,16 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const Matrix& Wgrowth) {
 			num = 0.0;
 			wt = 0.0;
 			for (grow = 0; grow < maxlgrp; grow++) {
-				tmp = Lgrowth[grow][lgrp - grow] * (*v[i])[lgrp - grow].N;
+				tmp = Lgrowth[grow][lgrp - grow] * v[i][lgrp - grow].N;
 				num += tmp;
 				wt += tmp
-						* (Wgrowth[grow][lgrp - grow] + (*v[i])[lgrp - grow].W);
+						* (Wgrowth[grow][lgrp - grow] + v[i][lgrp - grow].W);
 			}
 			if (isZero(num) || (wt < verysmall)) {
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 			} else {
-				(*v[i])[lgrp].W = wt / num;
-				(*v[i])[lgrp].N = num;
+				v[i][lgrp].W = wt / num;
+				v[i][lgrp].N = num;
 			}
 		}
 
@@ -63,16 +63,16 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const Matrix& Wgrowth) {
 			num = 0.0;
 			wt = 0.0;
 			for (grow = 0; grow <= lgrp - minCol; grow++) {
-				tmp = Lgrowth[grow][lgrp - grow] * (*v[i])[lgrp - grow].N;
+				tmp = Lgrowth[grow][lgrp - grow] * v[i][lgrp - grow].N;
 				num += tmp;
 				wt += tmp
-						* (Wgrowth[grow][lgrp - grow] + (*v[i])[lgrp - grow].W);
+						* (Wgrowth[grow][lgrp - grow] + v[i][lgrp - grow].W);
 			}
 			if (isZero(num) || (wt < verysmall)) {
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 			} else {
-				(*v[i])[lgrp].W = wt / num;
-				(*v[i])[lgrp].N = num;
+				v[i][lgrp].W = wt / num;
+				v[i][lgrp].N = num;
 			}
 		}
 	}
@@ -89,26 +89,26 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const Matrix& Wgrowth) {
 //	maxlgrp = Lgrowth.Nrow();
 //
 //	for (i = 0; i < nrow; i++) {
-//		int maxCol = v[i]->maxCol();
-//		int minCol = v[i]->minCol();
+//		int maxCol = v[i].maxCol();
+//		int minCol = v[i].minCol();
 //		//the part that grows to or above the highest length group
 //		num = 0.0;
 //		wt = 0.0;
 //
 //		for (lgrp = maxCol - 1; lgrp >= maxCol - maxlgrp; lgrp--) {
 //			for (grow = maxCol - lgrp - 1; grow < maxlgrp; grow++) {
-//				tmp = Lgrowth[grow][lgrp] * (*v[i])[lgrp].N;
+//				tmp = Lgrowth[grow][lgrp] * v[i][lgrp].N;
 //				num += tmp;
-//				wt += tmp * (Wgrowth[grow][lgrp] + (*v[i])[lgrp].W);
+//				wt += tmp * (Wgrowth[grow][lgrp] + v[i][lgrp].W);
 //			}
 //		}
 //
 //		lgrp = maxCol - 1;
 //		if (isZero(num) || (wt < verysmall)) {
-//			(*v[i])[lgrp].setToZero();
+//			v[i][lgrp].setToZero();
 //		} else {
-//			(*v[i])[lgrp].W = wt / num;
-//			(*v[i])[lgrp].N = num;
+//			v[i][lgrp].W = wt / num;
+//			v[i][lgrp].N = num;
 //		}
 //
 //		//the central diagonal part of the length division
@@ -116,17 +116,17 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const Matrix& Wgrowth) {
 //			num = 0.0;
 //			wt = 0.0;
 //			for (grow = 0; grow < maxlgrp; grow++) {
-//				tmp = Lgrowth[grow][lgrp - grow] * (*v[i])[lgrp - grow].N;
+//				tmp = Lgrowth[grow][lgrp - grow] * v[i][lgrp - grow].N;
 //				num += tmp;
 //				wt += tmp
-//						* (Wgrowth[grow][lgrp - grow] + (*v[i])[lgrp - grow].W);
+//						* (Wgrowth[grow][lgrp - grow] + v[i][lgrp - grow].W);
 //			}
 //
 //			if (isZero(num) || (wt < verysmall)) {
-//				(*v[i])[lgrp].setToZero();
+//				v[i][lgrp].setToZero();
 //			} else {
-//				(*v[i])[lgrp].W = wt / num;
-//				(*v[i])[lgrp].N = num;
+//				v[i][lgrp].W = wt / num;
+//				v[i][lgrp].N = num;
 //			}
 //		}
 //
@@ -135,17 +135,17 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const Matrix& Wgrowth) {
 //			num = 0.0;
 //			wt = 0.0;
 //			for (grow = 0; grow <= lgrp - minCol; grow++) {
-//				tmp = Lgrowth[grow][lgrp - grow] * (*v[i])[lgrp - grow].N;
+//				tmp = Lgrowth[grow][lgrp - grow] * v[i][lgrp - grow].N;
 //				num += tmp;
 //				wt += tmp
-//						* (Wgrowth[grow][lgrp - grow] + (*v[i])[lgrp - grow].W);
+//						* (Wgrowth[grow][lgrp - grow] + v[i][lgrp - grow].W);
 //			}
 //
 //			if (isZero(num) || (wt < verysmall)) {
-//				(*v[i])[lgrp].setToZero();
+//				v[i][lgrp].setToZero();
 //			} else {
-//				(*v[i])[lgrp].W = wt / num;
-//				(*v[i])[lgrp].N = num;
+//				v[i][lgrp].W = wt / num;
+//				v[i][lgrp].N = num;
 //			}
 //		}
 //	}
@@ -160,39 +160,39 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const Matrix& Wgrowth,
 
 	maxlgrp = Lgrowth.Nrow();
 	for (i = 0; i < nrow; i++) {
-		int maxCol = v[i]->maxCol();
-		int minCol = v[i]->minCol();
+		int maxCol = v[i].maxCol();
+		int minCol = v[i].minCol();
 		age = i + minage;
 		num = 0.0;
 		wt = 0.0;
 		matnum = 0.0;
 		for (lgrp = maxCol - 1; lgrp >= maxCol - maxlgrp; lgrp--) {
 			for (grow = maxCol - lgrp - 1; grow < maxlgrp; grow++) {
-				ratio = Mat->calcMaturation(age, lgrp, grow, (*v[i])[lgrp].W);
-				tmp = Lgrowth[grow][lgrp] * (*v[i])[lgrp].N;
+				ratio = Mat->calcMaturation(age, lgrp, grow, v[i][lgrp].W);
+				tmp = Lgrowth[grow][lgrp] * v[i][lgrp].N;
 				matnum += (tmp * ratio);
 				num += tmp;
-				wt += tmp * (Wgrowth[grow][lgrp] + (*v[i])[lgrp].W);
+				wt += tmp * (Wgrowth[grow][lgrp] + v[i][lgrp].W);
 			}
 		}
 
 		lgrp = maxCol - 1;
 		if (isZero(num) || (wt < verysmall)) {
 			//no fish grow to this length cell
-			(*v[i])[lgrp].setToZero();
+			v[i][lgrp].setToZero();
 			Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 		} else if (isZero(matnum)) {
 			//none of the fish that grow to this length cell mature
-			(*v[i])[lgrp].W = wt / num;
-			(*v[i])[lgrp].N = num;
+			v[i][lgrp].W = wt / num;
+			v[i][lgrp].N = num;
 			Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 		} else if (isEqual(num, matnum) || (matnum > num)) {
 			//all the fish that grow to this length cell mature
-			(*v[i])[lgrp].setToZero();
+			v[i][lgrp].setToZero();
 			Mat->storeMatureStock(area, age, lgrp, num, wt / num);
 		} else {
-			(*v[i])[lgrp].W = wt / num;
-			(*v[i])[lgrp].N = num - matnum;
+			v[i][lgrp].W = wt / num;
+			v[i][lgrp].N = num - matnum;
 			Mat->storeMatureStock(area, age, lgrp, matnum, wt / num);
 		}
 
@@ -202,30 +202,30 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const Matrix& Wgrowth,
 			matnum = 0.0;
 			for (grow = 0; grow < maxlgrp; grow++) {
 				ratio = Mat->calcMaturation(age, lgrp, grow,
-						(*v[i])[lgrp - grow].W);
-				tmp = Lgrowth[grow][lgrp - grow] * (*v[i])[lgrp - grow].N;
+						v[i][lgrp - grow].W);
+				tmp = Lgrowth[grow][lgrp - grow] * v[i][lgrp - grow].N;
 				matnum += (tmp * ratio);
 				num += tmp;
 				wt += tmp
-						* (Wgrowth[grow][lgrp - grow] + (*v[i])[lgrp - grow].W);
+						* (Wgrowth[grow][lgrp - grow] + v[i][lgrp - grow].W);
 			}
 
 			if (isZero(num) || (wt < verysmall)) {
 				//no fish grow to this length cell
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 				Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 			} else if (isZero(matnum)) {
 				//none of the fish that grow to this length cell mature
-				(*v[i])[lgrp].W = wt / num;
-				(*v[i])[lgrp].N = num;
+				v[i][lgrp].W = wt / num;
+				v[i][lgrp].N = num;
 				Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 			} else if (isEqual(num, matnum) || (matnum > num)) {
 				//all the fish that grow to this length cell mature
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 				Mat->storeMatureStock(area, age, lgrp, num, wt / num);
 			} else {
-				(*v[i])[lgrp].W = wt / num;
-				(*v[i])[lgrp].N = num - matnum;
+				v[i][lgrp].W = wt / num;
+				v[i][lgrp].N = num - matnum;
 				Mat->storeMatureStock(area, age, lgrp, matnum, wt / num);
 			}
 		}
@@ -236,30 +236,30 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const Matrix& Wgrowth,
 			matnum = 0.0;
 			for (grow = 0; grow <= lgrp - minCol; grow++) {
 				ratio = Mat->calcMaturation(age, lgrp, grow,
-						(*v[i])[lgrp - grow].W);
-				tmp = Lgrowth[grow][lgrp - grow] * (*v[i])[lgrp - grow].N;
+						v[i][lgrp - grow].W);
+				tmp = Lgrowth[grow][lgrp - grow] * v[i][lgrp - grow].N;
 				matnum += (tmp * ratio);
 				num += tmp;
 				wt += tmp
-						* (Wgrowth[grow][lgrp - grow] + (*v[i])[lgrp - grow].W);
+						* (Wgrowth[grow][lgrp - grow] + v[i][lgrp - grow].W);
 			}
 
 			if (isZero(num) || (wt < verysmall)) {
 				//no fish grow to this length cell
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 				Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 			} else if (isZero(matnum)) {
 				//none of the fish that grow to this length cell mature
-				(*v[i])[lgrp].W = wt / num;
-				(*v[i])[lgrp].N = num;
+				v[i][lgrp].W = wt / num;
+				v[i][lgrp].N = num;
 				Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 			} else if (isEqual(num, matnum) || (matnum > num)) {
 				//all the fish that grow to this length cell mature
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 				Mat->storeMatureStock(area, age, lgrp, num, wt / num);
 			} else {
-				(*v[i])[lgrp].W = wt / num;
-				(*v[i])[lgrp].N = num - matnum;
+				v[i][lgrp].W = wt / num;
+				v[i][lgrp].N = num - matnum;
 				Mat->storeMatureStock(area, age, lgrp, matnum, wt / num);
 			}
 		}
@@ -274,44 +274,44 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const DoubleVector& Weight) {
 	maxlgrp = Lgrowth.Nrow();
 
 	for (i = 0; i < nrow; i++) {
-		int maxCol = v[i]->maxCol();
-		int minCol = v[i]->minCol();
+		int maxCol = v[i].maxCol();
+		int minCol = v[i].minCol();
 		num = 0.0;
 		for (lgrp = maxCol - 1; lgrp >= maxCol - maxlgrp; lgrp--)
 			for (grow = maxCol - lgrp - 1; grow < maxlgrp; grow++)
-				num += (Lgrowth[grow][lgrp] * (*v[i])[lgrp].N);
+				num += (Lgrowth[grow][lgrp] * v[i][lgrp].N);
 
 		lgrp = maxCol - 1;
 		if (isZero(num)) {
-			(*v[i])[lgrp].setToZero();
+			v[i][lgrp].setToZero();
 		} else {
-			(*v[i])[lgrp].N = num;
-			(*v[i])[lgrp].W = Weight[lgrp];
+			v[i][lgrp].N = num;
+			v[i][lgrp].W = Weight[lgrp];
 		}
 
 		for (lgrp = maxCol - 2; lgrp >= minCol + maxlgrp - 1; lgrp--) {
 			num = 0.0;
 			for (grow = 0; grow < maxlgrp; grow++)
-				num += (Lgrowth[grow][lgrp - grow] * (*v[i])[lgrp - grow].N);
+				num += (Lgrowth[grow][lgrp - grow] * v[i][lgrp - grow].N);
 
 			if (isZero(num)) {
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 			} else {
-				(*v[i])[lgrp].N = num;
-				(*v[i])[lgrp].W = Weight[lgrp];
+				v[i][lgrp].N = num;
+				v[i][lgrp].W = Weight[lgrp];
 			}
 		}
 
 		for (lgrp = minCol + maxlgrp - 2; lgrp >= minCol; lgrp--) {
 			num = 0.0;
 			for (grow = 0; grow <= lgrp - minCol; grow++)
-				num += (Lgrowth[grow][lgrp - grow] * (*v[i])[lgrp - grow].N);
+				num += (Lgrowth[grow][lgrp - grow] * v[i][lgrp - grow].N);
 
 			if (isZero(num)) {
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 			} else {
-				(*v[i])[lgrp].N = num;
-				(*v[i])[lgrp].W = Weight[lgrp];
+				v[i][lgrp].N = num;
+				v[i][lgrp].W = Weight[lgrp];
 			}
 		}
 	}
@@ -328,15 +328,15 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const DoubleVector& Weight,
 	maxlgrp = Lgrowth.Nrow();
 
 	for (i = 0; i < nrow; i++) {
-		int maxCol = v[i]->maxCol();
-		int minCol = v[i]->minCol();
+		int maxCol = v[i].maxCol();
+		int minCol = v[i].minCol();
 		age = i + minage;
 		num = 0.0;
 		matnum = 0.0;
 		for (lgrp = maxCol - 1; lgrp >= maxCol - maxlgrp; lgrp--) {
 			for (grow = maxCol - lgrp - 1; grow < maxlgrp; grow++) {
-				ratio = Mat->calcMaturation(age, lgrp, grow, (*v[i])[lgrp].W);
-				tmp = Lgrowth[grow][lgrp] * (*v[i])[lgrp].N;
+				ratio = Mat->calcMaturation(age, lgrp, grow, v[i][lgrp].W);
+				tmp = Lgrowth[grow][lgrp] * v[i][lgrp].N;
 				matnum += (tmp * ratio);
 				num += tmp;
 			}
@@ -345,20 +345,20 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const DoubleVector& Weight,
 		lgrp = maxCol - 1;
 		if (isZero(num)) {
 			//no fish grow to this length cell
-			(*v[i])[lgrp].setToZero();
+			v[i][lgrp].setToZero();
 			Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 		} else if (isZero(matnum)) {
 			//none of the fish that grow to this length cell mature
-			(*v[i])[lgrp].W = Weight[lgrp];
-			(*v[i])[lgrp].N = num;
+			v[i][lgrp].W = Weight[lgrp];
+			v[i][lgrp].N = num;
 			Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 		} else if (isEqual(num, matnum) || (matnum > num)) {
 			//all the fish that grow to this length cell mature
-			(*v[i])[lgrp].setToZero();
+			v[i][lgrp].setToZero();
 			Mat->storeMatureStock(area, age, lgrp, num, Weight[lgrp]);
 		} else {
-			(*v[i])[lgrp].W = Weight[lgrp];
-			(*v[i])[lgrp].N = num - matnum;
+			v[i][lgrp].W = Weight[lgrp];
+			v[i][lgrp].N = num - matnum;
 			Mat->storeMatureStock(area, age, lgrp, matnum, Weight[lgrp]);
 		}
 
@@ -367,28 +367,28 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const DoubleVector& Weight,
 			matnum = 0.0;
 			for (grow = 0; grow < maxlgrp; grow++) {
 				ratio = Mat->calcMaturation(age, lgrp, grow,
-						(*v[i])[lgrp - grow].W);
-				tmp = Lgrowth[grow][lgrp - grow] * (*v[i])[lgrp - grow].N;
+						v[i][lgrp - grow].W);
+				tmp = Lgrowth[grow][lgrp - grow] * v[i][lgrp - grow].N;
 				matnum += (tmp * ratio);
 				num += tmp;
 			}
 
 			if (isZero(num)) {
 				//no fish grow to this length cell
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 				Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 			} else if (isZero(matnum)) {
 				//none of the fish that grow to this length cell mature
-				(*v[i])[lgrp].W = Weight[lgrp];
-				(*v[i])[lgrp].N = num;
+				v[i][lgrp].W = Weight[lgrp];
+				v[i][lgrp].N = num;
 				Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 			} else if (isEqual(num, matnum) || (matnum > num)) {
 				//all the fish that grow to this length cell mature
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 				Mat->storeMatureStock(area, age, lgrp, num, Weight[lgrp]);
 			} else {
-				(*v[i])[lgrp].W = Weight[lgrp];
-				(*v[i])[lgrp].N = num - matnum;
+				v[i][lgrp].W = Weight[lgrp];
+				v[i][lgrp].N = num - matnum;
 				Mat->storeMatureStock(area, age, lgrp, matnum, Weight[lgrp]);
 			}
 		}
@@ -398,28 +398,28 @@ void AgeBandMatrix::Grow(const Matrix& Lgrowth, const DoubleVector& Weight,
 			matnum = 0.0;
 			for (grow = 0; grow <= lgrp - minCol; grow++) {
 				ratio = Mat->calcMaturation(age, lgrp, grow,
-						(*v[i])[lgrp - grow].W);
-				tmp = Lgrowth[grow][lgrp - grow] * (*v[i])[lgrp - grow].N;
+						v[i][lgrp - grow].W);
+				tmp = Lgrowth[grow][lgrp - grow] * v[i][lgrp - grow].N;
 				matnum += (tmp * ratio);
 				num += tmp;
 			}
 
 			if (isZero(num)) {
 				//no fish grow to this length cell
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 				Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 			} else if (isZero(matnum)) {
 				//none of the fish that grow to this length cell mature
-				(*v[i])[lgrp].W = Weight[lgrp];
-				(*v[i])[lgrp].N = num;
+				v[i][lgrp].W = Weight[lgrp];
+				v[i][lgrp].N = num;
 				Mat->storeMatureStock(area, age, lgrp, 0.0, 0.0);
 			} else if (isEqual(num, matnum) || (matnum > num)) {
 				//all the fish that grow to this length cell mature
-				(*v[i])[lgrp].setToZero();
+				v[i][lgrp].setToZero();
 				Mat->storeMatureStock(area, age, lgrp, num, Weight[lgrp]);
 			} else {
-				(*v[i])[lgrp].W = Weight[lgrp];
-				(*v[i])[lgrp].N = num - matnum;
+				v[i][lgrp].W = Weight[lgrp];
+				v[i][lgrp].N = num - matnum;
 				Mat->storeMatureStock(area, age, lgrp, matnum, Weight[lgrp]);
 			}
 		}
@@ -83,7 +83,6 @@ Grower::Grower(CommentStream& infile, const LengthGroupDivision* const OtherLgrp
 
     part1.resize(maxlengthgroupgrowth + 1, 0.0);
     part2.resize(maxlengthgroupgrowth + 1, 0.0);
-    part4.resize(maxlengthgroupgrowth + 1, 0.0);
 
   } else if (strcasecmp(text, "meanvarianceparameters") == 0) {
     handle.logFileMessage(LOGFAIL, "\nThe mean variance parameters implementation of the growth is no longer supported\nUse the beta-binomial distribution implementation of the growth instead");
@@ -105,6 +104,7 @@ Grower::Grower(CommentStream& infile, const LengthGroupDivision* const OtherLgrp
   interpLengthGrowth.AddRows(noareas, otherlen, 0.0);
   interpWeightGrowth.AddRows(noareas, otherlen, 0.0);
   dummyfphi.resize(len, 0.0);
+  part4.AddRows(noareas, maxlengthgroupgrowth + 1, 0.0);
   lgrowth = new Matrix[noareas];
   wgrowth = new Matrix[noareas];
   for (i = 0; i < noareas; i++) {
@@ -261,7 +261,8 @@ void Grower::Reset() {
       part2[i] = part2[i + 1] * (beta + tmpmax - i - 1);
 
   //JMB this will never change so we can set it once
-  part4[0] = 1.0;
+  for (area = 0; area < areas.Size(); area++)
+    part4[area][0] = 1.0;
 
   if (handle.getLogLevel() >= LOGMESSAGE)
     handle.logMessage(LOGMESSAGE, "Reset grower data for stock", this->getName());
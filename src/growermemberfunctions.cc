@@ -9,7 +9,7 @@ void Grower::implementGrowth(int area, const PopInfoVector& NumberInArea,
   const LengthGroupDivision* const Lengths) {
 
   int lgroup, j, inarea = this->areaNum(area);
-  double meanw, tmppart3, tmpweight;
+  double meanw, tmppart3, tmpweight, growth, alpha, part3;
   double tmpMult = growthcalc->getMult();
   double tmpPower = growthcalc->getPower();
   double tmpDl = 1.0 / Lengths->dl();  //JMB no need to check zero here
@@ -29,6 +29,7 @@ void Grower::implementGrowth(int area, const PopInfoVector& NumberInArea,
         case 8:
         case 10:
         case 11:
+#pragma omp critical (growerpow)
         	if (vector_OK == 0)
         	{
         		meanlength_vectorPow = Lengths->meanlengthvecPow_initilize(maxlengthgroupgrowth,tmpPower);
@@ -52,13 +53,13 @@ void Grower::implementGrowth(int area, const PopInfoVector& NumberInArea,
       part3 *= (alpha + beta + double(j));
 
     tmppart3 = 1.0 / part3;
-    part4[1] = alpha;
+    part4[inarea][1] = alpha;
     if (maxlengthgroupgrowth > 1)
       for (j = 2; j <= maxlengthgroupgrowth; j++)
-        part4[j] = part4[j - 1] * (j - 1 + alpha);
+        part4[inarea][j] = part4[inarea][j - 1] * (j - 1 + alpha);
 
     for (j = 0; j <= maxlengthgroupgrowth; j++)
-    	(*lgrowth)[j][lgroup] = part1[j] * part2[j] * tmppart3 * part4[j];
+    	(lgrowth[inarea])[j][lgroup] = part1[j] * part2[j] * tmppart3 * part4[inarea][j];
 
     switch (functionnumber) {
       case 1:
@@ -72,15 +73,15 @@ void Grower::implementGrowth(int area, const PopInfoVector& NumberInArea,
         meanw = 0.0;
         tmpweight = (NumberInArea[lgroup].W * tmpPower * Lengths->dl()) / Lengths->meanLength(lgroup);
         for (j = 0; j <= maxlengthgroupgrowth; j++) {
-        	(*wgrowth)[j][lgroup] = tmpweight * j;
-          meanw += (*wgrowth)[j][lgroup] * (*lgrowth)[j][lgroup];
+        	(wgrowth[inarea])[j][lgroup] = tmpweight * j;
+          meanw += (wgrowth[inarea])[j][lgroup] * (lgrowth[inarea])[j][lgroup];
         }
 
         tmpweight = interpWeightGrowth[inarea][lgroup] - meanw;
         for (j = 0; j <= maxlengthgroupgrowth; j++)
         {
-        	aux = (*wgrowth)[j][lgroup];
-        	(*wgrowth)[j][lgroup] =  aux + tmpweight;
+        	aux = (wgrowth[inarea])[j][lgroup];
+        	(wgrowth[inarea])[j][lgroup] =  aux + tmpweight;
         }
         break;
       case 8:
@@ -89,7 +90,7 @@ void Grower::implementGrowth(int area, const PopInfoVector& NumberInArea,
     	pow_L = meanlength_vectorPow[lgroup];
         if (lgroup != numLenGr) //FIXME for (lgroup = 0; ¿¿¿lgroup < numLenGr????; lgroup++)
           for (j = 1; j <= maxlengthgroupgrowth; j++)
-        	  (*wgrowth)[j][lgroup] = tmpMult * (meanlength_vectorPow[lgroup + j] - pow_L);
+        	  (wgrowth[inarea])[j][lgroup] = tmpMult * (meanlength_vectorPow[lgroup + j] - pow_L);
         break;
       default:
         handle.logMessage(LOGFAIL, "Error in grower - unrecognised growth function", functionnumber);
@@ -102,7 +103,7 @@ void Grower::implementGrowth(int area, const PopInfoVector& NumberInArea,
 void Grower::implementGrowth(int area, const LengthGroupDivision* const Lengths) {
 
   int lgroup, j, inarea = this->areaNum(area);
-  double tmppart3;
+  double tmppart3, growth, alpha, part3;
   double tmpDl = 1.0 / Lengths->dl();  //JMB no need to check zero here
 
   for (lgroup = 0; lgroup < Lengths->numLengthGroups(); lgroup++) {
@@ -117,12 +118,12 @@ void Grower::implementGrowth(int area, const LengthGroupDivision* const Lengths)
       part3 *= (alpha + beta + double(j));
 
     tmppart3 = 1.0 / part3;
-    part4[1] = alpha;
+    part4[inarea][1] = alpha;
     if (maxlengthgroupgrowth > 1)
       for (j = 2; j <= maxlengthgroupgrowth; j++)
-        part4[j] = part4[j - 1] * (j - 1 + alpha);
+        part4[inarea][j] = part4[inarea][j - 1] * (j - 1 + alpha);
 
     for (j = 0; j <= maxlengthgroupgrowth; j++)
-      (lgrowth[inarea])[j][lgroup] = part1[j] * part2[j] * tmppart3 * part4[j];
+      (lgrowth[inarea])[j][lgroup] = part1[j] * part2[j] * tmppart3 * part4[inarea][j];
   }
 }
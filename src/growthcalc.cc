@@ -4,6 +4,7 @@
 #include "keeper.h"
 #include "readfunc.h"
 #include "readword.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -66,7 +67,7 @@ GrowthCalcB::GrowthCalcB(CommentStream& infile, const IntVector& Areas,
 
   char datafilename[MaxStrLength];
   strncpy(datafilename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   int i;
@@ -153,7 +154,7 @@ GrowthCalcC::GrowthCalcC(CommentStream& infile, const IntVector& Areas,
 
   //read information on reference weights.
   keeper->addString("referenceweights");
-  ifstream subfile;
+  ModelFile subfile;
   subfile.open(refWeightFile, ios::in);
   handle.checkIfFailure(subfile, refWeightFile);
   handle.Open(refWeightFile);
@@ -269,7 +270,7 @@ GrowthCalcD::GrowthCalcD(CommentStream& infile, const IntVector& Areas,
 
   //read information on reference weights.
   keeper->addString("referenceweights");
-  ifstream subfile;
+  ModelFile subfile;
   subfile.open(refWeightFile, ios::in);
   handle.checkIfFailure(subfile, refWeightFile);
   handle.Open(refWeightFile);
@@ -413,7 +414,7 @@ GrowthCalcE::GrowthCalcE(CommentStream& infile, const IntVector& Areas,
 
   //read information on reference weights.
   keeper->addString("referenceweights");
-  ifstream subfile;
+  ModelFile subfile;
   subfile.open(refWeightFile, ios::in);
   handle.checkIfFailure(subfile, refWeightFile);
   handle.Open(refWeightFile);
@@ -532,7 +533,7 @@ GrowthCalcF::GrowthCalcF(CommentStream& infile, const IntVector& Areas,
   for (i = 0; i < Areas.Size(); i++)
     wgrowth.resize(new FormulaMatrix(TimeInfo->numTotalSteps() + 1, lenindex.Size(), 0.0));
 
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
   readWordAndValue(infile, "weightgrowthfile", text);
   datafile.open(text, ios::in);
@@ -596,7 +597,7 @@ GrowthCalcG::GrowthCalcG(CommentStream& infile, const IntVector& Areas,
   for (i = 0; i < Areas.Size(); i++)
     wgrowth.resize(new FormulaMatrix(TimeInfo->numTotalSteps() + 1, lenindex.Size(), 0.0));
 
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
   readWordAndValue(infile, "weightgrowthfile", text);
   datafile.open(text, ios::in);
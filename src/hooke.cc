@@ -137,6 +137,7 @@
 #include "intvector.h"
 #include "errorhandler.h"
 #include "ecosystem.h"
+#include "evaluationengine.h"
 #include "global.h"
 
 #ifdef _OPENMP
@@ -177,92 +178,245 @@ double OptInfoHooke::bestNearby(DoubleVector& delta, DoubleVector& point, double
   return minf;
 }
 
+/* the pattern move is evaluated as a line search at 1, 2 and 4 times the step, */
+/* and the best of these points is accepted.  Any spare places in the batch are */
+/* used for the first +delta/-delta probes around the point reached by the 1    */
+/* times step, which are discarded unless that point is the one accepted        */
+double OptInfoHooke::patternLineSearch(DoubleVector& point, const DoubleVector& step, const DoubleVector& lowerb,
+  const DoubleVector& upperb, const DoubleVector& delta, const IntVector& param, int numprobes) {
+
+  int i, j, k, best;
+  int nvars = point.Size();
+  numprobes = max(0, min(numprobes, 2 * nvars));
+  DoubleMatrix v(3 + numprobes, nvars, 0.0);
+  DoubleVector f(3 + numprobes, 0.0);
+
+  v[0] = point;
+  for (i = 0; i < nvars; i++) {
+    v[1][i] = max(lowerb[i], min(upperb[i], point[i] + step[i]));
+    v[2][i] = max(lowerb[i], min(upperb[i], point[i] + 3.0 * step[i]));
+  }
+  for (j = 0; j < numprobes; j++) {
+    k = param[j / 2];
+    v[3 + j] = point;
+    if ((j % 2) == 0)
+      v[3 + j][k] += delta[k];
+    else
+      v[3 + j][k] -= delta[k];
+  }
+
+  EvaluationEngine::Evaluate(v, f, 0, 3 + numprobes);
+  iters += 2;
+
+  best = 0;
+  for (i = 1; i < 3; i++)
+    if (f[i] < f[best])
+      best = i;
+
+  if ((best == 0) && (numprobes > 0))
+    this->storeProbes(v, f, 3, 3 + numprobes);
+  point = v[best];
+  return f[best];
+}
+
+void OptInfoHooke::storeProbes(const DoubleMatrix& v, const DoubleVector& f, int first, int last) {
+  int i;
+  probes.Reset();
+  probef.Reset();
+  if (last <= first)
+    return;
+
+  probes.AddRows(last - first, v.Ncol(first), 0.0);
+  probef.resize(last - first, 0.0);
+  for (i = first; i < last; i++) {
+    probes[i - first] = v[i];
+    probef[i - first] = f[i];
+  }
+}
+
+int OptInfoHooke::findProbe(const DoubleVector& point, double& f) {
+  int i, j, found;
+  for (i = 0; i < probes.Nrow(); i++) {
+    found = 1;
+    for (j = 0; (j < point.Size()) && found; j++)
+      if (probes[i][j] != point[j])
+        found = 0;
+    if (found) {
+      f = probef[i];
+      return 1;
+    }
+  }
+  return 0;
+}
+
 /* given a point, look for a better one nearby, one coord at a time */
 #ifdef _OPENMP
 /*
- * function bestBeraby parallelized with OpenMP
- * · 2 threads per coord to parallelize the calculation of +delta/-delta
- * · parallelize the calculation of the best nearby of the coord
+ * function bestNearby parallelized with OpenMP
+ * · the +delta/-delta probes for each coord are kept in a shared queue
+ * · each thread takes the next probe from the queue as soon as it is free
+ * · the results are committed in the same order as the serial version, and
+ *   the probes that were based on the old point are discarded after a move
  */
 double OptInfoHooke::bestNearbyRepro(DoubleVector& delta, DoubleVector& point, double prevbest, IntVector& param) {
-  double minf;//, ftmp;
-  int i, j, k;
+  double minf;
+  int i, nvars = point.Size();
+  int next, commit, gen, finished;
   DoubleVector z(point);
+  DoubleVector ftmp(2 * nvars, 0.0);
+  IntVector done(2 * nvars, 0);
 
-  struct Storage {
-	  DoubleVector z;
-	  DoubleVector delta;
-	  double ftmp;
-	  int iters;
-  };
+  //JMB the slave processes are sent batches of probes instead
+  if (EcoSystem->runDistributed())
+    return this->bestNearbyBatch(delta, point, prevbest, param);
 
   minf = prevbest;
-  i = 0;
-
-  int paral_tokens, numThr, nvars = point.Size();
-  numThr = omp_get_max_threads ( );
-
-  Storage* storage = new Storage[numThr];
-  if ((numThr % 2) == 0)
-	  paral_tokens = numThr / 2;
-  else {
-	  return -1;
+  next = 0;     //next probe to be taken from the queue
+  commit = 0;   //next coord to be committed
+  gen = 0;      //number of moves, used to discard probes based on an old point
+  finished = (nvars == 0);
+
+#pragma omp parallel private(i)
+  {
+    int p, k, g;
+    int wait = 5;  //microseconds that an idle thread waits before checking the queue again
+    double f;
+    DoubleVector v(nvars, 0.0);
+    while (1) {
+      p = -1;
+#pragma omp critical (hookequeue)
+      {
+        if ((!finished) && (next < 2 * nvars)) {
+          p = next++;
+          g = gen;
+          v = z;
+          k = param[p / 2];
+          if ((p % 2) == 0)
+            v[k] += delta[k];
+          else
+            v[k] -= delta[k];
+        }
+      }
+      if (p == -1) {
+        int stop;
+#pragma omp critical (hookequeue)
+        stop = finished;
+        if (stop)
+          break;
+
+        //JMB wait for the remaining probes to be committed, backing off so
+        //that the idle threads dont spin on the queue for the whole model run
+        //but keeping the wait short so the next probes are picked up quickly
+#pragma omp taskyield
+        usleep(wait);
+        wait = min(2 * wait, 40);
+        continue;
+      }
+      wait = 5;
+
+      //JMB the first probes may have been evaluated with the pattern move
+      if (!this->findProbe(v, f))
+        f = EvaluationEngine::Evaluate(v);
+
+#pragma omp critical (hookequeue)
+      {
+        if (g == gen) {
+          ftmp[p] = f;
+          done[p] = 1;
+          while (commit < nvars) {
+            k = param[commit];
+            if (!done[2 * commit])
+              break;
+            if (ftmp[2 * commit] < minf) {
+              minf = ftmp[2 * commit];
+              z[k] += delta[k];
+              iters++;
+            } else {
+              if (!done[2 * commit + 1])
+                break;
+              delta[k] = 0.0 - delta[k];
+              iters += 2;
+              if (ftmp[2 * commit + 1] < minf) {
+                minf = ftmp[2 * commit + 1];
+                z[k] += delta[k];
+              } else {
+                commit++;
+                continue;
+              }
+            }
+
+            //JMB the point has moved, so the queued probes are out of date
+            commit++;
+            gen++;
+            next = 2 * commit;
+            for (i = next; i < 2 * nvars; i++)
+              done[i] = 0;
+          }
+          if (commit == nvars)
+            finished = 1;
+        }
+      }
+    }
   }
 
-//  omp_set_dynamic(0);
-//  omp_set_nested(1); //permit the nested parallelization
-  while ( i < nvars) {
-	  if ((i + paral_tokens -1) >= nvars)
-		  paral_tokens = nvars - i;
-#pragma omp parallel for num_threads(paral_tokens*2) private(k) //parallelize the parameters (numThr)
-	  for (j = 0; j < (paral_tokens*2); ++j) {
-		  storage[j].z = z;
-		  storage[j].delta = delta;
-		  DoubleVector v(z);
-
-		  if (j<paral_tokens) {
-			  k = param[i+j];
-			  v[k] +=  delta[k];
-		  }
-		  else {
-			  k = param[i+j-paral_tokens];
-			  v[k] -=  delta[k];
-		  }
+  //JMB any speculative probes that were not used are discarded
+  probes.Reset();
+  probef.Reset();
+  for (i = 0; i < nvars; i++)
+    point[i] = z[i];
+  return minf;
+}
 
-		  storage[j].ftmp = EcoSystems[j]->SimulateAndUpdate(v);
-		  storage[j].z[k] = v[k];
-	  }
-	  for (j = 0; j < paral_tokens; ++j) {
-		  k = param[i+j];
-	  	  if (storage[j].ftmp < minf) {
-			  storage[j].iters = 1;
-//			  storage[j].z[k] = v1[k];
-		  } else {
-			  storage[j].iters = 2;
-			  storage[j].delta[k] = 0.0 - delta[k];
-			  if (storage[j+paral_tokens].ftmp < minf) {
-				  storage[j].ftmp = storage[j+paral_tokens].ftmp;
-				  storage[j].z[k] = storage[j+paral_tokens].z[k];;
-			  }
-		  }
-	  }
+/* the +delta/-delta probes for the next numThr coords are evaluated as a batch */
+/* and committed in the same order as the serial version.  After a move the    */
+/* probes for the following coords are out of date, so a new batch is started  */
+double OptInfoHooke::bestNearbyBatch(DoubleVector& delta, DoubleVector& point, double prevbest, IntVector& param) {
+  double minf;
+  int i, j, k, num, moved, commit;
+  int nvars = point.Size(), numThr = omp_get_max_threads();
+  DoubleVector z(point);
+  DoubleMatrix v(2 * numThr, nvars, 0.0);
+  DoubleVector ftmp(2 * numThr, 0.0);
 
-	  for (j = 0; j < paral_tokens; ++j) {
-		  i++;
-		  iters += storage[j].iters;
-		  if (storage[j].ftmp < minf) {
-			  minf = storage[j].ftmp;
-			  z = storage[j].z;
-			  delta = storage[j].delta;
-			  break;
-		  }
-	  }
+  minf = prevbest;
+  commit = 0;
+  while (commit < nvars) {
+    num = min(numThr, nvars - commit);
+    for (j = 0; j < num; j++) {
+      k = param[commit + j];
+      v[2 * j] = z;
+      v[2 * j][k] += delta[k];
+      v[2 * j + 1] = z;
+      v[2 * j + 1][k] -= delta[k];
+    }
+    EvaluationEngine::Evaluate(v, ftmp, 0, 2 * num);
+
+    moved = 0;
+    for (j = 0; (j < num) && (!moved); j++) {
+      k = param[commit];
+      commit++;
+      if (ftmp[2 * j] < minf) {
+        minf = ftmp[2 * j];
+        z[k] += delta[k];
+        iters++;
+        moved = 1;
+      } else {
+        delta[k] = 0.0 - delta[k];
+        iters += 2;
+        if (ftmp[2 * j + 1] < minf) {
+          minf = ftmp[2 * j + 1];
+          z[k] += delta[k];
+          moved = 1;
+        }
+      }
+    }
   }
-  delete[] storage;
-  for (i = 0; i < nvars; ++i)
+
+  for (i = 0; i < nvars; i++)
     point[i] = z[i];
   return minf;
 }
+
 void OptInfoHooke::OptimiseLikelihoodREP() {
 
   double oldf, newf, bestf, steplength, tmp;
@@ -279,6 +433,7 @@ void OptInfoHooke::OptimiseLikelihoodREP() {
   DoubleVector init(nvars);
   DoubleVector initialstep(nvars, rho);
   DoubleVector delta(nvars);
+  DoubleVector step(nvars);
   IntVector param(nvars, 0);
   IntVector lbound(nvars, 0);
   IntVector rbounds(nvars, 0);
@@ -306,7 +461,7 @@ void OptInfoHooke::OptimiseLikelihoodREP() {
     bestx[i] = x[i];
     trialx[i] = x[i];
     param[i] = i;
-    delta[i] = ((2 * (rand() % 2)) - 1) * rho;  //JMB - randomise the sign
+    delta[i] = ((2 * (OptCheckpoint::randomInteger() % 2)) - 1) * rho;  //JMB - randomise the sign
   }
 
   bestf = EcoSystem->SimulateAndUpdate(trialx);
@@ -327,6 +482,25 @@ void OptInfoHooke::OptimiseLikelihoodREP() {
   iters = 0;
 
   while (1) {
+    //JMB store or restore the state of the optimisation at the start of each iteration
+    if (OptCheckpoint::Start(OPTHOOKE)) {
+      OptCheckpoint::Transfer(x);
+      OptCheckpoint::Transfer(bestx);
+      OptCheckpoint::Transfer(delta);
+      OptCheckpoint::Transfer(initialstep);
+      OptCheckpoint::Transfer(param);
+      OptCheckpoint::Transfer(lbound);
+      OptCheckpoint::Transfer(rbounds);
+      OptCheckpoint::Transfer(trapped);
+      OptCheckpoint::Transfer(bestf);
+      OptCheckpoint::Transfer(newf);
+      OptCheckpoint::Transfer(oldf);
+      OptCheckpoint::Transfer(steplength);
+      OptCheckpoint::Transfer(offset);
+      OptCheckpoint::Transfer(iters);
+      OptCheckpoint::Finish();
+    }
+
     if (isZero(bestf)) {
       iters = EcoSystem->getFuncEval() - offset;
       handle.logMessage(LOGINFO, "Error in Hooke & Jeeves optimisation after", iters, "function evaluations, f(x) = 0");
@@ -337,7 +511,7 @@ void OptInfoHooke::OptimiseLikelihoodREP() {
     /* randomize the order of the parameters once in a while */
     rchange = 0;
     while (rchange < nvars) {
-      rnumber = rand() % nvars;
+      rnumber = OptCheckpoint::randomInteger() % nvars;
       rcheck = 1;
       for (i = 0; i < rchange; i++)
         if (param[i] == rnumber)
@@ -352,11 +526,6 @@ void OptInfoHooke::OptimiseLikelihoodREP() {
     for (i = 0; i < nvars; i++)
       trialx[i] = x[i];
     newf = this->bestNearbyRepro(delta, trialx, bestf, param);
-    if (newf == -1) {
-    	handle.logMessage(LOGINFO, "\nStopping Hooke & Jeeves optimisation algorithm\n");
-    	handle.logMessage(LOGINFO, "\nThe number of threads must be a multiple of 2\n");
-    	return;
-    }
     /* if too many function evaluations occur, terminate the algorithm */
 
 //    iters = EcoSystem->getFuncEval() - offset;
@@ -421,12 +590,17 @@ void OptInfoHooke::OptimiseLikelihoodREP() {
         /* now, move further in this direction  */
         tmp = x[i];
         x[i] = trialx[i];
+        step[i] = trialx[i] - tmp;
         trialx[i] = trialx[i] + trialx[i] - tmp;
       }
 
       /* only move forward if this is really an improvement    */
       oldf = newf;
-      newf = EcoSystem->SimulateAndUpdate(trialx);
+      if (linesearch)
+        newf = this->patternLineSearch(trialx, step, lowerb, upperb, delta, param,
+          (EcoSystem->runDistributed() ? 0 : numThr - 3));
+      else
+        newf = EcoSystem->SimulateAndUpdate(trialx);
       iters++;
       if ((isEqual(newf, oldf)) || (newf > oldf)) {
         newf = oldf;  //JMB no improvement, so reset the value of newf
@@ -439,11 +613,6 @@ void OptInfoHooke::OptimiseLikelihoodREP() {
         x[i] = trialx[i];
 
       newf = this->bestNearbyRepro(delta, trialx, bestf, param);
-      if (newf == -1) {
-          	handle.logMessage(LOGINFO, "\nStopping Hooke & Jeeves optimisation algorithm\n");
-          	handle.logMessage(LOGINFO, "\nThe number of threads must be a multiple of 2\n");
-          	return;
-      }
       if (isEqual(newf, bestf))
         break;
 
@@ -515,6 +684,7 @@ void OptInfoHooke::OptimiseLikelihood() {
   DoubleVector init(nvars);
   DoubleVector initialstep(nvars, rho);
   DoubleVector delta(nvars);
+  DoubleVector step(nvars);
   IntVector param(nvars, 0);
   IntVector lbound(nvars, 0);
   IntVector rbounds(nvars, 0);
@@ -539,7 +709,7 @@ void OptInfoHooke::OptimiseLikelihood() {
     bestx[i] = x[i];
     trialx[i] = x[i];
     param[i] = i;
-    delta[i] = ((2 * (rand() % 2)) - 1) * rho;  //JMB - randomise the sign
+    delta[i] = ((2 * (OptCheckpoint::randomInteger() % 2)) - 1) * rho;  //JMB - randomise the sign
   }
 
   bestf = EcoSystem->SimulateAndUpdate(trialx);
@@ -562,6 +732,25 @@ void OptInfoHooke::OptimiseLikelihood() {
   int stop=0;
   while (stop==0) {
 
+    //JMB store or restore the state of the optimisation at the start of each iteration
+    if (OptCheckpoint::Start(OPTHOOKE)) {
+      OptCheckpoint::Transfer(x);
+      OptCheckpoint::Transfer(bestx);
+      OptCheckpoint::Transfer(delta);
+      OptCheckpoint::Transfer(initialstep);
+      OptCheckpoint::Transfer(param);
+      OptCheckpoint::Transfer(lbound);
+      OptCheckpoint::Transfer(rbounds);
+      OptCheckpoint::Transfer(trapped);
+      OptCheckpoint::Transfer(bestf);
+      OptCheckpoint::Transfer(newf);
+      OptCheckpoint::Transfer(oldf);
+      OptCheckpoint::Transfer(steplength);
+      OptCheckpoint::Transfer(offset);
+      OptCheckpoint::Transfer(iters);
+      OptCheckpoint::Finish();
+    }
+
     if (isZero(bestf)) {
       iters = EcoSystem->getFuncEval() - offset;
       handle.logMessage(LOGINFO, "Error in Hooke & Jeeves optimisation after", iters, "function evaluations, f(x) = 0");
@@ -572,7 +761,7 @@ void OptInfoHooke::OptimiseLikelihood() {
     /* randomize the order of the parameters once in a while */
     rchange = 0;
     while (rchange < nvars) {
-      rnumber = rand() % nvars;
+      rnumber = OptCheckpoint::randomInteger() % nvars;
       rcheck = 1;
       for (i = 0; i < rchange; i++)
         if (param[i] == rnumber)
@@ -652,12 +841,16 @@ void OptInfoHooke::OptimiseLikelihood() {
         /* now, move further in this direction  */
         tmp = x[i];
         x[i] = trialx[i];
+        step[i] = trialx[i] - tmp;
         trialx[i] = trialx[i] + trialx[i] - tmp;
       }
 
       /* only move forward if this is really an improvement    */
       oldf = newf;
-      newf = EcoSystem->SimulateAndUpdate(trialx);
+      if (linesearch)
+        newf = this->patternLineSearch(trialx, step, lowerb, upperb, delta, param, 0);
+      else
+        newf = EcoSystem->SimulateAndUpdate(trialx);
       if ((isEqual(newf, oldf)) || (newf > oldf)) {
         newf = oldf;  //JMB no improvement, so reset the value of newf
         break;
@@ -748,6 +941,8 @@ double OptInfoHooke::bestNearbySpec(DoubleVector& delta, DoubleVector& point, do
   numThr = omp_get_max_threads ( );
 
   Storage* storage = new Storage[numThr];
+  DoubleMatrix trials(numThr, nvars, 0.0);
+  DoubleVector f(numThr, 0.0);
   if ((numThr % 2) == 0)
 	  paral_tokens = numThr / 2;
   else {
@@ -761,25 +956,26 @@ double OptInfoHooke::bestNearbySpec(DoubleVector& delta, DoubleVector& point, do
 	  while ( i < nvars) {
 		  if ((i + paral_tokens -1) >= nvars)
 			  paral_tokens = nvars - i;
-	#pragma omp parallel for num_threads(paral_tokens*2) private(k)
 		  for (j = 0; j < (paral_tokens*2); ++j) {
 			  storage[j].z = z;
 			  storage[j].delta = delta;
-			  DoubleVector v(z);
+			  trials[j] = z;
 
 			  if (j<paral_tokens) {
 				  k = param[i+j];
-				  v[k] +=  delta[k];
+				  trials[j][k] +=  delta[k];
 			  }
 			  else {
 				  k = param[i+j-paral_tokens];
-				  v[k] -=  delta[k];
+				  trials[j][k] -=  delta[k];
 			  }
-
-			  storage[j].ftmp = EcoSystems[j]->SimulateAndUpdate(v);
-			  storage[j].z[k] = v[k];
+			  storage[j].z[k] = trials[j][k];
 		  }
 
+		  EvaluationEngine::Evaluate(trials, f, 0, paral_tokens*2);
+		  for (j = 0; j < (paral_tokens*2); ++j)
+			  storage[j].ftmp = f[j];
+
 		  for (j = 0; j < paral_tokens; ++j) {
 			  k = param[i+j];
 			  if (storage[j].ftmp < minf) {
@@ -826,6 +1022,8 @@ double OptInfoHooke::bestNearbySpec(DoubleVector& delta, DoubleVector& point, do
 	   int    rchange, rcheck, rnumber;  //Used to randomise the order of the parameters
 	   double timestop;
 	   handle.logMessage(LOGINFO, "\nStarting Hooke & Jeeves optimisation algorithm OMP\n");
+	   //JMB the speculative search cannot be repeated exactly, so it cannot be restarted part way through
+	   OptCheckpoint::Discard();
 	   int nvars = EcoSystem->numOptVariables();
 	   DoubleVector x(nvars);
 	   DoubleVector trialx(nvars);
@@ -835,6 +1033,7 @@ double OptInfoHooke::bestNearbySpec(DoubleVector& delta, DoubleVector& point, do
 	   DoubleVector init(nvars);
 	   DoubleVector initialstep(nvars, rho);
 	   DoubleVector delta(nvars);
+	   DoubleVector step(nvars);
 	   IntVector param(nvars, 0);
 	   IntVector lbound(nvars, 0);
 	   IntVector rbounds(nvars, 0);
@@ -862,7 +1061,7 @@ double OptInfoHooke::bestNearbySpec(DoubleVector& delta, DoubleVector& point, do
 	     bestx[i] = x[i];
 	     trialx[i] = x[i];
 	     param[i] = i;
-	     delta[i] = ((2 * (rand() % 2)) - 1) * rho;  //JMB - randomise the sign
+	     delta[i] = ((2 * (OptCheckpoint::randomInteger() % 2)) - 1) * rho;  //JMB - randomise the sign
 	   }
 
 	   bestf = EcoSystem->SimulateAndUpdate(trialx);
@@ -897,7 +1096,7 @@ double OptInfoHooke::bestNearbySpec(DoubleVector& delta, DoubleVector& point, do
 	     /* randomize the order of the parameters once in a while */
 	     rchange = 0;
 	     while (rchange < nvars) {
-	       rnumber = rand() % nvars;
+	       rnumber = OptCheckpoint::randomInteger() % nvars;
 	       rcheck = 1;
 	       for (i = 0; i < rchange; i++)
 	         if (param[i] == rnumber)
@@ -987,12 +1186,16 @@ double OptInfoHooke::bestNearbySpec(DoubleVector& delta, DoubleVector& point, do
 	         /* now, move further in this direction  */
 	         tmp = x[i];
 	         x[i] = trialx[i];
+	         step[i] = trialx[i] - tmp;
 	         trialx[i] = trialx[i] + trialx[i] - tmp;
 	       }
 
 	       /* only move forward if this is really an improvement    */
 	       oldf = newf;
-	       newf = EcoSystem->SimulateAndUpdate(trialx);
+	       if (linesearch)
+	         newf = this->patternLineSearch(trialx, step, lowerb, upperb, delta, param, 0);
+	       else
+	         newf = EcoSystem->SimulateAndUpdate(trialx);
 //	 #ifdef _OPENMP
 	       iters++;
 //	 #endif
@@ -3,6 +3,7 @@
 #include "readfunc.h"
 #include "readword.h"
 #include "mathfunc.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -279,7 +280,7 @@ InitialCond::InitialCond(CommentStream& infile, const IntVector& Areas,
   const char* givenname, const AreaClass* const Area, double DL)
   : HasName(givenname), LivesOnAreas(Areas), LgrpDiv(0), CI(0) {
 
-  ifstream subfile;
+  ModelFile subfile;
   CommentStream subcomment(subfile);
   char text[MaxStrLength];
   strncpy(text, "", MaxStrLength);
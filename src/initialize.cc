@@ -37,7 +37,7 @@
 void Ecosystem::Initialise() {
   PreyPtrVector preyvec;
   PredatorPtrVector predvec;
-  int i, j, count;
+  int i, j, k, t, count, year, step;
 
   //first check that the names of the components are unique
   for (i = 0; i < fleetvec.Size(); i++)
@@ -118,17 +118,17 @@ void Ecosystem::Initialise() {
     handle.logMessage(LOGMESSAGE, "Initialising likelihood component", likevec[i]->getName());
     switch (likevec[i]->getType()) {
       case SURVEYINDICESLIKELIHOOD:
-        ((SurveyIndices*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec);
+        ((SurveyIndices*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec, planner);
         break;
       case UNDERSTOCKINGLIKELIHOOD:
         ((UnderStocking*)likevec[i])->setPredatorsAndPreys(predvec, preyvec, Area);
         count++;
         break;
       case CATCHDISTRIBUTIONLIKELIHOOD:
-        ((CatchDistribution*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec);
+        ((CatchDistribution*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec, planner);
         break;
       case CATCHSTATISTICSLIKELIHOOD:
-        ((CatchStatistics*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec);
+        ((CatchStatistics*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec, planner);
         break;
       case STOMACHCONTENTLIKELIHOOD:
         ((StomachContent*)likevec[i])->setPredatorsAndPreys(predvec, preyvec);
@@ -137,7 +137,7 @@ void Ecosystem::Initialise() {
         ((Recaptures*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec);
         break;
       case STOCKDISTRIBUTIONLIKELIHOOD:
-        ((StockDistribution*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec);
+        ((StockDistribution*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec, planner);
         break;
       case MIGRATIONPENALTYLIKELIHOOD:
         ((MigrationPenalty*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec);
@@ -149,7 +149,7 @@ void Ecosystem::Initialise() {
         ((RecStatistics*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec);
         break;
       case SURVEYDISTRIBUTIONLIKELIHOOD:
-        ((SurveyDistribution*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec);
+        ((SurveyDistribution*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec, planner);
         break;
       case MIGRATIONPROPORTIONLIKELIHOOD:
         ((MigrationProportion*)likevec[i])->setFleetsAndStocks(fleetvec, stockvec);
@@ -165,11 +165,38 @@ void Ecosystem::Initialise() {
     }
   }
 
+  planner->logSummary();
   if (count == 0)
     handle.logMessage(LOGWARN, "Warning in input files - no understocking likelihood component found");
   if (count > 1)
     handle.logMessage(LOGWARN, "Warning in input files - repeated understocking components found");
 
+  //JMB store the likelihood components that are active on each timestep, so
+  //that the components without data on a timestep are not called on it
+  //the components can be calculated in parallel on a timestep if none of
+  //the active components change the model
+  likesteps.AddRows(TimeInfo->numTotalSteps() + 1, 0, 0);
+  likeparallel.resize(TimeInfo->numTotalSteps() + 1, 0);
+  for (t = 1; t <= TimeInfo->numTotalSteps(); t++) {
+    k = t + TimeInfo->getFirstStep() - 2;
+    year = TimeInfo->getFirstYear() + (k / TimeInfo->numSteps());
+    step = (k % TimeInfo->numSteps()) + 1;
+    likeparallel[t] = 1;
+    for (i = 0; i < likevec.Size(); i++) {
+      if (likevec[i]->isActive(year, step, TimeInfo)) {
+        likesteps[t].resize(1, i);
+        if (!(likevec[i]->isReadOnly()))
+          likeparallel[t] = 0;
+      }
+    }
+    if (likesteps[t].Size() < 2)
+      likeparallel[t] = 0;
+  }
+  for (t = 1, k = 0; t <= TimeInfo->numTotalSteps(); t++)
+    k += likesteps[t].Size();
+  if (k < likevec.Size() * TimeInfo->numTotalSteps())
+    handle.logMessage(LOGMESSAGE, "Number of likelihood calculations skipped on each simulation", likevec.Size() * TimeInfo->numTotalSteps() - k);
+
   //Finally we initialise the printer classes
   for (i = 0; i < printvec.Size(); i++) {
     handle.logMessage(LOGMESSAGE, "Initialising printer for output file", printvec[i]->getFileName());
@@ -1,28 +1,15 @@
 #include "interruptinterface.h"
 #include "charptrvector.h"
 #include "ecosystem.h"
+#include "evaluationengine.h"
 #include "gadget.h"
 
 extern Ecosystem* EcoSystem;
 extern volatile int interrupted;
-#ifdef _OPENMP
-extern Ecosystem** EcoSystems;
-extern MainInfo _main;
-#endif
 
 void InterruptInterface::printMenu() {
-  if (EcoSystem->getFuncEval() != 0)
-  {
-	  int iters = EcoSystem->getFuncEval();
-	  #ifdef _OPENMP
-	  if (_main.runParallel()){
-	    int numThr = omp_get_max_threads ( );
-	      for (int i = 0; i < numThr; i++)
-	    	  iters += EcoSystems[i]->getFuncEval();
-	  }
-	  #endif
-    cout << "\nInterrupted after a total of " << iters << " iterations ...";
-  }
+  if (EvaluationEngine::numEvaluations() != 0)
+    cout << "\nInterrupted after a total of " << EvaluationEngine::numEvaluations() << " iterations ...";
   cout << "\nInterrupted at year " << EcoSystem->getCurrentYear() << ", step "
     << EcoSystem->getCurrentStep() << " (" << EcoSystem->getCurrentTime()
     << " of " << EcoSystem->numTotalSteps() << " timesteps)\n"
@@ -2,15 +2,12 @@
 #include "errorhandler.h"
 #include "runid.h"
 #include "ecosystem.h"
+#include "evaluationengine.h"
 #include "gadget.h"
 #include "global.h"
 
 extern Ecosystem* EcoSystem;
 
-#ifdef _OPENMP
-extern Ecosystem** EcoSystems;
-#endif
-
 Keeper::Keeper() {
   stack = new StrStack();
   boundsgiven = 0;
@@ -140,12 +137,39 @@ void Keeper::getCurrentValues(DoubleVector& val) const {
     val[i] = values[i];
 }
 
+void Keeper::getFirstUse(IntVector& firstuse) const {
+  int i, j;
+  for (i = 0; i < address.Nrow(); i++) {
+    firstuse[i] = address[i][0].firstuse;
+    for (j = 1; j < address.Ncol(i); j++)
+      if (address[i][j].firstuse < firstuse[i])
+        firstuse[i] = address[i][j].firstuse;
+  }
+}
+
+void Keeper::setFirstUse(const double& var, int time) {
+  int i, j;
+  for (i = 0; i < address.Nrow(); i++)
+    for (j = 0; j < address.Ncol(i); j++)
+      if (address[i][j] == &var)
+        address[i][j].firstuse = (time > 1 ? time : 1);
+}
+
 void Keeper::getInitialValues(DoubleVector& val) const {
   int i;
   for (i = 0; i < initialvalues.Size(); i++)
     val[i] = initialvalues[i];
 }
 
+void Keeper::setInitialValues(const DoubleVector& val) {
+  int i;
+  if (val.Size() != initialvalues.Size())
+    handle.logMessage(LOGFAIL, "Error in keeper - received wrong number of variables to update");
+
+  for (i = 0; i < initialvalues.Size(); i++)
+    initialvalues[i] = val[i];
+}
+
 void Keeper::getScaledValues(DoubleVector& val) const {
   int i;
   for (i = 0; i < scaledvalues.Size(); i++)
@@ -285,27 +309,23 @@ void Keeper::writeInitialInformation(const LikelihoodPtrVector& likevec) {
 }
 
 void Keeper::writeValues(const LikelihoodPtrVector& likevec, int prec) {
+  this->writeValues(values, likevec, EcoSystem->getLikelihood(), prec);
+}
+
+void Keeper::writeValues(const DoubleVector& val, const LikelihoodPtrVector& likevec, double likelihood, int prec) {
   if (!fileopen)
     handle.logMessage(LOGFAIL, "Error in keeper - cannot write to output file");
 
   //JMB - print the number of function evaluations at the start of the line
-  int iters = EcoSystem->getFuncEval();
-#ifdef _OPENMP
-  if(EcoSystems != NULL) {
-    int numThr = omp_get_max_threads ( );
-    for (int i = 0; i < numThr; i++)
-      iters += EcoSystems[i]->getFuncEval();
-  }
-#endif
-  outfile << iters << TAB;
+  outfile << EvaluationEngine::numEvaluations() << TAB;
 
   int i, p, w;
   p = prec;
   if (prec == 0)
     p = printprecision;
   w = p + 4;
-  for (i = 0; i < values.Size(); i++)
-    outfile << setw(w) << setprecision(p) << values[i] << sep;
+  for (i = 0; i < val.Size(); i++)
+    outfile << setw(w) << setprecision(p) << val[i] << sep;
 
   if (prec == 0)
     p = smallprecision;
@@ -317,7 +337,7 @@ void Keeper::writeValues(const LikelihoodPtrVector& likevec, int prec) {
   if (prec == 0)
     p = fullprecision;
   w = p + 4;
-  outfile << TAB << TAB << setw(w) << setprecision(p) << EcoSystem->getLikelihood() << endl;
+  outfile << TAB << TAB << setw(w) << setprecision(p) << likelihood << endl;
 }
 
 void Keeper::Update(const StochasticData* const Stoch) {
@@ -424,13 +444,7 @@ void Keeper::writeParams(const OptInfoPtrVector& optvec, const char* const filen
   RUNID.Print(paramfile);
 
   if (interrupt) {
-	int iters = EcoSystem->getFuncEval();
-#ifdef _OPENMP
-	int numThr = omp_get_max_threads ( );
-    for (i = 0; i < numThr; i++)
-  	  iters += EcoSystems[i]->getFuncEval();
-#endif
-    paramfile << "; Gadget was interrupted after a total of " << iters
+    paramfile << "; Gadget was interrupted after a total of " << EvaluationEngine::numEvaluations()
       << " function evaluations\n; the best likelihood value found so far is "
       << setprecision(p) << bestlikelihood << endl;
   } else if (EcoSystem->getFuncEval() == 0) {
@@ -538,6 +552,19 @@ void Keeper::checkBounds(const LikelihoodPtrVector& likevec) const {
   }
 }
 
+void Keeper::getOptBestValues(DoubleVector& val) const {
+  int i, j = 0;
+  if (val.Size() != numoptvar)
+    handle.logMessage(LOGFAIL, "Error in keeper - received invalid number of optimising variables");
+
+  for (i = 0; i < bestvalues.Size(); i++) {
+    if (opt[i]) {
+      val[j] = bestvalues[i];
+      j++;
+    }
+  }
+}
+
 void Keeper::storeVariables(double likvalue, const DoubleVector& point) {
   int i, j = 0;
   bestlikelihood = likvalue;
@@ -74,8 +74,10 @@ void LikelihoodPrinter::setLikelihood(LikelihoodPtrVector& likevec) {
 
   for (i = 0; i < likevec.Size(); i++)
     for (j = 0; j < likenames.Size(); j++)
-      if (strcasecmp(likevec[i]->getName(), likenames[j]) == 0)
+      if (strcasecmp(likevec[i]->getName(), likenames[j]) == 0) {
         like.resize(likevec[i]);
+        likevec[i]->setPrintModel();
+      }
 
   if (like.Size() != likenames.Size()) {
     handle.logMessage(LOGWARN, "Error in likelihoodprinter - failed to match likelihood components");
@@ -21,7 +21,10 @@ void MainInfo::showUsage() {
     << " -v --version                 display version information and exit\n"
     << " -h --help                    display this help screen and exit\n"
 #ifdef _OPENMP
-    << " -parallel  <option>          run in parallel <option> == [spe, rep]. spe=speculative, rep=reproducible. Defaull spe\n"
+    << " -parallel  <option>          run in parallel <option> == [spe, rep, area, like]. spe=speculative, rep=reproducible. Defaull spe\n"
+    << "                              area=update the areas in parallel during each simulation\n"
+    << "                              like=calculate the likelihood components in parallel during each simulation\n"
+    << "                              with -s and -i, the parameter sets are simulated in parallel\n"
 #endif
     << "\nOptions for specifying the input to Gadget models:\n"
     << " -i <filename>                read model parameters from <filename>\n"
@@ -35,6 +38,26 @@ void MainInfo::showUsage() {
     << " -o <filename>                print likelihood output to <filename>\n"
     << " -print <number>              print -o output every <number> iterations\n"
     << " -precision <number>          set the precision to <number> in output files\n"
+    << "\nOptions for speeding up Gadget models:\n"
+    << " -simcheckpoint <number>      store the model state every <number> years during each\n"
+    << "                              simulation and restart later simulations from these\n"
+    << "                              checkpoints when only later parameters have changed\n"
+    << " -evalcache                   store the likelihood scores for each point evaluated during\n"
+    << "                              the optimisation, so that no point is simulated twice\n"
+    << " -evalcachefile <filename>    store the evaluated points in <filename> too, and read\n"
+    << "                              the points stored from earlier optimisation runs\n"
+    << "\nOptions for restarting Gadget optimisation runs:\n"
+    << " -optcheckpoint <filename>    store the state of the optimisation in <filename>\n"
+    << " -optcheckpointtime <number>  store the state every <number> seconds (default 600)\n"
+    << " -optrestart <filename>       restart the optimisation from the state stored in <filename>\n"
+    << "\nOptions for optimising Gadget models from more than one starting point:\n"
+    << " -multistart <number>         optimise from <number> starting points, the first from the\n"
+    << "                              -i file and the others spread out between the bounds\n"
+    << " -multistarttol <number>      stop the optimisation from a starting point early when its\n"
+    << "                              score is worse than the best score by more than this\n"
+    << "                              relative difference (default 0.1)\n"
+    << " -multistartfile <filename>   print the results from each starting point to <filename>\n"
+    << "                              (default filename is 'multistart.out')\n"
     << "\nOptions for debugging Gadget models:\n"
     << " -log <filename>              print logging information to <filename>\n"
     << " -printinitial <filename>     print initial model information to <filename>\n"
@@ -45,23 +68,30 @@ void MainInfo::showUsage() {
 
 MainInfo::MainInfo()
 #ifdef _OPENMP
-  : givenOptInfo(0), givenInitialParam(0), runoptimise(0), runparallel(0),
+  : givenOptInfo(0), givenInitialParam(0), runoptimise(0), runparallel(0), runareaparallel(0), runlikeparallel(0),
 #else
   : givenOptInfo(0), givenInitialParam(0), runoptimise(0), 
 #endif
     runstochastic(0), runnetwork(0), runprint(1), forceprint(0),
-    printInitialInfo(0), printFinalInfo(0), printLogLevel(0), maxratio(0.95) {
+    printInitialInfo(0), printFinalInfo(0), printLogLevel(0), maxratio(0.95), simcheckpoint(0), evalcache(0),
+    optcheckpointtime(600), multistart(0), multistarttol(0.1) {
 
-  char tmpname[10];
-  strncpy(tmpname, "", 10);
+  char tmpname[15];
+  strncpy(tmpname, "", 15);
   strcpy(tmpname, "main");
 
   strOptInfoFile = NULL;
+  strEvalCacheFile = NULL;
+  strOptCheckpointFile = NULL;
+  strOptRestartFile = NULL;
+  strMultiStartFile = NULL;
   strInitialParamFile = NULL;
   strPrintInitialFile = NULL;
   strPrintFinalFile = NULL;
   strMainGadgetFile = NULL;
   setMainGadgetFile(tmpname);
+  strcpy(tmpname, "multistart.out");
+  setMultiStartFile(tmpname);
 }
 
 MainInfo::~MainInfo() {
@@ -69,6 +99,22 @@ MainInfo::~MainInfo() {
     delete[] strOptInfoFile;
     strOptInfoFile = NULL;
   }
+  if (strEvalCacheFile != NULL) {
+    delete[] strEvalCacheFile;
+    strEvalCacheFile = NULL;
+  }
+  if (strOptCheckpointFile != NULL) {
+    delete[] strOptCheckpointFile;
+    strOptCheckpointFile = NULL;
+  }
+  if (strOptRestartFile != NULL) {
+    delete[] strOptRestartFile;
+    strOptRestartFile = NULL;
+  }
+  if (strMultiStartFile != NULL) {
+    delete[] strMultiStartFile;
+    strMultiStartFile = NULL;
+  }
   if (strInitialParamFile != NULL) {
     delete[] strInitialParamFile;
     strInitialParamFile = NULL;
@@ -262,6 +308,56 @@ void MainInfo::read(int aNumber, char* const aVector[]) {
         this->showCorrectUsage(aVector[k]);
       k++;
       maxratio = atof(aVector[k]);
+    } else if (strcasecmp(aVector[k], "-simcheckpoint") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      simcheckpoint = atoi(aVector[k]);
+      if (simcheckpoint < 0)
+        this->showCorrectUsage(aVector[k - 1]);
+    } else if (strcasecmp(aVector[k], "-evalcache") == 0) {
+      evalcache = 1;
+    } else if (strcasecmp(aVector[k], "-evalcachefile") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setEvalCacheFile(aVector[k]);
+    } else if (strcasecmp(aVector[k], "-optcheckpoint") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setOptCheckpointFile(aVector[k]);
+    } else if (strcasecmp(aVector[k], "-optcheckpointtime") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      optcheckpointtime = atoi(aVector[k]);
+      if (optcheckpointtime < 0)
+        this->showCorrectUsage(aVector[k - 1]);
+    } else if (strcasecmp(aVector[k], "-optrestart") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setOptRestartFile(aVector[k]);
+    } else if (strcasecmp(aVector[k], "-multistart") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      multistart = atoi(aVector[k]);
+      if (multistart < 0)
+        this->showCorrectUsage(aVector[k - 1]);
+    } else if (strcasecmp(aVector[k], "-multistarttol") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      multistarttol = atof(aVector[k]);
+      if (multistarttol < 0.0)
+        this->showCorrectUsage(aVector[k - 1]);
+    } else if (strcasecmp(aVector[k], "-multistartfile") == 0) {
+      if (k == aNumber - 1)
+        this->showCorrectUsage(aVector[k]);
+      k++;
+      this->setMultiStartFile(aVector[k]);
     } else if (strcasecmp(aVector[k], "-nrun") == 0) {
       if (k == aNumber - 1)
         this->showCorrectUsage(aVector[k]);
@@ -466,6 +562,28 @@ handle.logMessage(LOGINFO, "--------parallel option 222 ", text);
       srand(dummy);
     } else if (strcasecmp(text, "-maxratio") == 0) {
       infile >> maxratio >> ws;
+    } else if (strcasecmp(text, "-simcheckpoint") == 0) {
+      infile >> simcheckpoint >> ws;
+    } else if (strcasecmp(text, "-evalcache") == 0) {
+      evalcache = 1;
+    } else if (strcasecmp(text, "-evalcachefile") == 0) {
+      infile >> text >> ws;
+      this->setEvalCacheFile(text);
+    } else if (strcasecmp(text, "-optcheckpoint") == 0) {
+      infile >> text >> ws;
+      this->setOptCheckpointFile(text);
+    } else if (strcasecmp(text, "-optcheckpointtime") == 0) {
+      infile >> optcheckpointtime >> ws;
+    } else if (strcasecmp(text, "-optrestart") == 0) {
+      infile >> text >> ws;
+      this->setOptRestartFile(text);
+    } else if (strcasecmp(text, "-multistart") == 0) {
+      infile >> multistart >> ws;
+    } else if (strcasecmp(text, "-multistarttol") == 0) {
+      infile >> multistarttol >> ws;
+    } else if (strcasecmp(text, "-multistartfile") == 0) {
+      infile >> text >> ws;
+      this->setMultiStartFile(text);
    // } else if (strcasecmp(text, "-nrun") == 0) {
    //   infile >> rrid >> ws;
     } else if (strcasecmp(text, "-printlikesummary") == 0) {
@@ -510,6 +628,16 @@ handle.logMessage(LOGINFO, "--------parallel reproducible ", filename);
        runparallel=2;
        return;
   }
+  if (!strcasecmp(filename,"area")){
+handle.logMessage(LOGINFO, "--------parallel areas ", filename);
+       runareaparallel=1;
+       return;
+  }
+  if (!strcasecmp(filename,"like")){
+handle.logMessage(LOGINFO, "--------parallel likelihood ", filename);
+       runlikeparallel=1;
+       return;
+  }
   this->showCorrectUsage("opt");
   
 }
@@ -534,6 +662,43 @@ void MainInfo::setInitialParamFile(char* filename) {
   givenInitialParam = 1;
 }
 
+void MainInfo::setEvalCacheFile(char* filename) {
+  if (strEvalCacheFile != NULL) {
+    delete[] strEvalCacheFile;
+    strEvalCacheFile = NULL;
+  }
+  strEvalCacheFile = new char[strlen(filename) + 1];
+  strcpy(strEvalCacheFile, filename);
+  evalcache = 1;
+}
+
+void MainInfo::setOptCheckpointFile(char* filename) {
+  if (strOptCheckpointFile != NULL) {
+    delete[] strOptCheckpointFile;
+    strOptCheckpointFile = NULL;
+  }
+  strOptCheckpointFile = new char[strlen(filename) + 1];
+  strcpy(strOptCheckpointFile, filename);
+}
+
+void MainInfo::setOptRestartFile(char* filename) {
+  if (strOptRestartFile != NULL) {
+    delete[] strOptRestartFile;
+    strOptRestartFile = NULL;
+  }
+  strOptRestartFile = new char[strlen(filename) + 1];
+  strcpy(strOptRestartFile, filename);
+}
+
+void MainInfo::setMultiStartFile(char* filename) {
+  if (strMultiStartFile != NULL) {
+    delete[] strMultiStartFile;
+    strMultiStartFile = NULL;
+  }
+  strMultiStartFile = new char[strlen(filename) + 1];
+  strcpy(strMultiStartFile, filename);
+}
+
 void MainInfo::setOptInfoFile(char* filename) {
   if (strOptInfoFile != NULL) {
     delete[] strOptInfoFile;
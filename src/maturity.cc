@@ -5,6 +5,7 @@
 #include "readword.h"
 #include "conversionindex.h"
 #include "errorhandler.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -122,14 +123,15 @@ void Maturity::Move(int area, const TimeClass* const TimeInfo) {
   if (!(this->isMaturationStep(TimeInfo)))
     handle.logMessage(LOGFAIL, "Error in maturity - maturity requested on wrong timestep");
   int i, inarea = this->areaNum(area);
+  double ratio;
   for (i = 0; i < matureStocks.Size(); i++) {
     if (!matureStocks[i]->isInArea(area))
       handle.logMessage(LOGFAIL, "Error in maturity - mature stock doesnt live on area", area);
 
-    tmpratio = matureRatio[ratioindex[i]] * ratioscale;
-    matureStocks[i]->Add(Storage[inarea], CI[i], area, tmpratio);
+    ratio = matureRatio[ratioindex[i]] * ratioscale;
+    matureStocks[i]->Add(Storage[inarea], CI[i], area, ratio);
     if (istagged && tagStorage.numTagExperiments() > 0)
-      matureStocks[i]->Add(tagStorage, CI[i], area, tmpratio);
+      matureStocks[i]->Add(tagStorage, CI[i], area, ratio);
   }
 
   Storage[inarea].setToZero();
@@ -299,9 +301,9 @@ void MaturityA::setStock(StockPtrVector& stockvec) {
 double MaturityA::calcMaturation(int age, int length, int growth, double weight) {
 
   if ((age >= minMatureAge) && ((length + growth) >= minMatureLength)) {
-    tmpratio = preCalcMaturation[age - minStockAge][length] *
+    double ratio = preCalcMaturation[age - minStockAge][length] *
        (maturityParameters[0] * growth * LgrpDiv->dl() + maturityParameters[2] * timesteplength);
-    return (min(max(0.0, tmpratio), 1.0));
+    return (min(max(0.0, ratio), 1.0));
   }
   return 0.0;
 }
@@ -580,7 +582,7 @@ MaturityD::MaturityD(CommentStream& infile, const TimeClass* const TimeInfo,
   : MaturityC(infile, TimeInfo, keeper, minage, numage, tmpareas, givenname, lgrpdiv, numMatConst) {
 
   //read information on reference weights.
-  ifstream subweightfile;
+  ModelFile subweightfile;
   subweightfile.open(refWeightFile, ios::in);
   handle.checkIfFailure(subweightfile, refWeightFile);
   handle.Open(refWeightFile);
@@ -656,8 +658,8 @@ double MaturityD::calcMaturation(int age, int length, int growth, double weight)
     my = exp(-1.0 * maturityParameters[0] * (LgrpDiv->meanLength(length) - maturityParameters[1])
            - maturityParameters[2] * (age + minStockAge - maturityParameters[3])
            - maturityParameters[4] * (tmpweight - maturityParameters[5]));
-    tmpratio = 1.0 / (1.0 + my);
-    return (min(max(0.0, tmpratio), 1.0));
+    my = 1.0 / (1.0 + my);
+    return (min(max(0.0, my), 1.0));
   }
   return 0.0;
 }
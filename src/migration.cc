@@ -4,6 +4,7 @@
 #include "errorhandler.h"
 #include "mathfunc.h"
 #include "migrationarea.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -26,7 +27,7 @@ MigrationNumbers::MigrationNumbers(CommentStream& infile, const IntVector& Areas
   : Migration(Areas, givenname) {
 
   int i, j;
-  ifstream subfile;
+  ModelFile subfile;
   CommentStream subcomment(subfile);
   char text[MaxStrLength];
   char filename[MaxStrLength];
@@ -428,7 +429,7 @@ MigrationFunction::MigrationFunction(CommentStream& infile, const IntVector& Are
   : Migration(Areas, givenname) {
 
   int i;
-  ifstream subfile;
+  ModelFile subfile;
   CommentStream subcomment(subfile);
   char text[MaxStrLength];
   char filename[MaxStrLength];
@@ -464,7 +465,7 @@ void MigrationFunction::readAreaData(CommentStream& infile, const AreaClass* con
   const TimeClass* const TimeInfo, Keeper* const keeper) {
 
   int area, inarea;
-  ifstream subfile;
+  ModelFile subfile;
   CommentStream subcomment(subfile);
   char text[MaxStrLength];
   char filename[MaxStrLength];
@@ -24,6 +24,10 @@ MigrationPenalty::MigrationPenalty(CommentStream& infile, double weight, const c
   }
 }
 
+int MigrationPenalty::isActive(int year, int step, const TimeClass* const TimeInfo) const {
+  return (TimeInfo->calcSteps(year, step) == TimeInfo->numTotalSteps());
+}
+
 void MigrationPenalty::addLikelihood(const TimeClass* const TimeInfo) {
   if (TimeInfo->getTime() != TimeInfo->numTotalSteps())
     return;
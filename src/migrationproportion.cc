@@ -8,6 +8,7 @@
 #include "stock.h"
 #include "mathfunc.h"
 #include "stockprey.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -24,7 +25,7 @@ MigrationProportion::MigrationProportion(CommentStream& infile, const AreaClass*
   char aggfilename[MaxStrLength];
   strncpy(datafilename, "", MaxStrLength);
   strncpy(aggfilename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   timeindex = 0;
@@ -172,6 +173,16 @@ MigrationProportion::~MigrationProportion() {
   delete[] functionname;
 }
 
+void MigrationProportion::restoreState(int id, const TimeClass* const TimeInfo) {
+  Likelihood::restoreState(id, TimeInfo);
+  //JMB the modelled data is summed over the areas so the data for the
+  //rest of the simulation needs to be reset
+  int i;
+  for (i = 0; i < Years.Size(); i++)
+    if ((Years[i] > TimeInfo->getYear()) || ((Years[i] == TimeInfo->getYear()) && (Steps[i] >= TimeInfo->getStep())))
+      modelDistribution[i].setToZero();
+}
+
 void MigrationProportion::Reset(const Keeper* const keeper) {
   Likelihood::Reset(keeper);
   if (isZero(weight))
@@ -251,6 +262,12 @@ void MigrationProportion::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVec
   }
 }
 
+int MigrationProportion::isActive(int year, int step, const TimeClass* const TimeInfo) const {
+  if (isZero(weight))
+    return 0;
+  return AAT.atTime(year, step, TimeInfo);
+}
+
 void MigrationProportion::addLikelihood(const TimeClass* const TimeInfo) {
 
   if ((!(AAT.atCurrentTime(TimeInfo))) || (isZero(weight)))
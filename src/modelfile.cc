@@ -0,0 +1,75 @@
+#include "modelfile.h"
+
+map<string, string> ModelFile::image;
+
+ModelFile::ModelFile() : istream(NULL) {
+  isopen = 0;
+  this->rdbuf(&buffer);
+}
+
+void ModelFile::open(const char* filename, ios::openmode mode) {
+  int found = 0;
+  string contents;
+  map<string, string>::const_iterator it;
+
+#pragma omp critical (modelimage)
+  {
+    it = image.find(filename);
+    if (it != image.end()) {
+      contents = it->second;
+      found = 1;
+    }
+  }
+
+  if (!found) {
+    ifstream infile;
+    infile.open(filename, mode);
+    if (!infile.fail()) {
+      ostringstream data;
+      if (infile.peek() != EOF)
+        data << infile.rdbuf();
+      contents = data.str();
+      found = 1;
+#pragma omp critical (modelimage)
+      image[filename] = contents;
+    }
+    infile.close();
+  }
+
+  this->clear();
+  buffer.str(contents);
+  if (found)
+    isopen = 1;
+  else
+    this->setstate(ios::failbit);
+}
+
+void ModelFile::close() {
+  buffer.str("");
+  isopen = 0;
+}
+
+void ModelFile::clearImage() {
+#pragma omp critical (modelimage)
+  image.clear();
+}
+
+unsigned long ModelFile::checksum(const char* exclude) {
+  unsigned long sum = 2166136261UL;
+  size_t i;
+  map<string, string>::const_iterator it;
+
+  //JMB this is an FNV-1a style hash of the names and the contents of the files
+#pragma omp critical (modelimage)
+  {
+    for (it = image.begin(); it != image.end(); it++) {
+      if ((exclude != NULL) && (it->first == exclude))
+        continue;
+      for (i = 0; i < it->first.size(); i++)
+        sum = (sum ^ (unsigned char)it->first[i]) * 16777619UL;
+      for (i = 0; i < it->second.size(); i++)
+        sum = (sum ^ (unsigned char)it->second[i]) * 16777619UL;
+    }
+  }
+  return sum;
+}
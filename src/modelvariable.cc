@@ -1,12 +1,15 @@
 #include "modelvariable.h"
 #include "errorhandler.h"
 #include "readword.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
 ModelVariable::ModelVariable() {
   value = 0.0;
   mvtype = MVFORMULA;
+  changed = 1;
+  updatetime = 0;
 }
 
 void ModelVariable::setValue(double newValue) {
@@ -15,13 +18,14 @@ void ModelVariable::setValue(double newValue) {
 
   init.setValue(newValue);
   value = newValue;
+  changed = 1;
 }
 
 void ModelVariable::read(CommentStream& infile,
   const TimeClass* const TimeInfo, Keeper* const keeper) {
 
   keeper->addString("modelvariable");
-  ifstream subfile;
+  ModelFile subfile;
   CommentStream subcomment(subfile);
   char text[MaxStrLength];
   strncpy(text, "", MaxStrLength);
@@ -83,8 +87,14 @@ void ModelVariable::read(CommentStream& infile,
 }
 
 int ModelVariable::didChange(const TimeClass* const TimeInfo) {
-  if (TimeInfo->getTime() == 1)
+  if (TimeInfo->getTime() == 1) {
+    //JMB only return true for the first timestep if the formula has changed
+    if (mvtype == MVFORMULA)
+      return changed;
     return 1;  //return true for the first timestep
+  }
+  if (TimeInfo->didRestart())
+    return 1;  //return true if the simulation has been restarted
 
   switch (mvtype) {
     case MVFORMULA:
@@ -106,6 +116,10 @@ int ModelVariable::didChange(const TimeClass* const TimeInfo) {
 void ModelVariable::Update(const TimeClass* const TimeInfo) {
   switch (mvtype) {
     case MVFORMULA:
+      //JMB the formula can only change between simulations, so check this on
+      //the first update of the first timestep and keep it for the simulation
+      if ((TimeInfo->getTime() == 1) && (updatetime != 1))
+        changed = ((updatetime == 0) || (value != init));
       value = init;
       break;
     case MVTIME:
@@ -123,6 +137,7 @@ void ModelVariable::Update(const TimeClass* const TimeInfo) {
       handle.logMessage(LOGWARN, "Warning in modelvariable - unrecognised type", mvtype);
       break;
   }
+  updatetime = TimeInfo->getTime();
 }
 
 void ModelVariable::Delete(Keeper* const keeper) const {
@@ -136,6 +151,8 @@ void ModelVariable::Delete(Keeper* const keeper) const {
 void ModelVariable::Interchange(ModelVariable& newMV, Keeper* const keeper) const {
   newMV.value = value;
   newMV.mvtype = mvtype;
+  newMV.changed = changed;
+  newMV.updatetime = updatetime;
   init.Interchange(newMV.init, keeper);
   if (mvtype == MVTIME)
     TV.Interchange(newMV.TV, keeper);
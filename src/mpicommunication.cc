@@ -0,0 +1,164 @@
+#include "mpicommunication.h"
+#include "ecosystem.h"
+#include "errorhandler.h"
+#include "intvector.h"
+#include "mathfunc.h"
+#include "gadget.h"
+#include "global.h"
+
+MPICommunication::MPICommunication() {
+  int provided;
+  //JMB the MPI functions are only called from the main thread
+  MPI_Init_thread(NULL, NULL, MPI_THREAD_FUNNELED, &provided);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  stopped = 0;
+  sendbuffer = 0;
+  sendsize = 0;
+  recvbuffer = 0;
+  recvsize = 0;
+}
+
+MPICommunication::~MPICommunication() {
+  if (sendbuffer != 0) {
+    delete[] sendbuffer;
+    sendbuffer = 0;
+  }
+  if (recvbuffer != 0) {
+    delete[] recvbuffer;
+    recvbuffer = 0;
+  }
+  MPI_Finalize();
+}
+
+void MPICommunication::stopSlaves() {
+  int i, stopmessage = 0;
+  if (stopped)
+    return;
+
+  for (i = 1; i < size; i++)
+    MPI_Send(&stopmessage, 1, MPI_INT, i, STOPTAG, MPI_COMM_WORLD);
+  stopped = 1;
+}
+
+void MPICommunication::sendBatch(const DoubleMatrix& val, int slave, int first, int num) {
+  int i, j, numvar = val.Ncol();
+  for (i = 0; i < num; i++)
+    for (j = 0; j < numvar; j++)
+      sendbuffer[i * numvar + j] = val[first + i][j];
+
+  MPI_Send(sendbuffer, num * numvar, MPI_DOUBLE, slave, WORKTAG, MPI_COMM_WORLD);
+}
+
+void MPICommunication::Evaluate(const DoubleMatrix& val, DoubleVector& f) {
+  int i, j, next, active, chunk;
+  int num = val.Nrow();
+  int numslaves = this->numSlaves();
+  MPI_Status status;
+
+  if (num <= 0)
+    return;
+  if ((numslaves <= 0) || (stopped))
+    handle.logMessage(LOGFAIL, "Error in mpicommunication - no slave processes available");
+
+  //JMB send a few batches to each slave, so that a slave that is slower
+  //than the others will be sent fewer points to evaluate
+  chunk = num / (2 * numslaves);
+  if ((chunk * 2 * numslaves) < num)
+    chunk++;
+  if (chunk < 1)
+    chunk = 1;
+
+  if (sendsize < chunk * val.Ncol()) {
+    if (sendbuffer != 0)
+      delete[] sendbuffer;
+    sendsize = chunk * val.Ncol();
+    sendbuffer = new double[sendsize];
+  }
+  if (recvsize < chunk * numslaves) {
+    if (recvbuffer != 0)
+      delete[] recvbuffer;
+    recvsize = chunk * numslaves;
+    recvbuffer = new double[recvsize];
+  }
+
+  MPI_Request* request = new MPI_Request[numslaves];
+  IntVector start(numslaves, 0);
+  IntVector count(numslaves, 0);
+  next = 0;
+  active = 0;
+  for (i = 0; i < numslaves; i++) {
+    request[i] = MPI_REQUEST_NULL;
+    if (next < num) {
+      start[i] = next;
+      count[i] = min(chunk, num - next);
+      this->sendBatch(val, i + 1, start[i], count[i]);
+      MPI_Irecv(recvbuffer + i * chunk, count[i], MPI_DOUBLE, i + 1, RESULTTAG, MPI_COMM_WORLD, &request[i]);
+      next += count[i];
+      active++;
+    }
+  }
+
+  while (active > 0) {
+    MPI_Waitany(numslaves, request, &i, &status);
+    for (j = 0; j < count[i]; j++)
+      f[start[i] + j] = recvbuffer[i * chunk + j];
+    active--;
+
+    if (next < num) {
+      start[i] = next;
+      count[i] = min(chunk, num - next);
+      this->sendBatch(val, i + 1, start[i], count[i]);
+      MPI_Irecv(recvbuffer + i * chunk, count[i], MPI_DOUBLE, i + 1, RESULTTAG, MPI_COMM_WORLD, &request[i]);
+      next += count[i];
+      active++;
+    }
+  }
+  delete[] request;
+}
+
+void MPICommunication::runSlave(Ecosystem* eco) {
+  int i, j, num, received, stopmessage;
+  int numvar = eco->numVariables();
+  DoubleVector val(numvar, 0.0);
+  MPI_Status status;
+
+  if (numvar <= 0)
+    handle.logMessage(LOGFAIL, "Error in mpicommunication - no parameters to update");
+
+  while (1) {
+    MPI_Probe(0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+    if (status.MPI_TAG == STOPTAG) {
+      MPI_Recv(&stopmessage, 1, MPI_INT, 0, STOPTAG, MPI_COMM_WORLD, &status);
+      break;
+    }
+
+    MPI_Get_count(&status, MPI_DOUBLE, &received);
+    if ((received % numvar) != 0)
+      handle.logMessage(LOGFAIL, "Error in mpicommunication - received wrong number of variables from master");
+
+    num = received / numvar;
+    if (sendsize < received) {
+      if (sendbuffer != 0)
+        delete[] sendbuffer;
+      sendsize = received;
+      sendbuffer = new double[sendsize];
+    }
+    if (recvsize < num) {
+      if (recvbuffer != 0)
+        delete[] recvbuffer;
+      recvsize = num;
+      recvbuffer = new double[recvsize];
+    }
+    MPI_Recv(sendbuffer, received, MPI_DOUBLE, 0, WORKTAG, MPI_COMM_WORLD, &status);
+
+    for (i = 0; i < num; i++) {
+      for (j = 0; j < numvar; j++)
+        val[j] = sendbuffer[i * numvar + j];
+      eco->Update(val);
+      eco->Simulate(0);  //dont print whilst optimising
+      recvbuffer[i] = eco->getLikelihood();
+    }
+    MPI_Send(recvbuffer, num, MPI_DOUBLE, 0, RESULTTAG, MPI_COMM_WORLD);
+  }
+}
@@ -0,0 +1,286 @@
+#include "optcheckpoint.h"
+#include "ecosystem.h"
+#include "errorhandler.h"
+#include "global.h"
+#include <iterator>
+
+extern Ecosystem* EcoSystem;
+
+static const char checkpointheader[] = "gadgetcheckpoint";
+static const int checkpointversion = 1;
+
+char* OptCheckpoint::outfilename = NULL;
+int OptCheckpoint::interval = 0;
+time_t OptCheckpoint::lasttime = 0;
+unsigned long OptCheckpoint::checksum = 0;
+int OptCheckpoint::numvariables = 0;
+int OptCheckpoint::numoptimisations = 0;
+int OptCheckpoint::current = 0;
+int OptCheckpoint::restart = -1;
+int OptCheckpoint::pending = 0;
+OptCheckpoint::TransferMode OptCheckpoint::mode = OptCheckpoint::NONE;
+vector<char> OptCheckpoint::startbuffer;
+vector<char> OptCheckpoint::buffer;
+vector<char> OptCheckpoint::restorebuffer;
+unsigned int OptCheckpoint::position = 0;
+unsigned int OptCheckpoint::startposition = 0;
+int OptCheckpoint::numrandom = 0;
+int OptCheckpoint::lastrandom = 0;
+
+void OptCheckpoint::setFile(const char* filename, int seconds, unsigned long sum, int numvar, int numopt) {
+  if (outfilename != NULL)
+    delete[] outfilename;
+  outfilename = new char[strlen(filename) + 1];
+  strcpy(outfilename, filename);
+  interval = seconds;
+  checksum = sum;
+  numvariables = numvar;
+  numoptimisations = numopt;
+  time(&lasttime);
+}
+
+void OptCheckpoint::readFile(const char* filename, unsigned long sum, int numvar, int numopt) {
+  int version, filevar, fileopt;
+  unsigned long filesum;
+  char text[sizeof(checkpointheader)];
+  strncpy(text, "", sizeof(checkpointheader));
+
+  ifstream infile;
+  infile.open(filename, ios::in | ios::binary);
+  handle.checkIfFailure(infile, filename);
+  restorebuffer.assign(istreambuf_iterator<char>(infile), istreambuf_iterator<char>());
+  infile.close();
+  infile.clear();
+
+  mode = READ;
+  position = 0;
+  transferBytes(text, sizeof(checkpointheader) - 1);
+  if (strcmp(text, checkpointheader) != 0)
+    handle.logMessage(LOGFAIL, "Error in optcheckpoint - failed to read the checkpoint header from", filename);
+  Transfer(version);
+  if (version != checkpointversion)
+    handle.logMessage(LOGFAIL, "Error in optcheckpoint - unrecognised version of checkpoint file", filename);
+  transferBytes(&filesum, sizeof(unsigned long));
+  Transfer(filevar);
+  Transfer(fileopt);
+  if ((filesum != sum) || (filevar != numvar) || (fileopt != numopt))
+    handle.logMessage(LOGFAIL, "Error in optcheckpoint - the checkpoint file was created from a different model");
+  Transfer(restart);
+  if ((restart < 0) || (restart > numopt))
+    handle.logMessage(LOGFAIL, "Error in optcheckpoint - invalid optimisation algorithm in checkpoint file", filename);
+  startposition = position;
+  mode = NONE;
+  handle.logMessage(LOGMESSAGE, "Read optimisation checkpoint file - restarting optimisation algorithm", restart + 1);
+}
+
+int OptCheckpoint::startOptimisation(int opt) {
+  current = opt;
+  if (opt < restart)
+    return 0;  //JMB this optimisation algorithm had finished before the checkpoint was stored
+
+  if (opt == restart) {
+    mode = READ;
+    position = startposition;
+    EcoSystem->transferCheckpoint();
+    transferRandom();
+    Transfer(pending);
+    mode = NONE;
+    restart = -1;
+    if (!pending)
+      restorebuffer.clear();
+    handle.logMessage(LOGINFO, "\nRestarting the optimisation from the checkpoint file");
+  }
+
+  if (outfilename != NULL) {
+    mode = WRITE;
+    buffer.clear();
+    EcoSystem->transferCheckpoint();
+    transferRandom();
+    mode = NONE;
+    startbuffer = buffer;
+    //JMB dont overwrite a checkpoint that is part way through this optimisation
+    if (!pending)
+      writeFile(0);
+  }
+  return 1;
+}
+
+int OptCheckpoint::Start(int type) {
+  int filetype;
+  if (mode != NONE)
+    return 0;
+
+  if (pending) {
+    mode = READ;
+    Transfer(filetype);
+    if (filetype != type)
+      handle.logMessage(LOGFAIL, "Error in optcheckpoint - the checkpoint file was created from a different optimisation algorithm");
+    EcoSystem->transferCheckpoint();
+    transferRandom();
+    return 1;
+  }
+
+  if (outfilename == NULL)
+    return 0;
+  if (difftime(time(NULL), lasttime) < interval)
+    return 0;
+
+  mode = WRITE;
+  buffer.clear();
+  Transfer(type);
+  EcoSystem->transferCheckpoint();
+  transferRandom();
+  return 1;
+}
+
+void OptCheckpoint::Finish() {
+  if (mode == READ) {
+    if (position != restorebuffer.size())
+      handle.logMessage(LOGFAIL, "Error in optcheckpoint - failed to restore the state of the optimisation algorithm");
+    mode = NONE;
+    pending = 0;
+    restorebuffer.clear();
+    time(&lasttime);
+    handle.logMessage(LOGINFO, "Restored the state of the optimisation algorithm from the checkpoint file");
+
+  } else if (mode == WRITE) {
+    mode = NONE;
+    writeFile(1);
+  }
+}
+
+void OptCheckpoint::Discard() {
+  if (pending) {
+    handle.logMessage(LOGWARN, "Warning in optcheckpoint - cannot restore the state of this optimisation algorithm\nRestarting the optimisation algorithm from the beginning");
+    pending = 0;
+    restorebuffer.clear();
+  }
+}
+
+void OptCheckpoint::writeFile(int inopt) {
+  string tmpname(outfilename);
+  tmpname += ".tmp";
+
+  //JMB write to a temporary file first, so that the previous checkpoint
+  //file is kept if the optimisation is stopped while this is being written
+  ofstream outfile;
+  outfile.open(tmpname.c_str(), ios::out | ios::binary);
+  handle.checkIfFailure(outfile, tmpname.c_str());
+  outfile.write(checkpointheader, sizeof(checkpointheader) - 1);
+  outfile.write((const char*)&checkpointversion, sizeof(int));
+  outfile.write((const char*)&checksum, sizeof(unsigned long));
+  outfile.write((const char*)&numvariables, sizeof(int));
+  outfile.write((const char*)&numoptimisations, sizeof(int));
+  outfile.write((const char*)&current, sizeof(int));
+  if (startbuffer.size() > 0)
+    outfile.write(&startbuffer[0], startbuffer.size());
+  outfile.write((const char*)&inopt, sizeof(int));
+  if ((inopt) && (buffer.size() > 0))
+    outfile.write(&buffer[0], buffer.size());
+  outfile.close();
+  if (outfile.fail())
+    handle.logMessage(LOGWARN, "Warning in optcheckpoint - failed to write checkpoint file", tmpname.c_str());
+  else if (rename(tmpname.c_str(), outfilename) != 0)
+    handle.logMessage(LOGWARN, "Warning in optcheckpoint - failed to rename checkpoint file", tmpname.c_str());
+  outfile.clear();
+  time(&lasttime);
+}
+
+void OptCheckpoint::transferBytes(void* data, int num) {
+  if (mode == WRITE) {
+    buffer.insert(buffer.end(), (char*)data, (char*)data + num);
+
+  } else if (mode == READ) {
+    if (position + num > restorebuffer.size())
+      handle.logMessage(LOGFAIL, "Error in optcheckpoint - unexpected end of checkpoint file");
+    memcpy(data, &restorebuffer[position], num);
+    position += num;
+  }
+}
+
+void OptCheckpoint::Transfer(int& value) {
+  transferBytes(&value, sizeof(int));
+}
+
+void OptCheckpoint::Transfer(unsigned& value) {
+  transferBytes(&value, sizeof(unsigned));
+}
+
+void OptCheckpoint::Transfer(double& value) {
+  transferBytes(&value, sizeof(double));
+}
+
+void OptCheckpoint::Transfer(IntVector& vec) {
+  int i, size = vec.Size();
+  Transfer(size);
+  if ((mode == READ) && (size != vec.Size())) {
+    if (size > 0)
+      vec = IntVector(size, 0);
+    else
+      vec.Reset();
+  }
+  for (i = 0; i < size; i++)
+    Transfer(vec[i]);
+}
+
+void OptCheckpoint::Transfer(DoubleVector& vec) {
+  int i, size = vec.Size();
+  Transfer(size);
+  if ((mode == READ) && (size != vec.Size())) {
+    if (size > 0)
+      vec = DoubleVector(size, 0.0);
+    else
+      vec.Reset();
+  }
+  for (i = 0; i < size; i++)
+    Transfer(vec[i]);
+}
+
+void OptCheckpoint::Transfer(DoubleMatrix& mat) {
+  int i, nrow = mat.Nrow();
+  int ncol = (nrow > 0 ? mat.Ncol() : 0);
+  Transfer(nrow);
+  Transfer(ncol);
+  if ((mode == READ) && ((nrow != mat.Nrow()) || ((nrow > 0) && (ncol != mat.Ncol())))) {
+    if (nrow > 0)
+      mat = DoubleMatrix(nrow, ncol, 0.0);
+    else
+      mat.Reset();
+  }
+  for (i = 0; i < nrow; i++)
+    Transfer(mat[i]);
+}
+
+void OptCheckpoint::Transfer(PopulationMatrix& mat) {
+  int i, nrow = mat.Nrow();
+  int ncol = (nrow > 0 ? mat.Ncol() : 0);
+  Transfer(nrow);
+  Transfer(ncol);
+  if ((mode == READ) && ((nrow != mat.Nrow()) || ((nrow > 0) && (ncol != mat.Ncol())))) {
+    mat.Reset();
+    mat.AddRows(nrow, ncol, 0.0);
+  }
+  for (i = 0; i < nrow; i++)
+    Transfer(mat[i]);
+}
+
+int OptCheckpoint::randomInteger() {
+  lastrandom = rand();
+  numrandom++;
+  return lastrandom;
+}
+
+void OptCheckpoint::transferRandom() {
+  int num = numrandom;
+  int last = lastrandom;
+  Transfer(num);
+  Transfer(last);
+  if (mode == READ) {
+    if (numrandom > num)
+      handle.logMessage(LOGWARN, "Warning in optcheckpoint - more random numbers have been used than when the checkpoint was stored");
+    while (numrandom < num)
+      randomInteger();
+    if ((numrandom == num) && (lastrandom != last))
+      handle.logMessage(LOGWARN, "Warning in optcheckpoint - the random number generator has been seeded with a different value\nThe restarted optimisation will not give the same results");
+  }
+}
@@ -5,7 +5,8 @@
 
 OptInfoBFGS::OptInfoBFGS()
   : OptInfo(), bfgsiter(10000), bfgseps(0.01), beta(0.3), sigma(0.01),
-    step(1.0), gradacc(1e-6), gradstep(0.5), gradeps(1e-10) {
+    step(1.0), gradacc(1e-6), gradstep(0.5), gradeps(1e-10),
+    parallel(0), numevals(0) {
   type = OPTBFGS;
   handle.logMessage(LOGMESSAGE, "Initialising BFGS optimisation algorithm");
 }
@@ -14,7 +15,7 @@ void OptInfoBFGS::read(CommentStream& infile, char* text) {
   handle.logMessage(LOGMESSAGE, "Reading BFGS optimisation parameters");
 
   int count = 0;
-  while (!infile.eof() && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]") && strcasecmp(text,"[pso]")) {
+  while (!infile.eof() && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]") && strcasecmp(text,"[pso]") && strcasecmp(text, "[DE]") && strcasecmp(text, "[surrogate]")) {
     infile >> ws;
     if (strcasecmp(text, "seed") == 0) {
       int seed = 0;
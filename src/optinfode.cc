@@ -5,7 +5,7 @@
 #include <cfloat>
 
 OptInfoDE::OptInfoDE()
-  : OptInfo(),  goal(1e-5), iter(100000) {
+  : OptInfo(),  goal(1e-5), iter(100000), steadystate(0) {
   type = OPTDE;
   handle.logMessage(LOGMESSAGE, "Initialising DE optimisation algorithm");
 }
@@ -14,7 +14,7 @@ void OptInfoDE::read(CommentStream& infile, char* text) {
   handle.logMessage(LOGMESSAGE, "Reading PSO optimisation parameters");
 
   int count = 0;
-  while (!infile.eof() && strcasecmp(text, "[PSO]") && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[DE]")) {
+  while (!infile.eof() && strcasecmp(text, "[PSO]") && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[DE]") && strcasecmp(text, "[surrogate]")) {
     infile >> ws;
     if (strcasecmp(text, "seed") == 0) {
       int s = 0;
@@ -29,6 +29,10 @@ void OptInfoDE::read(CommentStream& infile, char* text) {
       infile >> goal;
       count++;
 
+    } else if (strcasecmp(text, "steadystate") == 0) {
+      infile >> steadystate;
+      count++;
+
     } else {
       handle.logMessage(LOGINFO, "Warning in optinfofile - unrecognised option", text);
       infile >> text;  //read and ignore the next entry
@@ -36,6 +40,10 @@ void OptInfoDE::read(CommentStream& infile, char* text) {
     infile >> text;
   }
 
+  if (steadystate != 0 && steadystate != 1) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of steadystate outside bounds", steadystate);
+    steadystate = 0;
+  }
 }
 
 void OptInfoDE::Print(ofstream& outfile, int prec) {
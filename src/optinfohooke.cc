@@ -5,7 +5,7 @@
 #include <cfloat>
 
 OptInfoHooke::OptInfoHooke()
-  : OptInfo(), hookeiter(1000), rho(0.5), lambda(0.0), hookeeps(1e-4), bndcheck(0.9999) {
+  : OptInfo(), hookeiter(1000), rho(0.5), lambda(0.0), hookeeps(1e-4), bndcheck(0.9999), linesearch(0) {
   type = OPTHOOKE;
   handle.logMessage(LOGMESSAGE, "Initialising Hooke & Jeeves optimisation algorithm");
 }
@@ -15,7 +15,7 @@ void OptInfoHooke::read(CommentStream& infile, char* text) {
 
   int count = 0;
 
-  while (!infile.eof() && strcasecmp(text,"[pso]")  && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]")) {
+  while (!infile.eof() && strcasecmp(text,"[pso]")  && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[DE]") && strcasecmp(text, "[surrogate]")) {
     infile >> ws;
     if (strcasecmp(text, "seed") == 0) {
       int seed = 0;
@@ -43,6 +43,10 @@ void OptInfoHooke::read(CommentStream& infile, char* text) {
       infile >> bndcheck;
       count++;
 
+    } else if (strcasecmp(text, "linesearch") == 0) {
+      infile >> linesearch;
+      count++;
+
     } else {
       handle.logMessage(LOGINFO, "Warning in optinfofile - unrecognised option", text);
       infile >> text;  //read and ignore the next entry
@@ -70,6 +74,10 @@ void OptInfoHooke::read(CommentStream& infile, char* text) {
     handle.logMessage(LOGINFO, "Warning in optinfofile - value of hookeeps outside bounds", hookeeps);
     hookeeps = 1e-4;
   }
+  if (linesearch != 0 && linesearch != 1) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of linesearch outside bounds", linesearch);
+    linesearch = 0;
+  }
 }
 
 void OptInfoHooke::Print(ofstream& outfile, int prec) {
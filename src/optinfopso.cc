@@ -5,7 +5,7 @@
 #include <cfloat>
 
 OptInfoPso::OptInfoPso()
-  : OptInfo(),  goal(1e-5), psoiter(100000) {
+  : OptInfo(),  goal(1e-5), psoiter(100000), steadystate(0) {
   type = OPTPSO;
   handle.logMessage(LOGMESSAGE, "Initialising PSO optimisation algorithm");
 }
@@ -14,7 +14,7 @@ void OptInfoPso::read(CommentStream& infile, char* text) {
   handle.logMessage(LOGMESSAGE, "Reading PSO optimisation parameters");
 
   int count = 0;
-  while (!infile.eof() && strcasecmp(text, "[PSO]") && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[DE]")) {
+  while (!infile.eof() && strcasecmp(text, "[PSO]") && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[DE]") && strcasecmp(text, "[surrogate]")) {
     infile >> ws;
     if (strcasecmp(text, "seed") == 0) {
       int s = 0;
@@ -30,6 +30,10 @@ void OptInfoPso::read(CommentStream& infile, char* text) {
       infile >> goal;
       count++;
 
+    } else if (strcasecmp(text, "steadystate") == 0) {
+      infile >> steadystate;
+      count++;
+
     } else {
       handle.logMessage(LOGINFO, "Warning in optinfofile - unrecognised option", text);
       infile >> text;  //read and ignore the next entry
@@ -37,6 +41,10 @@ void OptInfoPso::read(CommentStream& infile, char* text) {
     infile >> text;
   }
 
+  if (steadystate != 0 && steadystate != 1) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of steadystate outside bounds", steadystate);
+    steadystate = 0;
+  }
 }
 
 void OptInfoPso::Print(ofstream& outfile, int prec) {
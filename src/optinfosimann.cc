@@ -6,7 +6,8 @@
 
 OptInfoSimann::OptInfoSimann()
   : OptInfo(), rt(0.85), simanneps(1e-4), ns(5), nt(2), t(100.0), cs(2.0),
-    vminit(1.0), simanniter(2000), uratio(0.7), lratio(0.3), tempcheck(4), scale(0) {
+    vminit(1.0), simanniter(2000), uratio(0.7), lratio(0.3), tempcheck(4), scale(0),
+    chains(0), tempratio(2.0) {
   type = OPTSIMANN;
   handle.logMessage(LOGMESSAGE, "Initialising Simulated Annealing optimisation algorithm");
 }
@@ -19,7 +20,7 @@ void OptInfoSimann::read(CommentStream& infile, char* text) {
   unsigned s3 = 0;
 
   int count = 0;
-  while (!infile.eof() && strcasecmp(text,"[pso]") && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]")) {
+  while (!infile.eof() && strcasecmp(text,"[pso]") && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]") && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[DE]") && strcasecmp(text, "[surrogate]")) {
     infile >> ws;
     if (strcasecmp(text, "seed") == 0) {
       int s = 0;
@@ -87,6 +88,14 @@ void OptInfoSimann::read(CommentStream& infile, char* text) {
     } else if (strcasecmp(text, "scale") == 0) {
       infile >> scale;
       count++;
+
+    } else if (strcasecmp(text, "chains") == 0) {
+      infile >> chains;
+      count++;
+
+    } else if (strcasecmp(text, "tempratio") == 0) {
+      infile >> tempratio;
+      count++;
     } else {
       handle.logMessage(LOGINFO, "Warning in optinfofile - unrecognised option", text);
       infile >> text;  //read and ignore the next entry
@@ -157,6 +166,14 @@ void OptInfoSimann::read(CommentStream& infile, char* text) {
     handle.logMessage(LOGINFO, "Warning in optinfofile - value of scale outside bounds", scale);
     scale = 0;
   }
+  if ((chains < 0) || (chains == 1)) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of chains outside bounds", chains);
+    chains = 0;
+  }
+  if (tempratio < 1.0 + rathersmall) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of tempratio outside bounds", tempratio);
+    tempratio = 2.0;
+  }
 }
 
 void OptInfoSimann::Print(ofstream& outfile, int prec) {
@@ -0,0 +1,118 @@
+#include "optinfo.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+#include <cfloat>
+
+OptInfoSurrogate::OptInfoSurrogate()
+  : OptInfo(), surrogateiter(1000), surrogateeps(1e-4), radius(0.1), rho(0.5),
+    batchsize(4), maxpoints(200), quadratic(1), succtol(3), failtol(0) {
+  type = OPTSURROGATE;
+  handle.logMessage(LOGMESSAGE, "Initialising Surrogate optimisation algorithm");
+}
+
+void OptInfoSurrogate::read(CommentStream& infile, char* text) {
+  handle.logMessage(LOGMESSAGE, "Reading Surrogate optimisation parameters");
+
+  int count = 0;
+  while (!infile.eof() && strcasecmp(text, "[pso]") && strcasecmp(text, "[simann]") && strcasecmp(text, "[hooke]")
+      && strcasecmp(text, "[bfgs]") && strcasecmp(text, "[DE]") && strcasecmp(text, "[surrogate]")) {
+    infile >> ws;
+    if (strcasecmp(text, "seed") == 0) {
+      int s = 0;
+      infile >> s >> ws;
+      handle.logMessage(LOGMESSAGE, "Initialising random number generator with", s);
+      srand(s);
+
+    } else if (strcasecmp(text, "surrogateiter") == 0) {
+      infile >> surrogateiter;
+      count++;
+
+    } else if (strcasecmp(text, "surrogateeps") == 0) {
+      infile >> surrogateeps;
+      count++;
+
+    } else if (strcasecmp(text, "radius") == 0) {
+      infile >> radius;
+      count++;
+
+    } else if (strcasecmp(text, "rho") == 0) {
+      infile >> rho;
+      count++;
+
+    } else if (strcasecmp(text, "batchsize") == 0) {
+      infile >> batchsize;
+      count++;
+
+    } else if (strcasecmp(text, "maxpoints") == 0) {
+      infile >> maxpoints;
+      count++;
+
+    } else if (strcasecmp(text, "quadratic") == 0) {
+      infile >> quadratic;
+      count++;
+
+    } else if (strcasecmp(text, "succtol") == 0) {
+      infile >> succtol;
+      count++;
+
+    } else if (strcasecmp(text, "failtol") == 0) {
+      infile >> failtol;
+      count++;
+
+    } else {
+      handle.logMessage(LOGINFO, "Warning in optinfofile - unrecognised option", text);
+      infile >> text;  //read and ignore the next entry
+    }
+    infile >> text;
+  }
+
+  if (count == 0)
+    handle.logMessage(LOGINFO, "Warning - no parameters specified for Surrogate optimisation algorithm");
+
+  //check the values specified in the optinfo file ...
+  if ((radius < rathersmall) || (radius > 0.5)) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of radius outside bounds", radius);
+    radius = 0.1;
+  }
+  if ((rho < rathersmall) || (rho > 1.0 - rathersmall)) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of rho outside bounds", rho);
+    rho = 0.5;
+  }
+  if (surrogateeps < rathersmall) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of surrogateeps outside bounds", surrogateeps);
+    surrogateeps = 1e-4;
+  }
+  if (batchsize < 1) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of batchsize outside bounds", batchsize);
+    batchsize = 4;
+  }
+  if (maxpoints < 10) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of maxpoints outside bounds", maxpoints);
+    maxpoints = 200;
+  }
+  if (quadratic != 0 && quadratic != 1) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of quadratic outside bounds", quadratic);
+    quadratic = 1;
+  }
+  if (succtol < 1) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of succtol outside bounds", succtol);
+    succtol = 3;
+  }
+  if (failtol < 0) {
+    handle.logMessage(LOGINFO, "Warning in optinfofile - value of failtol outside bounds", failtol);
+    failtol = 0;
+  }
+}
+
+void OptInfoSurrogate::Print(ofstream& outfile, int prec) {
+  outfile << "; Surrogate algorithm ran for " << iters
+    << " function evaluations\n; and stopped when the likelihood value was "
+    << setprecision(prec) << score;
+  if (converge == -1)
+    outfile << "\n; because an error occured during the optimisation\n";
+  else if (converge == 1)
+    outfile << "\n; because the convergence criteria were met\n";
+  else
+    outfile << "\n; because the maximum number of function evaluations was reached\n";
+}
@@ -6,6 +6,7 @@
 #include "intvector.h"
 #include "popinfo.h"
 #include "popinfovector.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -15,7 +16,7 @@ OtherFood::OtherFood(CommentStream& infile, const char* givenname,
 
   char text[MaxStrLength];
   strncpy(text, "", MaxStrLength);
-  ifstream subfile;
+  ModelFile subfile;
   CommentStream subcomment(subfile);
   int tmpint = 0;
   IntVector tmpareas;
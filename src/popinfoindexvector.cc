@@ -2,6 +2,7 @@
 #include "gadget.h"
 
 PopInfoIndexVector::PopInfoIndexVector(int sz, int minp) {
+  ownsdata = 1;
   size = (sz > 0 ? sz : 0);
   minpos = minp;
   if (size > 0)
@@ -11,6 +12,7 @@ PopInfoIndexVector::PopInfoIndexVector(int sz, int minp) {
 }
 
 PopInfoIndexVector::PopInfoIndexVector(int sz, int minp, PopInfo value) {
+  ownsdata = 1;
   size = (sz > 0 ? sz : 0);
   minpos = minp;
   int i;
@@ -23,6 +25,7 @@ PopInfoIndexVector::PopInfoIndexVector(int sz, int minp, PopInfo value) {
 }
 
 PopInfoIndexVector::PopInfoIndexVector(const PopInfoIndexVector& initial) {
+  ownsdata = 1;
   size = initial.size;
   minpos = initial.minpos;
   int i;
@@ -35,12 +38,21 @@ PopInfoIndexVector::PopInfoIndexVector(const PopInfoIndexVector& initial) {
 }
 
 PopInfoIndexVector::~PopInfoIndexVector() {
-  if (v != 0) {
+  if ((v != 0) && (ownsdata)) {
     delete[] v;
     v = 0;
   }
 }
 
+void PopInfoIndexVector::setStorage(int sz, int newminpos, PopInfo* storage) {
+  if ((v != 0) && (ownsdata))
+    delete[] v;
+  size = (sz > 0 ? sz : 0);
+  minpos = newminpos;
+  v = (size > 0 ? storage : 0);
+  ownsdata = 0;
+}
+
 void PopInfoIndexVector::resize(int addsize, int lower, PopInfo initial) {
   if (addsize <= 0)
     return;
@@ -49,6 +61,7 @@ void PopInfoIndexVector::resize(int addsize, int lower, PopInfo initial) {
   if (v == 0) {
     size = addsize;
     minpos = lower;
+    ownsdata = 1;
     v = new PopInfo[size];
     for (i = 0; i < size; i++)
       v[i] = initial;
@@ -57,7 +70,10 @@ void PopInfoIndexVector::resize(int addsize, int lower, PopInfo initial) {
     PopInfo* vnew = new PopInfo[size + addsize];
     for (i = 0; i < size; i++)
       vnew[i + minpos - lower] = v[i];
-    delete[] v;
+    //JMB if the storage was allocated elsewhere then the vector now has its own copy
+    if (ownsdata)
+      delete[] v;
+    ownsdata = 1;
     v = vnew;
     for (i = size; i < size + addsize; i++)
       v[i] = initial;
@@ -0,0 +1,112 @@
+#include "populationmatrix.h"
+#include "gadget.h"
+
+//JMB each row starts on a cache line of 64 bytes
+static const int rowalign = 8;
+
+/**
+ * \class PopulationRow
+ * \brief This is a DoubleVector that uses part of the block of memory allocated by a PopulationMatrix
+ */
+class PopulationRow : public DoubleVector {
+public:
+  PopulationRow(double* data, int sz) { v = data; size = sz; };
+  ~PopulationRow() { v = 0; size = 0; };
+  void setData(double* data) { v = data; };
+};
+
+PopulationMatrix::PopulationMatrix()
+  : DoubleMatrix(), ncol(0), stride(0), capacity(0), memory(0), block(0) {
+}
+
+PopulationMatrix::PopulationMatrix(int nr, int nc, double value)
+  : DoubleMatrix(), ncol(0), stride(0), capacity(0), memory(0), block(0) {
+  this->AddRows(nr, nc, value);
+}
+
+PopulationMatrix::PopulationMatrix(const PopulationMatrix& initial)
+  : DoubleMatrix(), ncol(0), stride(0), capacity(0), memory(0), block(0) {
+  int i;
+  this->AddRows(initial.nrow, initial.ncol, 0.0);
+  for (i = 0; i < nrow; i++)
+    (*v[i]) = initial[i];
+}
+
+PopulationMatrix::~PopulationMatrix() {
+  this->Reset();
+}
+
+void PopulationMatrix::setCapacity(int newcapacity) {
+  int i, j;
+  double* newmemory = new double[newcapacity * stride + rowalign];
+  double* newblock = newmemory;
+  while (((size_t)newblock) % (rowalign * sizeof(double)) != 0)
+    newblock++;
+
+  DoubleVector** vnew = new DoubleVector*[newcapacity];
+  for (i = 0; i < nrow; i++) {
+    for (j = 0; j < ncol; j++)
+      newblock[i * stride + j] = block[i * stride + j];
+    vnew[i] = v[i];
+    ((PopulationRow*)vnew[i])->setData(newblock + i * stride);
+  }
+
+  if (v != 0)
+    delete[] v;
+  if (memory != 0)
+    delete[] memory;
+  v = vnew;
+  memory = newmemory;
+  block = newblock;
+  capacity = newcapacity;
+}
+
+void PopulationMatrix::AddRows(int add, int length, double value) {
+  if (add <= 0)
+    return;
+
+  int i, j;
+  if (nrow == 0) {
+    ncol = length;
+    stride = ((length + rowalign - 1) / rowalign) * rowalign;
+  }
+
+  if (nrow + add > capacity)
+    this->setCapacity(max(nrow + add, 2 * capacity));
+  for (i = nrow; i < nrow + add; i++) {
+    for (j = 0; j < ncol; j++)
+      block[i * stride + j] = value;
+    v[i] = new PopulationRow(block + i * stride, ncol);
+  }
+  nrow += add;
+}
+
+void PopulationMatrix::Reset() {
+  int i;
+  for (i = 0; i < nrow; i++)
+    delete (PopulationRow*)v[i];
+  if (v != 0)
+    delete[] v;
+  if (memory != 0)
+    delete[] memory;
+  v = 0;
+  nrow = 0;
+  memory = 0;
+  block = 0;
+  capacity = 0;
+  ncol = 0;
+  stride = 0;
+}
+
+PopulationMatrix& PopulationMatrix::operator = (const PopulationMatrix& d) {
+  int i;
+  if (this == &d)
+    return *this;
+  if ((nrow != d.nrow) || (ncol != d.ncol)) {
+    this->Reset();
+    this->AddRows(d.nrow, d.ncol, 0.0);
+  }
+  for (i = 0; i < nrow; i++)
+    (*v[i]) = d[i];
+  return *this;
+}
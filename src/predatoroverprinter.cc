@@ -7,6 +7,7 @@
 #include "readaggregation.h"
 #include "errorhandler.h"
 #include "predator.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "runid.h"
 #include "global.h"
@@ -36,7 +37,7 @@ PredatorOverPrinter::PredatorOverPrinter(CommentStream& infile, const TimeClass*
   //read in area aggregation from file
   filename = new char[MaxStrLength];
   strncpy(filename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   infile >> filename >> ws;
@@ -6,6 +6,7 @@
 #include "errorhandler.h"
 #include "predator.h"
 #include "stockprey.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "runid.h"
 #include "global.h"
@@ -46,7 +47,7 @@ PredatorPreyPrinter::PredatorPreyPrinter(CommentStream& infile, const TimeClass*
   //read in area aggregation from file
   filename = new char[MaxStrLength];
   strncpy(filename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   infile >> filename >> ws;
@@ -8,6 +8,7 @@
 #include "errorhandler.h"
 #include "predator.h"
 #include "prey.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "runid.h"
 #include "global.h"
@@ -52,7 +53,7 @@ PredatorPrinter::PredatorPrinter(CommentStream& infile, const TimeClass* const T
   //read in area aggregation from file
   filename = new char[MaxStrLength];
   strncpy(filename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   infile >> filename >> ws;
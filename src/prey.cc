@@ -4,6 +4,7 @@
 #include "readaggregation.h"
 #include "keeper.h"
 #include "mathfunc.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -20,7 +21,7 @@ Prey::Prey(CommentStream& infile, const IntVector& Areas,
   CharPtrVector preylenindex;
   char aggfilename[MaxStrLength];
   strncpy(aggfilename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   readWordAndValue(infile, "preylengths", aggfilename);
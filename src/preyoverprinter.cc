@@ -7,6 +7,7 @@
 #include "readaggregation.h"
 #include "errorhandler.h"
 #include "prey.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "runid.h"
 #include "global.h"
@@ -36,7 +37,7 @@ PreyOverPrinter::PreyOverPrinter(CommentStream& infile, const TimeClass* const T
   //read in area aggregation from file
   filename = new char[MaxStrLength];
   strncpy(filename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   infile >> filename >> ws;
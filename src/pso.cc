@@ -17,9 +17,12 @@
 #include "intvector.h"
 #include "errorhandler.h"
 #include "ecosystem.h"
+#include "evaluationengine.h"
 #include "global.h"
 #include <float.h>
 #include "runid.h"
+#include "populationmatrix.h"
+#include "randomstream.h"
 
 #ifdef _OPENMP
 #include "omp.h"
@@ -51,20 +54,19 @@ void OptInfoPso::OptimiseLikelihood() {
 // SOLVER
     printf("SOLVER PSO\n");
     size= (int) (nvars);
-    DoubleMatrix pos(size, nvars, 0.0);    // position matrix
-    DoubleMatrix vel(size, nvars, 0.0);    // velocity matrix
-    DoubleMatrix pos_new(size, nvars, 0.0);  // new population
-    DoubleMatrix pos_b(size, nvars, 0.0);  // best position matrix
+    PopulationMatrix pos(size, nvars, 0.0);    // position matrix
+    PopulationMatrix vel(size, nvars, 0.0);    // velocity matrix
+    PopulationMatrix pos_new(size, nvars, 0.0);  // new population
+    PopulationMatrix pos_b(size, nvars, 0.0);  // best position matrix
     DoubleVector fit(size); // particle fitness vector
     DoubleVector fit_b(size); // best fitness vector
-    DoubleMatrix gbest(size, nvars, 0.0); // what is the best informed position for each particle
+    PopulationMatrix gbest(size, nvars, 0.0); // what is the best informed position for each particle
     IntMatrix comm(size, size, 0); // communications:who informs who rows : those who inform cols : those who are informed
     int improved; // whether solution->error was improved during the last iteration
     int d, step, index_del;
-    int p1,p2,p3,p4;
-    double prob;
     double dist;
     double a, b;
+    unsigned key; // key for the random numbers used in each iteration
     double rho1, rho2; //random numbers (coefficients)
     double w; //current omega
     Inform_fun inform_fun;
@@ -149,37 +151,19 @@ void OptInfoPso::OptimiseLikelihood() {
         bestx = pos[i];
         best.index=i;
     }
-    // REPO
-    double ***rand;
-    rand = (double ***) calloc(size,sizeof(double **));
-    for (i = 0; i < size; i++) {
-	rand[i] = (double **) calloc(nvars,sizeof(double *)); 
-        for (d = 0; d < nvars; d++) rand[i][d] = (double *) calloc(2,sizeof(double));
-    }
-	
-    double **randDE;
-    randDE = (double **) calloc(size,sizeof(double *));
-    for (i=0; i< size; i++)
-	randDE[i] = (double *) calloc(nvars+4,sizeof(double));
-
-    for (i = 1; i < size; i++) {
-	for (d = 0; d < nvars; d++) {
-		rand[i][d][0] = rand_r(&seed);
-                rand[i][d][1] = rand_r(&seed);
-	}
-    }
-
-    // REPO
+    //JMB the random numbers for each particle are calculated from its own stream
+    key = rand_r(&seed);
 
     for (i = 1; i < size; i++) {
         ostringstream spos, svel;
         spos << "Initial position of particle " << i << " [";
         svel << "Initial velocity of particle " << i << " [";
+        RandomStream rs(key, i);
         // for each dimension
         for (d = 0; d < nvars; d++) {
             // generate two numbers within the specified range and around trialx
-            a = lowerb[d] + (upperb[d] - lowerb[d]) * (rand[i][d][0] * 1.0 / RAND_MAX);
-            b = lowerb[d] + (upperb[d] - lowerb[d]) * (rand[i][d][1] * 1.0 / RAND_MAX);
+            a = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
+            b = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
 
             // initialize position
             pos[i][d] = a;
@@ -211,6 +195,24 @@ void OptInfoPso::OptimiseLikelihood() {
 // RUN ALGORITHM
     psosteps = 0;
     while (1) {
+        //JMB store or restore the state of the optimisation at the start of each iteration
+        if (OptCheckpoint::Start(OPTPSO)) {
+          this->transferState();
+          OptCheckpoint::Transfer(pos);
+          OptCheckpoint::Transfer(vel);
+          OptCheckpoint::Transfer(pos_new);
+          OptCheckpoint::Transfer(pos_b);
+          OptCheckpoint::Transfer(gbest);
+          OptCheckpoint::Transfer(fit);
+          OptCheckpoint::Transfer(fit_b);
+          OptCheckpoint::Transfer(bestx);
+          OptCheckpoint::Transfer(best.bestf);
+          OptCheckpoint::Transfer(best.index);
+          OptCheckpoint::Transfer(psosteps);
+          OptCheckpoint::Transfer(offset);
+          OptCheckpoint::Finish();
+        }
+
         if (isZero(best.bestf)) {
             iters=0;
             for (d = 0; d < numThr; d++)
@@ -267,24 +269,6 @@ void OptInfoPso::OptimiseLikelihood() {
            		vel.AddRows(growth_popul, nvars, 0.0);
            		fit.resize(growth_popul, 0.0);
            		fit_b.resize(growth_popul, 0.0);
-			if (growth_popul < 0 ) {
-           			for (i = size; i < size+growth_popul; i++) {
-           			    for (d = 0; d < nvars; d++) cfree(rand[i][d]);
-               			    cfree(rand[i]);
-				    cfree(randDE[i]);
-           			}
-           			rand   = (double ***) realloc(rand,(size+growth_popul)*sizeof(double));
-				randDE = (double **)  realloc(randDE, (size+growth_popul)*sizeof(double));
-			} else {
-	                	rand = (double ***) realloc(rand,(size+growth_popul)*sizeof(double));
-                                randDE = (double **)  realloc(randDE, (size+growth_popul)*sizeof(double));
-	                	for (i = size; i < size+growth_popul; i++) {
-	                	      rand[i]   = (double **) calloc(nvars,sizeof(double *));
-				      randDE[i] = (double *)  calloc(nvars+4 ,sizeof(double));
-	                	      for (d = 0; d < nvars; d++) rand[i][d] = (double *) calloc(2,sizeof(double));
-	                	}
-			}
-		
 		}
 			
 		if (nrestarts == 1 ) {
@@ -293,19 +277,14 @@ void OptInfoPso::OptimiseLikelihood() {
 		else if (nrestarts == 0 ) {
 			init_reset=size;
 		}
-			
-           	for (i = init_reset; i < (size+growth_popul); i++) {
-                	for (d = 0; d < nvars; d++) {
-                       		rand[i][d][0] = (rand_r(&seed) * 1.0) / RAND_MAX;
-                       		rand[i][d][1] = (rand_r(&seed) * 1.0) / RAND_MAX;
-                	}
-           	}
+		key = rand_r(&seed);
 
 
            	for (i=init_reset;i<(size+growth_popul);i++){
+	             RandomStream rs(key, i);
 	             for (d = 0; d < nvars; d++) {
-                        	a = lowerb[d] + (upperb[d] - lowerb[d]) * rand[i][d][0];
-                        	b = lowerb[d] + (upperb[d] - lowerb[d]) * rand[i][d][1];
+                        	a = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
+                        	b = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
 	                	pos[i][d]   = a ;
 	                	pos_b[i][d] = a ;
 	                	vel[i][d]   = (a - b) / 2.;
@@ -317,38 +296,19 @@ void OptInfoPso::OptimiseLikelihood() {
            	growth_popul=0;
 		STATE=0;
 	}
-	// RANDOM NUMBER FOR THE CASE OF PSO
-        for (i = 0; i < size; i++) {
-		p1 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-		do  
-			p2 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-		while (p2 == p1);
-                do 
-                        p3 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-                while ((p3 == p1) || (p3 == p2));
-                do 
-                        p4 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-                while ((p4 == p3) || (p4 == p2) || (p4 == p1));
-		randDE[i][0]= (double) p1;
-                randDE[i][1]= (double) p2;
-                randDE[i][2]= (double) p3;
-                randDE[i][3]= (double) p4;
-		for (d = 0; d < nvars; d++) {
-			rand[i][d][0] = (rand_r(&seed) * 1.0) / RAND_MAX;
-			rand[i][d][1] = (rand_r(&seed) * 1.0) / RAND_MAX;
-	                randDE[i][d+4]= (rand_r(&seed) * 1.0) / RAND_MAX;
-		}		
-        }
+        //JMB the random numbers for each particle are calculated from its own stream
+        key = rand_r(&seed);
 
         for (i = 0; i < size; i++) {
             ostringstream spos, svel;
             spos << "New position of particle " << i << " [";
             svel << "New velocity of particle " << i << " [";
+            RandomStream rs(key, i);
 		// CASE 1: PSO ALGORITHM. for each dimension 
 		for (d = 0; d < nvars; d++) {
        		       // calculate stochastic coefficients
-			rho1 = c1 * rand[i][d][0] ;
-			rho2 = c2 * rand[i][d][1] ;
+			rho1 = c1 * rs.Uniform();
+			rho2 = c2 * rs.Uniform();
                 	// update velocity
 			vel[i][d] = w * vel[i][d] + rho1 * (pos_b[i][d] - pos[i][d]) + rho2 * (gbest[i][d] - pos[i][d]);
 			pos[i][d] =  pos[i][d] + vel[i][d];
@@ -407,15 +367,6 @@ void OptInfoPso::OptimiseLikelihood() {
 	psosteps++;
     } // while (newf < bestf)
     
-    for (i = 0; i < size; i++) {
-		for ( d = 0; d < nvars; d ++ ) {
-			cfree(rand[i][d]);
-		}
-		cfree(rand[i]);
-		cfree(randDE[i]);
-    }
-    cfree(rand);
-    cfree(randDE);
 	
     iters=0;
     for (d = 0; d < numThr; d++) 
@@ -469,20 +420,19 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
 
 // SOLVER
     size= (int) (nvars); 
-    DoubleMatrix pos(size, nvars, 0.0);    // position matrix
-    DoubleMatrix vel(size, nvars, 0.0);    // velocity matrix
-    DoubleMatrix pos_new(size, nvars, 0.0);  // new population
-    DoubleMatrix pos_b(size, nvars, 0.0);  // best position matrix
+    PopulationMatrix pos(size, nvars, 0.0);    // position matrix
+    PopulationMatrix vel(size, nvars, 0.0);    // velocity matrix
+    PopulationMatrix pos_new(size, nvars, 0.0);  // new population
+    PopulationMatrix pos_b(size, nvars, 0.0);  // best position matrix
     DoubleVector fit(size); // particle fitness vector
     DoubleVector fit_b(size); // best fitness vector
-    DoubleMatrix gbest(size, nvars, 0.0); // what is the best informed position for each particle
+    PopulationMatrix gbest(size, nvars, 0.0); // what is the best informed position for each particle
     IntMatrix comm(size, size, 0); // communications:who informs who rows : those who inform cols : those who are informed
     int improved; // whether solution->error was improved during the last iteration
     int d, step, index_del;
-    int p1,p2,p3,p4;
-    double prob;
     double dist;
     double a, b;
+    unsigned key; // key for the random numbers used in each iteration
     double rho1, rho2; //random numbers (coefficients)
     double w; //current omega
     Inform_fun inform_fun;
@@ -530,7 +480,7 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
             }
      }
 
-    best.bestf = EcoSystems[0]->SimulateAndUpdate(x);
+    best.bestf = EvaluationEngine::Evaluate(x);
     best.index = 0;
 
     if (best.bestf != best.bestf) { //check for NaN
@@ -541,7 +491,7 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
     }
 
 
-    offset = EcoSystems[0]->getFuncEval(); //number of function evaluations done before loop
+    offset = EvaluationEngine::numEvaluations(); //number of function evaluations done before loop
     iters = 0;
 
 // Initialize the particles
@@ -560,7 +510,7 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
         b = lowerb[d] + (upperb[d] - lowerb[d]) * (rand_r(&seed) * 1.0 / RAND_MAX);
         vel[i][d] = (a - b) / 2.;
     }
-    fit[i] = EcoSystems[0]->SimulateAndUpdate(pos[i]);
+    fit[i] = EvaluationEngine::Evaluate(pos[i]);
 
 
     fit_b[i] = fit[i]; // this is also the personal best
@@ -571,38 +521,20 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
     }
 
 
-    // REPO
-    double ***rand;
-    rand = (double ***) calloc(size,sizeof(double **));
-    for (i = 0; i < size; i++) {
-	rand[i] = (double **) calloc(nvars,sizeof(double *)); 
-        for (d = 0; d < nvars; d++) rand[i][d] = (double *) calloc(2,sizeof(double));
-    }
-	
-    double **randDE;
-    randDE = (double **) calloc(size,sizeof(double *));
-    for (i=0; i< size; i++)
-	randDE[i] = (double *) calloc(nvars+4,sizeof(double));
-
-    for (i = 1; i < size; i++) {
-	for (d = 0; d < nvars; d++) {
-		rand[i][d][0] = rand_r(&seed);
-                rand[i][d][1] = rand_r(&seed);
-	}
-    }
-
-    // REPO
+    //JMB the random numbers for each particle are calculated from its own stream
+    key = rand_r(&seed);
 
 #pragma omp parallel for default(shared) private(i,d,a,b) schedule(dynamic,1)
     for (i = 1; i < size; i++) {
         ostringstream spos, svel;
         spos << "Initial position of particle " << i << " [";
         svel << "Initial velocity of particle " << i << " [";
+        RandomStream rs(key, i);
         // for each dimension
         for (d = 0; d < nvars; d++) {
             // generate two numbers within the specified range and around trialx
-            a = lowerb[d] + (upperb[d] - lowerb[d]) * (rand[i][d][0] * 1.0 / RAND_MAX);
-            b = lowerb[d] + (upperb[d] - lowerb[d]) * (rand[i][d][1] * 1.0 / RAND_MAX);
+            a = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
+            b = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
 
             // initialize position
             pos[i][d] = a;
@@ -614,8 +546,8 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
             spos << pos[i][d] << " ";
             svel << vel[i][d] << " ";
         }
-        fit[i] = EcoSystems[omp_get_thread_num ()]->SimulateAndUpdate(pos[i]);
      }
+     EvaluationEngine::Evaluate(pos, fit, 1, size);
 
      for (i = 1; i < size; i++) {
         fit_b[i] = fit[i]; // this is also the personal best
@@ -634,12 +566,35 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
 // RUN ALGORITHM
     psosteps = 0;
 
+    //JMB the steady state search updates the swarm as soon as each particle has been evaluated
+    if ((steadystate) && (EcoSystem->runDistributed()))
+        handle.logMessage(LOGWARN, "Warning in PSO - steady state search not available with distributed function evaluations");
+    else if (steadystate) {
+        this->steadyState(pos, vel, pos_b, fit, fit_b, bestx, best.bestf, best.index, lowerb, upperb, init, psosteps, offset, calc_inertia_fun);
+        return;
+    }
+
     while (1) {
+        //JMB store or restore the state of the optimisation at the start of each iteration
+        if (OptCheckpoint::Start(OPTPSO)) {
+          this->transferState();
+          OptCheckpoint::Transfer(pos);
+          OptCheckpoint::Transfer(vel);
+          OptCheckpoint::Transfer(pos_new);
+          OptCheckpoint::Transfer(pos_b);
+          OptCheckpoint::Transfer(gbest);
+          OptCheckpoint::Transfer(fit);
+          OptCheckpoint::Transfer(fit_b);
+          OptCheckpoint::Transfer(bestx);
+          OptCheckpoint::Transfer(best.bestf);
+          OptCheckpoint::Transfer(best.index);
+          OptCheckpoint::Transfer(psosteps);
+          OptCheckpoint::Transfer(offset);
+          OptCheckpoint::Finish();
+        }
+
         if (isZero(best.bestf)) {
-            iters=0;
-            for (d = 0; d < numThr; d++)
-                 iters = iters + (EcoSystems[d]->getFuncEval());
-            iters= iters - offset;
+            iters = EvaluationEngine::numEvaluations() - offset;
 
             handle.logMessage(LOGINFO, "Error in PSO optimisation after", iters, "function evaluations, f(x) = 0");
             converge = -1;
@@ -647,17 +602,14 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
         }
         /* if too many function evaluations occur, terminate the algorithm */
         if (psosteps > psoiter) {
-            iters=0;
-            for (d = 0; d < numThr; d++)
-                 iters = iters + (EcoSystems[d]->getFuncEval());
-	    iters= iters - offset;
+            iters = EvaluationEngine::numEvaluations() - offset;
 
             handle.logMessage(LOGINFO, "\nStopping PSO optimisation algorithm\n");
             handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
             handle.logMessage(LOGINFO, "The optimisation stopped because the maximum number of PSO steps was reached");
             handle.logMessage(LOGINFO, "was reached and NOT because an optimum was found for this run");
 
-            score = EcoSystems[0]->SimulateAndUpdate(bestx);
+            score = EvaluationEngine::Evaluate(bestx);
             for (i = 0; i < nvars; i++)
                 bestx[i] = bestx[i] * init[i];
             handle.logMessage(LOGINFO, "\nPSO finished with a likelihood score of", score);
@@ -670,7 +622,7 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
         if (best.bestf <= goal) {
             handle.logMessage(LOGINFO, "\nStopping PSO optimisation algorithm\n");
             handle.logMessage(LOGINFO, "Goal achieved!!! @ step ", psosteps);
-            score = EcoSystems[0]->SimulateAndUpdate(bestx);
+            score = EvaluationEngine::Evaluate(bestx);
             handle.logMessage(LOGINFO, "\nPSO finished with a likelihood score of", score);
             break;
         }
@@ -693,24 +645,6 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
            		vel.AddRows(growth_popul, nvars, 0.0);
            		fit.resize(growth_popul, 0.0);
            		fit_b.resize(growth_popul, 0.0);
-			if (growth_popul < 0 ) {
-           			for (i = size; i < size+growth_popul; i++) {
-           			    for (d = 0; d < nvars; d++) cfree(rand[i][d]);
-               			    cfree(rand[i]);
-				    cfree(randDE[i]);
-           			}
-           			rand   = (double ***) realloc(rand,(size+growth_popul)*sizeof(double));
-				randDE = (double **)  realloc(randDE, (size+growth_popul)*sizeof(double));
-			} else {
-	                	rand = (double ***) realloc(rand,(size+growth_popul)*sizeof(double));
-                                randDE = (double **)  realloc(randDE, (size+growth_popul)*sizeof(double));
-	                	for (i = size; i < size+growth_popul; i++) {
-	                	      rand[i]   = (double **) calloc(nvars,sizeof(double *));
-				      randDE[i] = (double *)  calloc(nvars+4 ,sizeof(double));
-	                	      for (d = 0; d < nvars; d++) rand[i][d] = (double *) calloc(2,sizeof(double));
-	                	}
-			}
-		
 		}
 			
 		if (nrestarts == 1 ) {
@@ -719,66 +653,43 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
 		else if (nrestarts == 0 ) {
 			init_reset=size;
 		}
-	
-           	for (i = init_reset; i < (size+growth_popul); i++) {
-                	for (d = 0; d < nvars; d++) {
-                       		rand[i][d][0] = (rand_r(&seed) * 1.0) / RAND_MAX;
-                       		rand[i][d][1] = (rand_r(&seed) * 1.0) / RAND_MAX;
-                	}
-           	}
+		key = rand_r(&seed);
 
 #pragma omp parallel for default(shared) private(i,d,a,b) schedule(dynamic,1)	   
            	for (i=init_reset;i<(size+growth_popul);i++){
+	             RandomStream rs(key, i);
 	             for (d = 0; d < nvars; d++) {
-                        	a = lowerb[d] + (upperb[d] - lowerb[d]) * rand[i][d][0];
-                        	b = lowerb[d] + (upperb[d] - lowerb[d]) * rand[i][d][1];
+                        	a = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
+                        	b = lowerb[d] + (upperb[d] - lowerb[d]) * rs.Uniform();
 	                	pos[i][d]   = a ;
 	                	pos_b[i][d] = a ;
 	                	vel[i][d]   = (a - b) / 2.;
 	             }
-                     fit[i]   = EcoSystems[omp_get_thread_num()]->SimulateAndUpdate(pos[i]);
-                     fit_b[i] = fit[i];
 	   	}
+	   	EvaluationEngine::Evaluate(pos, fit, init_reset, size+growth_popul);
+	   	for (i=init_reset;i<(size+growth_popul);i++)
+	   	     fit_b[i] = fit[i];
            	size=size+growth_popul;
            	growth_popul=0;
 		STATE=0;
 	}
 	
 
-	// RANDOM NUMBER FOR THE CASE OF PSO
-        for (i = 0; i < size; i++) {
-		p1 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-		do  
-			p2 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-		while (p2 == p1);
-                do 
-                        p3 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-                while ((p3 == p1) || (p3 == p2));
-                do 
-                        p4 = (int) (((rand_r(&seed) * 1.0) / RAND_MAX)*size);
-                while ((p4 == p3) || (p4 == p2) || (p4 == p1));
-		randDE[i][0]= (double) p1;
-                randDE[i][1]= (double) p2;
-                randDE[i][2]= (double) p3;
-                randDE[i][3]= (double) p4;
-		for (d = 0; d < nvars; d++) {
-			rand[i][d][0] = (rand_r(&seed) * 1.0) / RAND_MAX;
-			rand[i][d][1] = (rand_r(&seed) * 1.0) / RAND_MAX;
-	                randDE[i][d+4]= (rand_r(&seed) * 1.0) / RAND_MAX;
-		}		
-        }
+        //JMB the random numbers for each particle are calculated from its own stream
+        key = rand_r(&seed);
 
-#pragma omp parallel for default(shared) private(i,d,rho1,rho2,p1,p2,p3,p4,prob) schedule(dynamic,1)
+#pragma omp parallel for default(shared) private(i,d,rho1,rho2) schedule(dynamic,1)
         for (i = 0; i < size; i++) {
 //      handle.logMessage(LOGDEBUG, "In parallel",omp_get_thread_num(),"\n");
             ostringstream spos, svel;
             spos << "New position of particle " << i << " [";
             svel << "New velocity of particle " << i << " [";
+            RandomStream rs(key, i);
 		// CASE 1: PSO ALGORITHM. for each dimension 
 		for (d = 0; d < nvars; d++) {
        		       // calculate stochastic coefficients
-			rho1 = c1 * rand[i][d][0] ;
-			rho2 = c2 * rand[i][d][1] ;
+			rho1 = c1 * rs.Uniform();
+			rho2 = c2 * rs.Uniform();
                 	// update velocity
 			vel[i][d] = w * vel[i][d] + rho1 * (pos_b[i][d] - pos[i][d]) + rho2 * (gbest[i][d] - pos[i][d]);
 			pos[i][d] = pos[i][d] + vel[i][d];
@@ -787,7 +698,9 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
 			svel << vel[i][d] << " ";
 			position_within_bounds(pos,vel,lowerb,upperb,i,d);
 		}
-		fit[i] = EcoSystems[omp_get_thread_num()]->SimulateAndUpdate(pos[i]);
+        }
+        EvaluationEngine::Evaluate(pos, fit, 0, size);
+        for (i = 0; i < size; i++) {
 		if (fit[i] < fit_b[i]) {
 			fit_b[i] = fit[i];
 			pos_b[i] = pos[i];
@@ -822,11 +735,7 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
 			consecutive_iters_global_best++; 
 			improv_with_stack_global_best=0;
 		}
-                iters=0;
-                for (d = 0; d < numThr; d++){
-                    iters = iters + (EcoSystems[d]->getFuncEval());
-		}
-                iters = iters - offset;
+                iters = EvaluationEngine::numEvaluations() - offset;
                 handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
                 handle.logMessage(LOGINFO, "The likelihood score is", best.bestf, "at the point");
                 EcoSystem->writeBestValues();
@@ -838,21 +747,8 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
 	psosteps++;
     } // while (newf < bestf)
     
-    for (i = 0; i < size; i++) {
-		for ( d = 0; d < nvars; d ++ ) {
-			cfree(rand[i][d]);
-		}
-		cfree(rand[i]);
-		cfree(randDE[i]);
-    }
-    cfree(rand);
-    cfree(randDE);
 	
-    iters=0;
-    for (d = 0; d < numThr; d++) 
-    	iters = iters + (EcoSystems[d]->getFuncEval());
-    
-    iters = iters - offset;
+    iters = EvaluationEngine::numEvaluations() - offset;
     timestop = RUNID.returnTime();
     handle.logMessage(LOGINFO, "Existing PSO after ", iters, "function evaluations ...");
     for (d = 0; d < nvars; d++)
@@ -861,6 +757,269 @@ void OptInfoPso::OptimiseLikelihoodOMP() {
     EcoSystem->writeBestValues();
     
 }
+
+/**
+ *  * \brief steady state version of the parallel PSO, where each particle is committed to the
+ *  * swarm as soon as it has been evaluated and the next particle is then moved
+ *  *
+ *  * The trials are committed in the order that they were generated, and each trial is
+ *  * generated a fixed number of commits before it is committed, so the search will give
+ *  * the same results for the same seed and the same number of threads
+ *   */
+void OptInfoPso::steadyState(PopulationMatrix& pos, PopulationMatrix& vel, PopulationMatrix& pos_b, DoubleVector& fit, DoubleVector& fit_b,
+    DoubleVector& bestx, double& bestf, int& bestindex, DoubleVector& lowerb, DoubleVector& upperb,
+    DoubleVector& init, int& psosteps, int& offset, Calc_inertia_fun calc_inertia_fun) {
+
+    int i, d, s;
+    double rho1, rho2, a, b;
+    double w = 0.0; //current omega
+    int numThr = omp_get_max_threads();
+    int queuesize = 2 * numThr;      // number of trials generated before they are committed
+    PopulationMatrix trials(queuesize, nvars, 0.0);
+    IntVector target(queuesize, 0);  // particle that each trial is for
+    DoubleVector trialf(queuesize, 0.0);
+    IntVector done(queuesize, 0);
+    int generated = 0;  // number of trials generated since the swarm was (re)started
+    int next = 0;       // next trial to be evaluated
+    int commit = 0;     // next trial to be committed to the swarm
+    int ninit = 0;      // number of trials for the new particles of a restarted swarm
+    int init_reset = 0;
+    int epoch = 0;      // used to discard the trials that were evaluated before a restart
+    int boundary = 1;   // start of a new iteration
+    int improved = 0;
+    int finished = 0;
+    int stop = 0;
+
+    handle.logMessage(LOGINFO, "Starting steady state PSO with", queuesize, "trials in the queue");
+
+#pragma omp parallel private(i, d, s, rho1, rho2, a, b)
+  {
+    int j = -1, e = 0, quit = 0;
+    double f = 0.0;
+    DoubleVector v(nvars, 0.0);
+    while (1) {
+#pragma omp critical (psosteady)
+      {
+        if ((j != -1) && (e == epoch) && (!finished)) {
+          trialf[j % queuesize] = f;
+          done[j % queuesize] = 1;
+        }
+        j = -1;
+
+        while (!finished) {
+          if (boundary) {
+            boundary = 0;
+            //JMB store or restore the state of the optimisation at the start of each iteration
+            if (OptCheckpoint::Start(OPTPSO)) {
+              this->transferState();
+              OptCheckpoint::Transfer(pos);
+              OptCheckpoint::Transfer(vel);
+              OptCheckpoint::Transfer(pos_b);
+              OptCheckpoint::Transfer(fit);
+              OptCheckpoint::Transfer(fit_b);
+              OptCheckpoint::Transfer(bestx);
+              OptCheckpoint::Transfer(bestf);
+              OptCheckpoint::Transfer(bestindex);
+              OptCheckpoint::Transfer(psosteps);
+              OptCheckpoint::Transfer(offset);
+              OptCheckpoint::Transfer(trials);
+              OptCheckpoint::Transfer(target);
+              OptCheckpoint::Transfer(generated);
+              OptCheckpoint::Transfer(commit);
+              OptCheckpoint::Transfer(ninit);
+              OptCheckpoint::Transfer(init_reset);
+              if (OptCheckpoint::isRestoring()) {
+                //JMB the trials in the queue will be evaluated again
+                queuesize = trials.Nrow();
+                trialf = DoubleVector(queuesize, 0.0);
+                done = IntVector(queuesize, 0);
+                next = commit;
+              }
+              OptCheckpoint::Finish();
+            }
+
+            if (isZero(bestf)) {
+              stop = -1;
+              finished = 1;
+              break;
+            }
+            if (psosteps > psoiter) {
+              stop = 1;
+              finished = 1;
+              break;
+            }
+            // update inertia weight
+            w = (this->*calc_inertia_fun)(psosteps);
+            if (bestf <= goal) {
+              finished = 1;
+              break;
+            }
+            improved = 0;
+
+            // If state var is equal to 3, the algorithm restart its population
+            if (STATE == 3) {
+              iter_without_improv_global_best = 0;
+              improv_with_stack_global_best = 0;
+              init_reset = 0;
+              if (growth_popul != 0) {
+                pos.AddRows(growth_popul, nvars, 0.0);
+                pos_b.AddRows(growth_popul, nvars, 0.0);
+                vel.AddRows(growth_popul, nvars, 0.0);
+                fit.resize(growth_popul, 0.0);
+                fit_b.resize(growth_popul, 0.0);
+              }
+              if (nrestarts == 1)
+                init_reset = 0;
+              else if (nrestarts == 0)
+                init_reset = size;
+
+              for (i = init_reset; i < (size + growth_popul); i++) {
+                for (d = 0; d < nvars; d++) {
+                  a = lowerb[d] + (upperb[d] - lowerb[d]) * ((rand_r(&seed) * 1.0) / RAND_MAX);
+                  b = lowerb[d] + (upperb[d] - lowerb[d]) * ((rand_r(&seed) * 1.0) / RAND_MAX);
+                  pos[i][d] = a;
+                  pos_b[i][d] = a;
+                  vel[i][d] = (a - b) / 2.;
+                }
+              }
+              ninit = (size + growth_popul > init_reset ? size + growth_popul - init_reset : 0);
+              size = size + growth_popul;
+              growth_popul = 0;
+              STATE = 0;
+
+              //JMB the trials in the queue were generated from the old swarm
+              epoch++;
+              generated = next = commit = 0;
+              for (i = 0; i < done.Size(); i++)
+                done[i] = 0;
+            }
+          }
+
+          //JMB keep the queue full, so each trial is generated at the same point in the search
+          while (generated < commit + queuesize) {
+            s = generated % queuesize;
+            if (generated < ninit) {
+              //JMB the new particles only need to be evaluated
+              target[s] = init_reset + generated;
+              trials[s] = pos[target[s]];
+            } else {
+              i = (generated - ninit) % size;
+              target[s] = i;
+              for (d = 0; d < nvars; d++) {
+                // calculate stochastic coefficients
+                rho1 = c1 * (rand_r(&seed) * 1.0) / RAND_MAX;
+                rho2 = c2 * (rand_r(&seed) * 1.0) / RAND_MAX;
+                // update velocity, with the best position found so far as the attractor
+                vel[i][d] = w * vel[i][d] + rho1 * (pos_b[i][d] - pos[i][d]) + rho2 * (bestx[d] - pos[i][d]);
+                // update position
+                pos[i][d] = pos[i][d] + vel[i][d];
+                position_within_bounds(pos, vel, lowerb, upperb, i, d);
+              }
+              trials[s] = pos[i];
+            }
+            generated++;
+          }
+
+          s = commit % queuesize;
+          if (!done[s])
+            break;
+
+          //JMB commit the next trial to the swarm
+          done[s] = 0;
+          i = target[s];
+          fit[i] = trialf[s];
+          if (commit < ninit) {
+            fit_b[i] = fit[i];
+          } else {
+            if (fit[i] < fit_b[i]) {
+              fit_b[i] = fit[i];
+              pos_b[i] = trials[s];
+            }
+            if (fit[i] < bestf) {
+              improved = 1;
+              bestindex = i;
+              bestf = fit[i];
+              for (d = 0; d < nvars; d++)
+                bestx[d] = trials[s][d] * init[d];
+              EcoSystem->storeVariables(bestf, bestx);
+              bestx = trials[s];
+            }
+          }
+          commit++;
+
+          if ((commit > ninit) && (((commit - ninit) % size) == 0)) {
+            //JMB this is the end of an iteration of the swarm
+            if (improved == 1) {
+              iter_without_improv_global_best = 0;
+              if (((( previous_fbest_fitness - bestf ) / previous_fbest_fitness)*100 <= threshold_acept ) &&
+                  (previous_fbest_fitness != DBL_MAX)) {
+                improv_with_stack_global_best++;
+                consecutive_iters_global_best = 0;
+              } else {
+                consecutive_iters_global_best++;
+                improv_with_stack_global_best = 0;
+              }
+              iters = EvaluationEngine::numEvaluations() - offset;
+              handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
+              handle.logMessage(LOGINFO, "The likelihood score is", bestf, "at the point");
+              EcoSystem->writeBestValues();
+              previous_fbest_fitness = bestf;
+            } else {
+              iter_without_improv_global_best++;
+              consecutive_iters_global_best = 0;
+            }
+            psosteps++;
+            boundary = 1;
+          }
+        }
+
+        if ((!finished) && (next < generated)) {
+          j = next;
+          e = epoch;
+          v = trials[j % queuesize];
+          next++;
+        }
+        quit = finished;
+      }
+
+      if (j != -1)
+        f = EvaluationEngine::Evaluate(v);
+      else if (quit)
+        break;
+    }
+  }
+
+    iters = EvaluationEngine::numEvaluations() - offset;
+
+    if (stop == -1) {
+        handle.logMessage(LOGINFO, "Error in PSO optimisation after", iters, "function evaluations, f(x) = 0");
+        converge = -1;
+        return;
+    }
+
+    handle.logMessage(LOGINFO, "\nStopping PSO optimisation algorithm\n");
+    if (stop == 1) {
+        handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+        handle.logMessage(LOGINFO, "The optimisation stopped because the maximum number of PSO steps was reached");
+        handle.logMessage(LOGINFO, "was reached and NOT because an optimum was found for this run");
+
+        score = EvaluationEngine::Evaluate(bestx);
+        for (i = 0; i < nvars; i++)
+            bestx[i] = bestx[i] * init[i];
+        handle.logMessage(LOGINFO, "\nPSO finished with a likelihood score of", score);
+        EcoSystem->storeVariables(score, bestx);
+        return;
+    }
+
+    handle.logMessage(LOGINFO, "Goal achieved!!! @ step ", psosteps);
+    score = EvaluationEngine::Evaluate(bestx);
+    handle.logMessage(LOGINFO, "\nPSO finished with a likelihood score of", score);
+    handle.logMessage(LOGINFO, "Existing PSO after ", iters, "function evaluations ...");
+    for (d = 0; d < nvars; d++)
+        bestx[d] = bestx[d] * init[d];
+    EcoSystem->storeVariables(bestf, bestx);
+    EcoSystem->writeBestValues();
+}
 #endif
 
 void OptInfoPso::growth_trend_manager() {
@@ -1024,3 +1183,23 @@ void OptInfoPso::inform_global(IntMatrix& comm, DoubleMatrix& pos_nb, DoubleMatr
     for (i = 0; i < size; i++)
         pos_nb[i] = gbest;
 }
+
+
+/**
+ *  * \brief store or restore the state of the search in the checkpoint file
+ *   */
+void OptInfoPso::transferState() {
+    OptCheckpoint::Transfer(seed);
+    OptCheckpoint::Transfer(c1);
+    OptCheckpoint::Transfer(c2);
+    OptCheckpoint::Transfer(previous_fbest_fitness);
+    OptCheckpoint::Transfer(iter_without_improv_global_best);
+    OptCheckpoint::Transfer(improv_with_stack_global_best);
+    OptCheckpoint::Transfer(consecutive_iters_global_best);
+    OptCheckpoint::Transfer(STATE);
+    OptCheckpoint::Transfer(nrestarts);
+    OptCheckpoint::Transfer(growth_trend);
+    OptCheckpoint::Transfer(growth_popul);
+    OptCheckpoint::Transfer(growth_trend_popul);
+    OptCheckpoint::Transfer(size);
+}
@@ -25,6 +25,7 @@
 #include "surveydistribution.h"
 #include "migrationproportion.h"
 #include "readword.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 #include "proglikelihood.h"
@@ -191,7 +192,7 @@ void Ecosystem::readLikelihood(CommentStream& infile) {
   strncpy(name, "", MaxStrLength);
   strncpy(datafilename, "", MaxStrLength);
 
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   if (!infile.eof())
@@ -314,8 +315,10 @@ void Ecosystem::readOptimisation(CommentStream& infile, unsigned* seed) {
       optvec.resize(new OptInfoPso());
     else if (strcasecmp(text, "[DE]") == 0)
       optvec.resize(new OptInfoDE());
+    else if (strcasecmp(text, "[surrogate]") == 0)
+      optvec.resize(new OptInfoSurrogate());
     else
-      handle.logFileUnexpected(LOGFAIL, "[hooke], [simann], [bfgs], [DE] or [pso]", text);
+      handle.logFileUnexpected(LOGFAIL, "[hooke], [simann], [bfgs], [DE], [pso] or [surrogate]", text);
 
     if (!infile.eof()) {
       infile >> text;
@@ -344,7 +347,7 @@ void Ecosystem::readMain(CommentStream& infile, const MainInfo& main) {
   strncpy(text, "", MaxStrLength);
   strncpy(filename, "", MaxStrLength);
 
-  ifstream subfile;
+  ModelFile subfile;
   CommentStream subcomment(subfile);
 
   //first, read in the time information
@@ -8,6 +8,7 @@
 #include "readfunc.h"
 #include "readword.h"
 #include "readaggregation.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -25,7 +26,7 @@ Recaptures::Recaptures(CommentStream& infile, const AreaClass* const Area,
   char aggfilename[MaxStrLength];
   strncpy(datafilename, "", MaxStrLength);
   strncpy(aggfilename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   functionname = new char[MaxStrLength];
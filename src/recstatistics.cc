@@ -9,6 +9,7 @@
 #include "stockprey.h"
 #include "mathfunc.h"
 #include "readaggregation.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -24,7 +25,7 @@ RecStatistics::RecStatistics(CommentStream& infile, const AreaClass* const Area,
   char aggfilename[MaxStrLength];
   strncpy(datafilename, "", MaxStrLength);
   strncpy(aggfilename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   functionname = new char[MaxStrLength];
@@ -3,6 +3,7 @@
 #include "readfunc.h"
 #include "keeper.h"
 #include "readword.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -12,7 +13,7 @@ RenewalData::RenewalData(CommentStream& infile, const IntVector& Areas,
   : HasName(givenname), LivesOnAreas(Areas), CI(0), LgrpDiv(0) {
 
   keeper->addString("renewaldata");
-  ifstream subfile;
+  ModelFile subfile;
   CommentStream subcomment(subfile);
   char text[MaxStrLength];
   strncpy(text, "", MaxStrLength);
@@ -168,6 +169,12 @@ void RenewalData::readNormalParameterData(CommentStream& infile, Keeper* const k
       sdevLength[count].Inform(keeper);
       alpha[count].Inform(keeper);
       beta[count].Inform(keeper);
+      //JMB the renewal data is only used when the recruits are added to the stock
+      renewalMult[count].setFirstUse(keeper, renewalTime[count]);
+      meanLength[count].setFirstUse(keeper, renewalTime[count]);
+      sdevLength[count].setFirstUse(keeper, renewalTime[count]);
+      alpha[count].setFirstUse(keeper, renewalTime[count]);
+      beta[count].setFirstUse(keeper, renewalTime[count]);
       count++;
 
     } else { //renewal data not required - skip rest of line
@@ -238,6 +245,11 @@ void RenewalData::readNormalConditionData(CommentStream& infile, Keeper* const k
       meanLength[count].Inform(keeper);
       sdevLength[count].Inform(keeper);
       relCond[count].Inform(keeper);
+      //JMB the renewal data is only used when the recruits are added to the stock
+      renewalMult[count].setFirstUse(keeper, renewalTime[count]);
+      meanLength[count].setFirstUse(keeper, renewalTime[count]);
+      sdevLength[count].setFirstUse(keeper, renewalTime[count]);
+      relCond[count].setFirstUse(keeper, renewalTime[count]);
       count++;
 
     } else { //renewal data not required - skip rest of line
@@ -13,11 +13,11 @@ SIByAcousticOnStep::SIByAcousticOnStep(CommentStream& infile, const IntMatrix& a
 }
 
 SIByAcousticOnStep::~SIByAcousticOnStep() {
-  if (aggregator != 0)
-    delete aggregator;
+  //JMB the aggregator is owned by the AggregationPlanner so dont delete it here
 }
 
-void SIByAcousticOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
+void SIByAcousticOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+  AggregationPlanner* const planner) {
   int i, minage, maxage;
   double minlength, maxlength;
 
@@ -46,7 +46,7 @@ void SIByAcousticOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVect
   for (i = 0; i < Ages.Ncol(); i++)
     Ages[0][i] = i + minage;
 
-  aggregator = new StockAggregator(Stocks, LgrpDiv, Areas, Ages);
+  aggregator = planner->getStockAggregator(Stocks, LgrpDiv, Areas, Ages);
 }
 
 void SIByAcousticOnStep::Sum(const TimeClass* const TimeInfo) {
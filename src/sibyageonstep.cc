@@ -15,11 +15,11 @@ SIByAgeOnStep::SIByAgeOnStep(CommentStream& infile, const IntMatrix& areas,
 }
 
 SIByAgeOnStep::~SIByAgeOnStep() {
-  if (aggregator != 0)
-    delete aggregator;
+  //JMB the aggregator is owned by the AggregationPlanner so dont delete it here
 }
 
-void SIByAgeOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
+void SIByAgeOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+  AggregationPlanner* const planner) {
   int i, j, found, minage, maxage;
   double minlength, maxlength;
 
@@ -65,7 +65,7 @@ void SIByAgeOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& S
       handle.logMessage(LOGWARN, "Warning in surveyindex - maximum age greater than stock age");
   }
 
-  aggregator = new StockAggregator(Stocks, LgrpDiv, Areas, Ages);
+  aggregator = planner->getStockAggregator(Stocks, LgrpDiv, Areas, Ages);
 }
 
 void SIByAgeOnStep::Sum(const TimeClass* const TimeInfo) {
@@ -16,7 +16,8 @@ SIByEffortOnStep::~SIByEffortOnStep() {
     delete aggregator;
 }
 
-void SIByEffortOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
+void SIByEffortOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+  AggregationPlanner* const planner) {
   if (Stocks.Size() == 0)
     handle.logMessage(LOGFAIL, "Error in surveyindex - failed to initialise stock data");
   if (Fleets.Size() == 0)
@@ -18,11 +18,11 @@ SIByFleetOnStep::SIByFleetOnStep(CommentStream& infile, const IntMatrix& areas,
 }
 
 SIByFleetOnStep::~SIByFleetOnStep() {
-  if (aggregator != 0)
-    delete aggregator;
+  //JMB the aggregator is owned by the AggregationPlanner so dont delete it here
 }
 
-void SIByFleetOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
+void SIByFleetOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+  AggregationPlanner* const planner) {
   int i, found, minage, maxage;
 
   if (Stocks.Size() == 0)
@@ -60,7 +60,7 @@ void SIByFleetOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector&
       handle.logMessage(LOGWARN, "Warning in surveyindex - maximum length group greater than stock length");
   }
 
-  aggregator = new FleetPreyAggregator(Fleets, Stocks, LgrpDiv, Areas, Ages, 0);
+  aggregator = planner->getFleetPreyAggregator(Fleets, Stocks, LgrpDiv, Areas, Ages, 0);
 }
 
 void SIByFleetOnStep::Sum(const TimeClass* const TimeInfo) {
@@ -18,11 +18,11 @@ SIByLengthOnStep::SIByLengthOnStep(CommentStream& infile, const IntMatrix& areas
 }
 
 SIByLengthOnStep::~SIByLengthOnStep() {
-  if (aggregator != 0)
-    delete aggregator;
+  //JMB the aggregator is owned by the AggregationPlanner so dont delete it here
 }
 
-void SIByLengthOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
+void SIByLengthOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+  AggregationPlanner* const planner) {
   int i, found, minage, maxage;
 
   if (Stocks.Size() == 0)
@@ -58,7 +58,7 @@ void SIByLengthOnStep::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector
       handle.logMessage(LOGWARN, "Warning in surveyindex - maximum length group greater than stock length");
   }
 
-  aggregator = new StockAggregator(Stocks, LgrpDiv, Areas, Ages);
+  aggregator = planner->getStockAggregator(Stocks, LgrpDiv, Areas, Ages);
 }
 
 void SIByLengthOnStep::Sum(const TimeClass* const TimeInfo) {
@@ -174,8 +174,10 @@
 #include "mathfunc.h"
 #include "doublevector.h"
 #include "intvector.h"
+#include "intmatrix.h"
 #include "errorhandler.h"
 #include "ecosystem.h"
+#include "evaluationengine.h"
 #include "global.h"
 #include "seq_optimize_template.h"
 #include <float.h>
@@ -457,7 +459,17 @@ void OptInfoSimann::OptimiseLikelihoodOMP() {
   	  double newLikelihood;
     };
 
+  if (chains > 1) {
+    if (scale)
+      for (i = 0; i < omp_get_max_threads(); i++) // scale the variables for the ecosystem of every thread
+        EcoSystems[i]->scaleVariables();
+    this->OptimiseLikelihoodTempering();
+    return;
+  }
+
   handle.logMessage(LOGINFO, "\nStarting Simulated Annealing optimisation algorithm\n");
+  //JMB the speculative search cannot be repeated exactly, so it cannot be restarted part way through
+  OptCheckpoint::Discard();
   int nvars = EcoSystem->numOptVariables();
   DoubleVector x(nvars);
   DoubleVector init(nvars);
@@ -532,12 +544,12 @@ void OptInfoSimann::OptimiseLikelihoodOMP() {
 	  storage[i].trialx = trialx;
 
 
-  int aux; //store the number of evaluations that are not useful for the algorithm
+  int offset = EvaluationEngine::numEvaluations();  //number of function evaluations done before loop
 
  DoubleVector vns(nvars, 0); //vector of ns
  int ns_ = ceil(numThr/2.);
- double res;
-  aux=0;
+ DoubleMatrix trials(numThr, nvars, 0.0);
+ DoubleVector ftrials(numThr, 0.0);
 
 
   //Start the main loop.  Note that it terminates if
@@ -575,13 +587,12 @@ void OptInfoSimann::OptimiseLikelihoodOMP() {
         		}
         	}
 
-# pragma omp parallel private(res)
-        	{
-				//Evaluate the function with the trial point trialx and return as -trialf
-        		int id = omp_get_thread_num ();
-        		res = EcoSystems[id]->SimulateAndUpdate(storage[id].trialx);
-        		storage[id].newLikelihood = -res;
-        	}
+        	//Evaluate the function with the trial points trialx and return as -trialf
+        	for (i = 0; i < numThr; ++i)
+        		trials[i] = storage[i].trialx;
+        	EvaluationEngine::Evaluate(trials, ftrials, 0, numThr);
+        	for (i = 0; i < numThr; ++i)
+        		storage[i].newLikelihood = -ftrials[i];
         	//best value from omp
 			trialf = storage[0].newLikelihood;
 			bestId=0;
@@ -597,16 +608,13 @@ void OptInfoSimann::OptimiseLikelihoodOMP() {
 			  if ((storage[i].newLikelihood - funcval) > verysmall)
 			  {
 				  nacp[k]++;
-				  aux++;
 				  vns[k]++;
 			  }
 			  else {
 				  //Accept according to metropolis condition
 				  p = expRep((storage[i].newLikelihood - funcval) / t);
 				  pp = randomNumber(&seedM);
-				  if (pp < p)
-					  aux++;
-			      else {
+				  if (pp >= p) {
 					  vns[k]++;
 					  nrej++;
 				  }
@@ -630,8 +638,7 @@ void OptInfoSimann::OptimiseLikelihoodOMP() {
 				  vns[k]=0;
 				}
 			}
-		    aux--;
-		    iters = (EcoSystems[bestId]->getFuncEval() * numThr) -aux;
+		    iters = EvaluationEngine::numEvaluations() - offset;
             if (iters > simanniter) {
 				handle.logMessage(LOGINFO, "\nStopping Simulated Annealing optimisation algorithm\n");
 				handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
@@ -819,8 +826,7 @@ void buildNewParams_f(Siman& seed, DoubleVector& params) {
 #ifdef _OPENMP
 double evaluate_par_f(const DoubleVector& params) {
 	double trialf;
-	int id = omp_get_thread_num ();
-	trialf = EcoSystems[id]->SimulateAndUpdate(params);
+	trialf = EvaluationEngine::Evaluate(params);
   return -trialf;
 }
 #endif
@@ -830,6 +836,17 @@ double evaluate_f(const DoubleVector& params) {
   return -trialf;
 }
 
+/// Represents the function that computes how good a batch of parameters are
+void evaluate_batch_f(const DoubleVector* const* params, double* values, int num) {
+	int i;
+	IntVector ticket(num, 0);
+	//the points are evaluated together when the first likelihood score is collected
+	for (i = 0; i < num; i++)
+		ticket[i] = EvaluationEngine::Submit(*params[i]);
+	for (i = 0; i < num; i++)
+		values[i] = -EvaluationEngine::Wait(ticket[i]);
+}
+
 struct ControlClass {
 
 	void adjustVm(Siman& seed) {
@@ -992,6 +1009,26 @@ struct ControlClass {
 	  return quit;
   }
 
+  /**
+   @brief Stores or restores the state of the search at the start of an iteration
+   @param siman  state of the search
+   @param x  current point
+   @param funcval  value at the current point
+   @param fopt  value at the best point
+   @param iters  number of iterations
+   */
+  void checkpoint(Siman& siman, DoubleVector& x, double& funcval, double& fopt, int& iters) {
+	if (OptCheckpoint::Start(OPTSIMANN)) {
+		siman.transferState();
+		OptCheckpoint::Transfer(x);
+		OptCheckpoint::Transfer(*siman.getBestx());
+		OptCheckpoint::Transfer(funcval);
+		OptCheckpoint::Transfer(fopt);
+		OptCheckpoint::Transfer(iters);
+		OptCheckpoint::Finish();
+	}
+  }
+
   void printResult(bool quit, Siman siman, int iters)
   {
 	double * score = siman.getScore();
@@ -1037,6 +1074,14 @@ void OptInfoSimann::OptimiseLikelihoodREP() {
 	int a, i, j, k, l, quit;
 	int rchange, rcheck, rnumber; //Used to randomise the order of the parameters
 
+	if (chains > 1) {
+		if (scale)
+			for (i = 0; i < omp_get_max_threads(); i++) // scale the variables for the ecosystem of every thread
+				EcoSystems[i]->scaleVariables();
+		this->OptimiseLikelihoodTempering();
+		return;
+	}
+
 	handle.logMessage(LOGINFO,
 			"\nStarting Simulated Annealing optimisation algorithm\n");
 	int nvars = EcoSystem->numOptVariables();
@@ -1102,7 +1147,7 @@ void OptInfoSimann::OptimiseLikelihoodREP() {
 	Siman s(seed, seedM, seedP, nvars, nt, ns, param, &x, &lowerb, &upperb, vm, t, rt, (1.0 / ns),
 			tempcheck, simanneps, fstar, lratio, uratio, cs, &bestx, scale, &converge, &score);
 
-	ReproducibleSearch<Siman, DoubleVector, ControlClass, evaluate_par_f, buildNewParams_f>
+	ReproducibleSearch<Siman, DoubleVector, ControlClass, evaluate_par_f, evaluate_batch_f, buildNewParams_f>
 	pa(s, x, simanniter);
 
 	// OpenMP parallelization
@@ -1121,6 +1166,11 @@ void OptInfoSimann::OptimiseLikelihood() {
 	int a, i, j, k, l, quit;
 	int rchange, rcheck, rnumber; //Used to randomise the order of the parameters
 
+	if (chains > 1) {
+		this->OptimiseLikelihoodTempering();
+		return;
+	}
+
 	handle.logMessage(LOGINFO,
 			"\nStarting Simulated Annealing optimisation algorithm\n");
 	int nvars = EcoSystem->numOptVariables();
@@ -1182,7 +1232,7 @@ void OptInfoSimann::OptimiseLikelihood() {
 	Siman s(seed, seedM, seedP, nvars, nt, ns, param, &x, &lowerb, &upperb, vm, t, rt, (1.0 / ns),
 			tempcheck, simanneps, fstar, lratio, uratio, cs, &bestx, scale, &converge, &score);
 
-	ReproducibleSearch<Siman, DoubleVector, ControlClass, evaluate_f, buildNewParams_f>
+	ReproducibleSearch<Siman, DoubleVector, ControlClass, evaluate_f, evaluate_batch_f, buildNewParams_f>
 	pa(s, x, simanniter);
 
 	// sequential code
@@ -1203,3 +1253,308 @@ void OptInfoSimann::OptimiseLikelihood() {
 
 
 
+/* parallel tempering version of the simulated annealing algorithm, where   */
+/* one chain is run at each temperature on a ladder of temperatures, and    */
+/* the chains at neighbouring temperatures exchange their current points    */
+/* with the probability given by the metropolis criteria.  The trial points */
+/* for all the chains are evaluated together, so the chains are run in      */
+/* parallel, and all the random numbers are drawn in order by the master    */
+/* thread so the search doesnt depend on the number of threads used         */
+void OptInfoSimann::OptimiseLikelihoodTempering() {
+
+  //set initial values
+  int nacc = 0;         //The number of accepted function evaluations
+  int nrej = 0;         //The number of rejected function evaluations
+  int naccmet = 0;      //The number of metropolis accepted function evaluations
+  int nswap = 0;        //The number of accepted exchanges between the chains
+  int ntry = 0;         //The number of attempted exchanges between the chains
+  int nround = 0;       //The number of times that exchanges have been attempted
+
+  double tmp, p, pp, ratio, nsdiv, step;
+  double fopt, trialf;
+  int    a, i, j, k, l, offset, quit;
+  int    rchange, rcheck, rnumber;  //Used to randomise the order of the parameters
+
+  handle.logMessage(LOGINFO, "\nStarting Simulated Annealing optimisation algorithm");
+  handle.logMessage(LOGINFO, "Using parallel tempering with", chains, "chains\n");
+  int nvars = EcoSystem->numOptVariables();
+  DoubleVector x(nvars);
+  DoubleVector init(nvars);
+  DoubleVector bestx(nvars);
+  DoubleVector scalex(nvars);
+  DoubleVector lowerb(nvars);
+  DoubleVector upperb(nvars);
+  DoubleVector fstar(tempcheck);
+  DoubleVector temp(chains);             //The temperature of each chain
+  DoubleVector chainf(chains);           //The function value at the current point of each chain
+  DoubleVector ftrials(chains, 0.0);
+  DoubleMatrix chainx(chains, nvars, 0.0);  //The current point of each chain
+  DoubleMatrix trials(chains, nvars, 0.0);
+  DoubleMatrix vm(chains, nvars, vminit);   //The step length at each temperature
+  IntMatrix param(chains, nvars, 0);
+  IntMatrix nacp(chains, nvars, 0);
+
+  EcoSystem->resetVariables();  //JMB need to reset variables in case they have been scaled
+  if (scale)
+    EcoSystem->scaleVariables();
+  EcoSystem->getOptScaledValues(x);
+  EcoSystem->getOptLowerBounds(lowerb);
+  EcoSystem->getOptUpperBounds(upperb);
+  EcoSystem->getOptInitialValues(init);
+
+  for (i = 0; i < nvars; i++)
+    bestx[i] = x[i];
+  for (k = 0; k < chains; k++)
+    for (i = 0; i < nvars; i++)
+      param[k][i] = i;
+
+  if (scale) {
+    for (i = 0; i < nvars; i++) {
+      scalex[i] = x[i];
+      // Scaling the bounds, because the parameters are scaled
+      lowerb[i] = lowerb[i] / init[i];
+      upperb[i] = upperb[i] / init[i];
+      if (lowerb[i] > upperb[i]) {
+        tmp = lowerb[i];
+        lowerb[i] = upperb[i];
+        upperb[i] = tmp;
+      }
+    }
+  }
+
+  //fopt is the function value at x
+  fopt = EcoSystem->SimulateAndUpdate(x);
+  if (fopt != fopt) { //check for NaN
+    handle.logMessage(LOGINFO, "Error starting Simulated Annealing optimisation with f(x) = infinity");
+    converge = -1;
+    iters = 1;
+    return;
+  }
+
+  //the function is to be minimised so switch the sign of fopt (and trialf)
+  fopt = -fopt;
+  offset = EvaluationEngine::numEvaluations();  //number of function evaluations done before loop
+  nacc++;
+  step = cs / lratio;  //JMB save processing time
+  nsdiv = 1.0 / ns;
+  for (i = 0; i < tempcheck; i++)
+    fstar[i] = fopt;
+
+  //JMB the coldest chain is at the temperature t, and the temperature of
+  //each of the other chains is tempratio times that of the previous chain
+  for (k = 0; k < chains; k++) {
+    chainx[k] = x;
+    chainf[k] = fopt;
+    temp[k] = (k == 0 ? t : temp[k - 1] * tempratio);
+  }
+
+  //Start the main loop.  Note that it terminates if
+  //(i) the algorithm succesfully optimises the function or
+  //(ii) there are too many function evaluations
+  while (1) {
+    //JMB store or restore the state of the optimisation at the start of each temperature loop
+    if (OptCheckpoint::Start(OPTSIMANN)) {
+      OptCheckpoint::Transfer(seed);
+      OptCheckpoint::Transfer(seedM);
+      OptCheckpoint::Transfer(seedP);
+      OptCheckpoint::Transfer(chainx);
+      OptCheckpoint::Transfer(chainf);
+      OptCheckpoint::Transfer(vm);
+      OptCheckpoint::Transfer(temp);
+      for (k = 0; k < chains; k++)
+        OptCheckpoint::Transfer(param[k]);
+      OptCheckpoint::Transfer(bestx);
+      OptCheckpoint::Transfer(fopt);
+      OptCheckpoint::Transfer(fstar);
+      OptCheckpoint::Transfer(nacc);
+      OptCheckpoint::Transfer(naccmet);
+      OptCheckpoint::Transfer(nrej);
+      OptCheckpoint::Transfer(nswap);
+      OptCheckpoint::Transfer(ntry);
+      OptCheckpoint::Transfer(nround);
+      OptCheckpoint::Transfer(offset);
+      OptCheckpoint::Finish();
+    }
+
+    for (a = 0; a < nt; a++) {
+      //Randomize the order of the parameters once in a while, to avoid
+      //the order having an influence on which changes are accepted
+      for (k = 0; k < chains; k++) {
+        rchange = 0;
+        while (rchange < nvars) {
+          rnumber = rand_r(&seedP) % nvars;
+          rcheck = 1;
+          for (i = 0; i < rchange; i++)
+            if (param[k][i] == rnumber)
+              rcheck = 0;
+          if (rcheck) {
+            param[k][rchange] = rnumber;
+            rchange++;
+          }
+        }
+      }
+
+      for (j = 0; j < ns; j++) {
+        for (l = 0; l < nvars; l++) {
+          //Generate the trial point for each chain, and evaluate them together
+          for (k = 0; k < chains; k++)
+            newValue(nvars, l, param[k], trials[k], chainx[k], lowerb, upperb, vm[k]);
+          EvaluationEngine::Evaluate(trials, ftrials, 0, chains);
+
+          iters = EvaluationEngine::numEvaluations() - offset;
+          for (k = 0; k < chains; k++) {
+            trialf = -ftrials[k];
+            // JMB added check for really silly values
+            if (isZero(trialf)) {
+              handle.logMessage(LOGINFO, "Error in Simulated Annealing optimisation after", iters, "function evaluations, f(x) = 0");
+              converge = -1;
+              return;
+            }
+
+            //Accept the new point if the new function value better
+            if ((trialf - chainf[k]) > verysmall) {
+              chainx[k] = trials[k];
+              chainf[k] = trialf;
+              nacc++;
+              nacp[k][param[k][l]]++;
+
+            } else if (trialf == trialf) {
+              //Accept according to metropolis condition
+              p = expRep((trialf - chainf[k]) / temp[k]);
+              pp = randomNumber(&seedM);
+              if (pp < p) {
+                //Accept point
+                chainx[k] = trials[k];
+                chainf[k] = trialf;
+                naccmet++;
+                nacp[k][param[k][l]]++;
+              } else {
+                //Reject point
+                nrej++;
+              }
+            } else
+              nrej++;
+
+            //If greater than any other point, record as new optimum
+            if ((trialf > fopt) && (trialf == trialf)) {
+              bestx = trials[k];
+              fopt = trialf;
+
+              if (scale) {
+                for (i = 0; i < nvars; i++)
+                  scalex[i] = bestx[i] * init[i];
+                EcoSystem->storeVariables(-fopt, scalex);
+              } else
+                EcoSystem->storeVariables(-fopt, bestx);
+
+              handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
+              handle.logMessage(LOGINFO, "The likelihood score is", -fopt, "at the point");
+              EcoSystem->writeBestValues();
+            }
+          }
+
+          //If too many function evaluations occur, terminate the algorithm
+          if (iters > simanniter) {
+            handle.logMessage(LOGINFO, "\nStopping Simulated Annealing optimisation algorithm\n");
+            handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+            handle.logMessage(LOGINFO, "The temperature was reduced to", temp[0]);
+            handle.logMessage(LOGINFO, "The optimisation stopped because the maximum number of function evaluations");
+            handle.logMessage(LOGINFO, "was reached and NOT because an optimum was found for this run");
+            handle.logMessage(LOGINFO, "Number of directly accepted points", nacc);
+            handle.logMessage(LOGINFO, "Number of metropolis accepted points", naccmet);
+            handle.logMessage(LOGINFO, "Number of rejected points", nrej);
+            handle.logMessage(LOGINFO, "Number of attempted exchanges between the chains", ntry);
+            handle.logMessage(LOGINFO, "Number of accepted exchanges between the chains", nswap);
+
+            score = EcoSystem->SimulateAndUpdate(bestx);
+            handle.logMessage(LOGINFO, "\nSimulated Annealing finished with a likelihood score of", score);
+            return;
+          }
+        }
+
+        //JMB try to exchange the points of neighbouring chains, alternating
+        //between the odd and even pairs of chains, so that each chain is
+        //only involved in one exchange at a time
+        for (k = nround % 2; k < chains - 1; k += 2) {
+          ntry++;
+          p = expRep((chainf[k + 1] - chainf[k]) * (1.0 / temp[k] - 1.0 / temp[k + 1]));
+          pp = randomNumber(&seedM);
+          if (pp < p) {
+            x = chainx[k];
+            chainx[k] = chainx[k + 1];
+            chainx[k + 1] = x;
+            tmp = chainf[k];
+            chainf[k] = chainf[k + 1];
+            chainf[k + 1] = tmp;
+            nswap++;
+          }
+        }
+        nround++;
+      }
+
+      //Adjust vm so that approximately half of all evaluations are accepted
+      //at each temperature
+      for (k = 0; k < chains; k++) {
+        for (i = 0; i < nvars; i++) {
+          ratio = nsdiv * nacp[k][i];
+          nacp[k][i] = 0;
+          if (ratio > uratio) {
+            vm[k][i] = vm[k][i] * (1.0 + step * (ratio - uratio));
+          } else if (ratio < lratio) {
+            vm[k][i] = vm[k][i] / (1.0 + step * (lratio - ratio));
+          }
+
+          if (vm[k][i] < rathersmall)
+            vm[k][i] = rathersmall;
+          if (vm[k][i] > (upperb[i] - lowerb[i]))
+            vm[k][i] = upperb[i] - lowerb[i];
+        }
+      }
+    }
+
+    //Check termination criteria, using the coldest chain
+    for (i = tempcheck - 1; i > 0; i--)
+      fstar[i] = fstar[i - 1];
+    fstar[0] = chainf[0];
+
+    quit = 0;
+    if (fabs(fopt - chainf[0]) < simanneps) {
+      quit = 1;
+      for (i = 0; i < tempcheck - 1; i++)
+        if (fabs(fstar[i + 1] - fstar[i]) > simanneps)
+          quit = 0;
+    }
+
+    handle.logMessage(LOGINFO, "Checking convergence criteria after", iters, "function evaluations ...");
+
+    //Terminate SA if appropriate
+    if (quit) {
+      handle.logMessage(LOGINFO, "\nStopping Simulated Annealing optimisation algorithm\n");
+      handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+      handle.logMessage(LOGINFO, "The temperature was reduced to", temp[0]);
+      handle.logMessage(LOGINFO, "The optimisation stopped because an optimum was found for this run");
+      handle.logMessage(LOGINFO, "Number of directly accepted points", nacc);
+      handle.logMessage(LOGINFO, "Number of metropolis accepted points", naccmet);
+      handle.logMessage(LOGINFO, "Number of rejected points", nrej);
+      handle.logMessage(LOGINFO, "Number of attempted exchanges between the chains", ntry);
+      handle.logMessage(LOGINFO, "Number of accepted exchanges between the chains", nswap);
+
+      converge = 1;
+      score = EcoSystem->SimulateAndUpdate(bestx);
+      handle.logMessage(LOGINFO, "\nSimulated Annealing finished with a likelihood score of", score);
+      return;
+    }
+
+    //If termination criteria is not met, prepare for another loop.
+    for (k = 0; k < chains; k++) {
+      temp[k] *= rt;
+      if (temp[k] < rathersmall)
+        temp[k] = rathersmall;  //JMB make sure temperature doesnt get too small
+    }
+
+    handle.logMessage(LOGINFO, "Reducing the temperature to", temp[0]);
+    //JMB only the coldest chain is restarted from the best point
+    chainx[0] = bestx;
+    chainf[0] = fopt;
+  }
+}
@@ -68,20 +68,78 @@ void Ecosystem::updateAgesOneArea(int area) {
       basevec[i]->updateAgePart3(area, TimeInfo);
 }
 
+int Ecosystem::findCheckpoint(const DoubleVector& val) const {
+  int i, time;
+  if (!checkpointvalid)
+    return -1;
+
+  //JMB find the first timestep that uses a parameter that has changed
+  time = TimeInfo->numTotalSteps() + 1;
+  for (i = 0; i < val.Size(); i++)
+    if ((firstuse[i] < time) && (val[i] != simulatedval[i]))
+      time = firstuse[i];
+
+  for (i = checkpointtime.Size() - 1; i >= 0; i--)
+    if (checkpointtime[i] <= time)
+      return i;
+  return -1;
+}
+
 void Ecosystem::Simulate(int print) {
-  int i, j, k;
+  int i, j, k, id, next;
 
   handle.logMessage(LOGMESSAGE, "");  //write blank line to log file
-  for (j = 0; j < likevec.Size(); j++)
-    likevec[j]->Reset(keeper);
-  for (j = 0; j < likevec.Size(); j++)
-    likevec[j]->addLikelihoodKeeper(TimeInfo, keeper);
+  id = -1;
+  if (simcheckpoint > 0) {
+    //JMB the model output is printed for every timestep so dont restart then
+    DoubleVector val(keeper->numVariables(), 0.0);
+    keeper->getCurrentValues(val);
+    if (!print)
+      id = this->findCheckpoint(val);
+    simulatedval = val;
+    checkpointvalid = 0;
+  }
+
+  if (id == -1) {
+    for (j = 0; j < likevec.Size(); j++)
+      likevec[j]->Reset(keeper);
+    for (j = 0; j < likevec.Size(); j++)
+      likevec[j]->addLikelihoodKeeper(TimeInfo, keeper);
+
+    for (j = 0; j < tagvec.Size(); j++)
+      tagvec[j]->Reset();
+
+    TimeInfo->Reset();
 
-  for (j = 0; j < tagvec.Size(); j++)
-    tagvec[j]->Reset();
+  } else {
+    //JMB restore the likelihood scores up to the checkpoint
+    TimeInfo->Restart(checkpointtime[id]);
+    for (j = 0; j < likevec.Size(); j++)
+      likevec[j]->restoreState(id, TimeInfo);
+    for (j = 0; j < likevec.Size(); j++)
+      likevec[j]->addLikelihoodKeeper(TimeInfo, keeper);
+
+    //JMB recalculate the information set on the first timestep before
+    //restoring the population from the checkpoint
+    TimeInfo->Reset();
+    for (j = 0; j < basevec.Size(); j++)
+      basevec[j]->Reset(TimeInfo);
+    for (j = 0; j < stockvec.Size(); j++)
+      stockvec[j]->restoreState(id);
+    TimeInfo->Restart(checkpointtime[id]);
+  }
+
+  next = id + 1;
+  for (i = TimeInfo->getTime() - 1; i < TimeInfo->numTotalSteps(); i++) {
+    //JMB store the population and likelihood scores at the start of the year
+    if ((next < checkpointtime.Size()) && (TimeInfo->getTime() == checkpointtime[next])) {
+      for (j = 0; j < stockvec.Size(); j++)
+        stockvec[j]->storeState(next);
+      for (j = 0; j < likevec.Size(); j++)
+        likevec[j]->storeState(next);
+      next++;
+    }
 
-  TimeInfo->Reset();
-  for (i = 0; i < TimeInfo->numTotalSteps(); i++) {
     for (j = 0; j < basevec.Size(); j++)
       basevec[j]->Reset(TimeInfo);
 
@@ -99,25 +157,33 @@ void Ecosystem::Simulate(int print) {
       for (j = 0; j < basevec.Size(); j++)
         basevec[j]->Migrate(TimeInfo);
 
+    // the areas can be updated in parallel, since the only movements between
+    // areas are migration (above) and tagging experiments (not allowed then)
     // predation can be split into substeps
     for (k = 0; k < TimeInfo->numSubSteps(); k++) {
+#pragma omp parallel for if (runAreaParallel) schedule(dynamic, 1)
       for (j = 0; j < Area->numAreas(); j++)
         this->updatePredationOneArea(j);
       TimeInfo->IncrementSubstep();
     }
 
     // maturation, spawning, recruits etc
+#pragma omp parallel for if (runAreaParallel) schedule(dynamic, 1)
     for (j = 0; j < Area->numAreas(); j++)
       this->updatePopulationOneArea(j);
 
-    for (j = 0; j < likevec.Size(); j++){
-      likevec[j]->addLikelihood(TimeInfo);
-    }
+    planner->newStep();
+    //the likelihood scores are added together in order after the simulation
+    const IntVector& likenow = likesteps[TimeInfo->getTime()];
+#pragma omp parallel for if ((runLikeParallel) && (likeparallel[TimeInfo->getTime()])) schedule(dynamic, 1)
+    for (j = 0; j < likenow.Size(); j++)
+      likevec[likenow[j]]->addLikelihood(TimeInfo);
 
     if (print)
       for (j = 0; j < printvec.Size(); j++)
         printvec[j]->Print(TimeInfo, 0);  //end of timestep, so printtime is 0
 
+#pragma omp parallel for if (runAreaParallel) schedule(dynamic, 1)
     for (j = 0; j < Area->numAreas(); j++)
       this->updateAgesOneArea(j);
 
@@ -148,6 +214,9 @@ void Ecosystem::Simulate(int print) {
   // remove all the tagging experiments - they must have expired now
   tagvec.deleteAllTags();
 
+  if (simcheckpoint > 0)
+    checkpointvalid = 1;
+
   likelihood = 0.0;
   for (j = 0; j < likevec.Size(); j++)
     likelihood += likevec[j]->getLikelihood();
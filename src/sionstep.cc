@@ -3,6 +3,7 @@
 #include "errorhandler.h"
 #include "readfunc.h"
 #include "readword.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -49,7 +50,7 @@ SIOnStep::SIOnStep(CommentStream& infile, const char* datafilename, const CharPt
   readSIRegressionData(infile);
 
   //read the survey indices data from the datafile
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
   datafile.open(datafilename, ios::in);
   handle.checkIfFailure(datafile, datafilename);
@@ -371,3 +372,10 @@ void SIOnStep::Reset() {
   for (i = 0; i < modelIndex.Size(); i++)
     (*modelIndex[i]).setToZero();
 }
+
+void SIOnStep::Reset(const TimeClass* const TimeInfo) {
+  int i;
+  for (i = 0; i < modelIndex.Size(); i++)
+    if ((Years[i] > TimeInfo->getYear()) || ((Years[i] == TimeInfo->getYear()) && (Steps[i] >= TimeInfo->getStep())))
+      (*modelIndex[i]).setToZero();
+}
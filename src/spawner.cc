@@ -6,6 +6,7 @@
 #include "mathfunc.h"
 #include "readword.h"
 #include "readaggregation.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -19,7 +20,7 @@ SpawnData::SpawnData(CommentStream& infile, int maxage, const LengthGroupDivisio
 
   char text[MaxStrLength];
   strncpy(text, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
   functionname = new char[MaxStrLength];
   strncpy(functionname, "", MaxStrLength);
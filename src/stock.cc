@@ -16,6 +16,7 @@
 #include "stray.h"
 #include "readword.h"
 #include "readaggregation.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -34,7 +35,7 @@ Stock::Stock(CommentStream& infile, const char* givenname,
   strncpy(filename, "", MaxStrLength);
   IntVector tmpareas;
 
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
   keeper->setString(this->getName());
 
@@ -188,7 +189,7 @@ Stock::Stock(CommentStream& infile, const char* givenname,
   if (doesmature) {
     readWordAndValue(infile, "maturityfunction", text);
     readWordAndValue(infile, "maturityfile", filename);
-    ifstream subfile;
+    ModelFile subfile;
     subfile.open(filename, ios::in);
     CommentStream subcomment(subfile);
     handle.checkIfFailure(subfile, filename);
@@ -252,7 +253,7 @@ Stock::Stock(CommentStream& infile, const char* givenname,
   readWordAndVariable(infile, "doesspawn", doesspawn);
   if (doesspawn) {
     readWordAndValue(infile, "spawnfile", filename);
-    ifstream subfile;
+    ModelFile subfile;
     subfile.open(filename, ios::in);
     CommentStream subcomment(subfile);
     handle.checkIfFailure(subfile, filename);
@@ -272,7 +273,7 @@ Stock::Stock(CommentStream& infile, const char* givenname,
     readWordAndVariable(infile, "doesstray", doesstray);
     if (doesstray) {
       readWordAndValue(infile, "strayfile", filename);
-      ifstream subfile;
+      ModelFile subfile;
       subfile.open(filename, ios::in);
       CommentStream subcomment(subfile);
       handle.checkIfFailure(subfile, filename);
@@ -361,6 +362,40 @@ void Stock::Reset(const TimeClass* const TimeInfo) {
     handle.logMessage(LOGMESSAGE, "Reset stock data for stock", this->getName());
 }
 
+void Stock::storeState(int id) {
+  int a, age, len, count;
+  if (id >= storedAlkeys.Nrow()) {
+    count = 0;
+    for (a = 0; a < areas.Size(); a++)
+      for (age = Alkeys[a].minAge(); age <= Alkeys[a].maxAge(); age++)
+        count += 2 * (Alkeys[a].maxLength(age) - Alkeys[a].minLength(age));
+    storedAlkeys.AddRows(id + 1 - storedAlkeys.Nrow(), count, 0.0);
+  }
+
+  count = 0;
+  for (a = 0; a < areas.Size(); a++) {
+    for (age = Alkeys[a].minAge(); age <= Alkeys[a].maxAge(); age++) {
+      for (len = Alkeys[a].minLength(age); len < Alkeys[a].maxLength(age); len++) {
+        storedAlkeys[id][count++] = Alkeys[a][age][len].N;
+        storedAlkeys[id][count++] = Alkeys[a][age][len].W;
+      }
+    }
+  }
+}
+
+void Stock::restoreState(int id) {
+  int a, age, len, count;
+  count = 0;
+  for (a = 0; a < areas.Size(); a++) {
+    for (age = Alkeys[a].minAge(); age <= Alkeys[a].maxAge(); age++) {
+      for (len = Alkeys[a].minLength(age); len < Alkeys[a].maxLength(age); len++) {
+        Alkeys[a][age][len].N = storedAlkeys[id][count++];
+        Alkeys[a][age][len].W = storedAlkeys[id][count++];
+      }
+    }
+  }
+}
+
 void Stock::setStock(StockPtrVector& stockvec) {
 
   initial->setCI(LgrpDiv);
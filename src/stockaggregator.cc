@@ -8,7 +8,7 @@
 
 StockAggregator::StockAggregator(const StockPtrVector& Stocks,
   const LengthGroupDivision* const LgrpDiv, const IntMatrix& Areas, const IntMatrix& Ages)
-  : stocks(Stocks), areas(Areas), ages(Ages), alptr(0) {
+  : stocks(Stocks), areas(Areas), ages(Ages), alptr(0), shared(0), summed(0) {
 
   int i;
   for (i = 0; i < stocks.Size(); i++) {
@@ -29,6 +29,10 @@ StockAggregator::~StockAggregator() {
   int i;
   for (i = 0; i < CI.Size(); i++)
     delete CI[i];
+#ifdef _OPENMP
+  if (shared)
+    omp_destroy_lock(&sumlock);
+#endif
 }
 
 void StockAggregator::Print(ofstream& outfile) const {
@@ -49,7 +53,33 @@ void StockAggregator::Reset() {
     total[i].setToZero();
 }
 
+void StockAggregator::setShared() {
+#ifdef _OPENMP
+  if (!shared)
+    omp_init_lock(&sumlock);
+#endif
+  shared = 1;
+}
+
 void StockAggregator::Sum() {
+  //JMB a shared aggregator only needs to be summed once on each timestep, and
+  //the lock stops the likelihood components that are calculated in parallel
+  //from summing it at the same time
+  if (shared) {
+#ifdef _OPENMP
+    omp_set_lock(&sumlock);
+#endif
+    if (!summed)
+      this->calcSum();
+    summed = 1;
+#ifdef _OPENMP
+    omp_unset_lock(&sumlock);
+#endif
+  } else
+    this->calcSum();
+}
+
+void StockAggregator::calcSum() {
   int area, age, i, j, k;
 
   this->Reset();
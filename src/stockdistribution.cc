@@ -8,6 +8,7 @@
 #include "stock.h"
 #include "mathfunc.h"
 #include "stockprey.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -25,7 +26,7 @@ StockDistribution::StockDistribution(CommentStream& infile,
   char aggfilename[MaxStrLength];
   strncpy(datafilename, "", MaxStrLength);
   strncpy(aggfilename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   timeindex = 0;
@@ -183,6 +184,60 @@ StockDistribution::StockDistribution(CommentStream& infile,
       handle.logMessage(LOGWARN, "Warning in stockdistribution - unrecognised function", functionname);
       break;
   }
+
+  this->prepareObservations(TimeInfo);
+}
+
+void StockDistribution::prepareObservations(const TimeClass* const TimeInfo) {
+  int i, area, s, id, numstock, numid;
+  double total;
+  DoubleMatrix* prep;
+
+  //JMB find the index of the likelihood data for each timestep
+  timeMap.resize(TimeInfo->numTotalSteps() + 1, -1);
+  for (i = 0; i < Years.Size(); i++)
+    timeMap[TimeInfo->calcSteps(Years[i], Steps[i])] = i;
+
+  for (i = 0; i < obsDistribution.Nrow(); i++) {
+    obsPrepared.resize();
+    for (area = 0; area < obsDistribution.Ncol(i); area++) {
+      const DoubleMatrix& obs = *obsDistribution[i][area];
+      numstock = obs.Nrow();
+      numid = obs.Ncol();
+      prep = 0;
+
+      switch (functionnumber) {
+        case 1:
+          {
+            DoubleVector obsdata(numstock, 0.0);
+            prep = new DoubleMatrix(1, numid, 0.0);
+            for (id = 0; id < numid; id++) {
+              for (s = 0; s < numstock; s++)
+                obsdata[s] = obs[s][id];
+              (*prep)[0][id] = MN.calcDataConstant(obsdata);
+            }
+          }
+          break;
+        case 2:
+          if (!yearly) {
+            prep = new DoubleMatrix(numstock, numid, 0.0);
+            for (id = 0; id < numid; id++) {
+              total = 0.0;
+              for (s = 0; s < numstock; s++)
+                total += obs[s][id];
+              if (!(isZero(total)))
+                total = 1.0 / total;
+              for (s = 0; s < numstock; s++)
+                (*prep)[s][id] = obs[s][id] * total;
+            }
+          }
+          break;
+        default:
+          break;
+      }
+      obsPrepared[i].resize(prep);
+    }
+  }
 }
 
 void StockDistribution::readStockData(CommentStream& infile,
@@ -294,10 +349,9 @@ void StockDistribution::readStockData(CommentStream& infile,
 
 StockDistribution::~StockDistribution() {
   int i, j;
-  for (i = 0; i < stocknames.Size(); i++) {
+  for (i = 0; i < stocknames.Size(); i++)
     delete[] stocknames[i];
-    delete aggregator[i];
-  }
+  //JMB the aggregators are owned by the AggregationPlanner so dont delete them here
   delete[] aggregator;
   delete[] functionname;
   delete LgrpDiv;
@@ -318,6 +372,8 @@ StockDistribution::~StockDistribution() {
     for (j = 0; j < obsDistribution.Ncol(i); j++) {
       delete obsDistribution[i][j];
       delete modelDistribution[i][j];
+      if (obsPrepared[i][j] != 0)
+        delete obsPrepared[i][j];
     }
   }
 }
@@ -365,7 +421,8 @@ void StockDistribution::Print(ofstream& outfile) const {
   outfile.flush();
 }
 
-void StockDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
+void StockDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+  AggregationPlanner* const planner) {
   int s, i, j, k, found, minage, maxage;
   FleetPtrVector fleets;
   StockPtrVector stocks;
@@ -417,7 +474,7 @@ void StockDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVecto
     if (found == 0)
       handle.logMessage(LOGFAIL, "Error in stockdistribution - unrecognised stock", stocknames[i]);
 
-    aggregator[s] = new FleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
+    aggregator[s] = planner->getFleetPreyAggregator(fleets, stocks, LgrpDiv, areas, ages, overconsumption);
   }
 
   for (i = 0; i < checkstocks.Size(); i++)
@@ -476,6 +533,12 @@ void StockDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVecto
   }
 }
 
+int StockDistribution::isActive(int year, int step, const TimeClass* const TimeInfo) const {
+  if (isZero(weight))
+    return 0;
+  return AAT.atTime(year, step, TimeInfo);
+}
+
 void StockDistribution::addLikelihood(const TimeClass* const TimeInfo) {
 
   if ((!(AAT.atCurrentTime(TimeInfo))) || (isZero(weight)))
@@ -485,10 +548,7 @@ void StockDistribution::addLikelihood(const TimeClass* const TimeInfo) {
     handle.logMessage(LOGMESSAGE, "Calculating likelihood score for stockdistribution component", this->getName());
 
   int i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = timeMap[TimeInfo->getTime()];
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in stockdistribution - invalid timestep");
 
@@ -545,7 +605,8 @@ double StockDistribution::calcLikMultinomial() {
         obsdata[s] = (*obsDistribution[timeindex][area])[s][i];
         moddata[s] = (*modelDistribution[timeindex][area])[s][i];
       }
-      likelihoodValues[timeindex][area] += MN.calcLogLikelihood(obsdata, moddata);
+      likelihoodValues[timeindex][area] +=
+        MN.calcLogLikelihood(obsdata, moddata, (*obsPrepared[timeindex][area])[0][i]);
     }
   }
   return MN.getLogLikelihood();
@@ -573,19 +634,15 @@ double StockDistribution::calcLikSumSquares(const TimeClass* const TimeInfo) {
     if (!yearly) { //calculate likelihood on all steps
       for (i = 0; i < (numage * numlen); i++) {
         totalmodel = 0.0;
-        totaldata = 0.0;
-        for (s = 0; s < numstock; s++) {
+        for (s = 0; s < numstock; s++)
           totalmodel += (*modelDistribution[timeindex][area])[s][i];
-          totaldata += (*obsDistribution[timeindex][area])[s][i];
-        }
 
         if (!(isZero(totalmodel)))
           totalmodel = 1.0 / totalmodel;
-        if (!(isZero(totaldata)))
-          totaldata = 1.0 / totaldata;
 
+        //the observed proportions have already been calculated
         for (s = 0; s < numstock; s++) {
-          temp = (((*obsDistribution[timeindex][area])[s][i] * totaldata)
+          temp = ((*obsPrepared[timeindex][area])[s][i]
             - ((*modelDistribution[timeindex][area])[s][i] * totalmodel));
           likelihoodValues[timeindex][area] += (temp * temp);
         }
@@ -648,10 +705,7 @@ void StockDistribution::printLikelihood(ofstream& outfile, const TimeClass* cons
   int numage = ages.Nrow();
   int numlen = LgrpDiv->numLengthGroups();
 
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = timeMap[TimeInfo->getTime()];
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in stockdistribution - invalid timestep");
 
@@ -143,9 +143,9 @@ void StockPredator::Reset(const TimeClass* const TimeInfo) {
 
 void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass* const TimeInfo) {
 
-  int prey, predl, preyl, check;
+  int prey, predl, preyl, check, numpreyl;
   int inarea = this->areaNum(area);
-  double tmp;
+  double tmp, energy, phi;
 
   if (TimeInfo->getSubStep() == 1) {
     //this is the first substep of the timestep so need to reset things
@@ -190,23 +190,32 @@ void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass*
       check = 1;
 
     if ((this->getPrey(prey)->isPreyArea(area)) && (!(isZero(this->getPrey(prey)->getEnergy())))) {
+      //JMB - take the loop invariants out of the inner loops so that the
+      //compiler can vectorise the calculation of the consumption
+      energy = this->getPrey(prey)->getEnergy();
+      const DoubleVector& preybiomass = this->getPrey(prey)->getBiomass(area);
+      const DoubleMatrix& suit = this->getSuitability(prey);
       for (predl = 0; predl < LgrpDiv->numLengthGroups(); predl++) {
-        for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++) {
-          tmp = this->getSuitability(prey)[predl][preyl] * this->getPrey(prey)->getEnergy()
-                  * this->getPrey(prey)->getBiomass(area, preyl);
-
-          //JMB - dont take the power if we dont have to
-          if (!check)
-            tmp = pow(tmp, preference[prey]);
-          (*cons[inarea][prey])[predl][preyl] = tmp;
-          Phi[inarea][predl] += tmp;
-        }
+        DoubleVector& consrow = (*cons[inarea][prey])[predl];
+        const DoubleVector& suitrow = suit[predl];
+        numpreyl = consrow.Size();
+        for (preyl = 0; preyl < numpreyl; preyl++)
+          consrow[preyl] = suitrow[preyl] * energy * preybiomass[preyl];
+
+        //JMB - dont take the power if we dont have to
+        if (!check)
+          for (preyl = 0; preyl < numpreyl; preyl++)
+            consrow[preyl] = pow(consrow[preyl], preference[prey]);
+
+        phi = Phi[inarea][predl];
+        for (preyl = 0; preyl < numpreyl; preyl++)
+          phi += consrow[preyl];
+        Phi[inarea][predl] = phi;
       }
 
     } else {
       for (predl = 0; predl < LgrpDiv->numLengthGroups(); predl++)
-        for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++)
-          (*cons[inarea][prey])[predl][preyl] = 0.0;
+        (*cons[inarea][prey])[predl].setToZero();
     }
   }
 
@@ -239,8 +248,10 @@ void StockPredator::Eat(int area, const AreaClass* const Area, const TimeClass*
       for (predl = 0; predl < LgrpDiv->numLengthGroups(); predl++) {
         if (!(isZero(Phi[inarea][predl]))) {
           tmp = totalcons[inarea][predl] / (Phi[inarea][predl] * this->getPrey(prey)->getEnergy());
-          for (preyl = 0; preyl < (*cons[inarea][prey])[predl].Size(); preyl++)
-            (*cons[inarea][prey])[predl][preyl] *= tmp;
+          DoubleVector& consrow = (*cons[inarea][prey])[predl];
+          numpreyl = consrow.Size();
+          for (preyl = 0; preyl < numpreyl; preyl++)
+            consrow[preyl] *= tmp;
 
           //set the multiplicative constant
           (*predratio[inarea])[prey][predl] += tmp;
@@ -8,6 +8,7 @@
 #include "stockprey.h"
 #include "readword.h"
 #include "readaggregation.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "runid.h"
 #include "global.h"
@@ -37,7 +38,7 @@ StockPreyPrinter::StockPreyPrinter(CommentStream& infile, const TimeClass* const
   //read in area aggregation from file
   filename = new char[MaxStrLength];
   strncpy(filename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   infile >> filename >> ws;
@@ -9,6 +9,7 @@
 #include "stock.h"
 #include "readword.h"
 #include "readaggregation.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "runid.h"
 #include "global.h"
@@ -38,7 +39,7 @@ StockPrinter::StockPrinter(CommentStream& infile, const TimeClass* const TimeInf
   //read in area aggregation from file
   filename = new char[MaxStrLength];
   strncpy(filename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   infile >> filename >> ws;
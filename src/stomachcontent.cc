@@ -9,6 +9,7 @@
 #include "readaggregation.h"
 #include "multinomial.h"
 #include "errorhandler.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -94,7 +95,7 @@ SC::SC(CommentStream& infile, const AreaClass* const Area, const TimeClass* cons
   char aggfilename[MaxStrLength];
   strncpy(aggfilename, "", MaxStrLength);
 
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   //JMB - changed to make the reading of minimum probability optional
@@ -500,7 +501,7 @@ SCNumbers::SCNumbers(CommentStream& infile, const AreaClass* const Area,
   const char* datafilename, const char* givenname)
   : SC(infile, Area, TimeInfo, keeper, datafilename, givenname) {
 
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
   //read in stomach content from file
   datafile.open(datafilename, ios::in);
@@ -648,7 +649,7 @@ SCAmounts::SCAmounts(CommentStream& infile, const AreaClass* const Area,
   const char* datafilename, const char* numfilename, const char* givenname)
   : SC(infile, Area, TimeInfo, keeper, datafilename, givenname) {
 
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
   //read in stomach content amounts from file
   datafile.open(datafilename, ios::in);
@@ -995,7 +996,7 @@ SCSimple::SCSimple(CommentStream& infile, const AreaClass* const Area,
   const char* datafilename, const char* givenname)
   : SC(infile, Area, TimeInfo, keeper, datafilename, givenname) {
 
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
   //read in stomach content from file
   datafile.open(datafilename, ios::in);
@@ -6,6 +6,7 @@
 #include "readfunc.h"
 #include "readword.h"
 #include "readaggregation.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -20,7 +21,7 @@ StrayData::StrayData(CommentStream& infile, const LengthGroupDivision* const lgr
 
   char text[MaxStrLength];
   strncpy(text, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   LgrpDiv = new LengthGroupDivision(*lgrpdiv);
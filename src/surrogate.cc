@@ -0,0 +1,521 @@
+/* SURROGATE TRUST REGION OPTIMISATION
+ * Each model run is expensive, while fitting an approximation to the likelihood
+ * function using the points that have already been evaluated is cheap, so the
+ * approximation is used to choose the points that are worth evaluating.  The
+ * candidate points are generated by perturbing a random subset of the parameters
+ * of the best point (the dynamic coordinate search of Regis and Shoemaker), and
+ * the points to evaluate are chosen using a weighted score of the predicted value
+ * and the distance to the points that have already been evaluated, cycling
+ * through the weights so each batch contains both local and exploratory points.
+ */
+
+#include "gadget.h"    //All the required standard header files are in here
+#include "optinfo.h"
+#include "mathfunc.h"
+#include "doublevector.h"
+#include "intvector.h"
+#include "errorhandler.h"
+#include "ecosystem.h"
+#include "evaluationengine.h"
+#include "populationmatrix.h"
+#include "randomstream.h"
+#include "global.h"
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+extern Ecosystem* EcoSystem;
+#ifdef _OPENMP
+extern Ecosystem** EcoSystems;
+#endif
+
+/* weights given to the predicted value when choosing the points in a batch */
+static const double surrogateweights[4] = { 0.3, 0.5, 0.8, 0.95 };
+
+int OptInfoSurrogate::solveSystem(DoubleMatrix& A, DoubleVector& b) {
+  int i, j, k, p;
+  int n = b.Size();
+  double tmp, scale = 0.0;
+
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++)
+      scale = max(scale, fabs(A[i][j]));
+  if (isZero(scale))
+    return 0;
+
+  for (k = 0; k < n; k++) {
+    p = k;
+    for (i = k + 1; i < n; i++)
+      if (fabs(A[i][k]) > fabs(A[p][k]))
+        p = i;
+    if (fabs(A[p][k]) < rathersmall * scale)
+      return 0;
+
+    if (p != k) {
+      for (j = k; j < n; j++) {
+        tmp = A[k][j];
+        A[k][j] = A[p][j];
+        A[p][j] = tmp;
+      }
+      tmp = b[k];
+      b[k] = b[p];
+      b[p] = tmp;
+    }
+
+    for (i = k + 1; i < n; i++) {
+      tmp = A[i][k] / A[k][k];
+      if (!isZero(tmp)) {
+        for (j = k + 1; j < n; j++)
+          A[i][j] -= tmp * A[k][j];
+        b[i] -= tmp * b[k];
+      }
+      A[i][k] = 0.0;
+    }
+  }
+
+  for (i = n - 1; i >= 0; i--) {
+    tmp = b[i];
+    for (j = i + 1; j < n; j++)
+      tmp -= A[i][j] * b[j];
+    b[i] = tmp / A[i][i];
+  }
+  return 1;
+}
+
+/* the radial basis function is phi(r) = r^3 with a linear term, and the  */
+/* quadratic function has a constant, linear and squared term for each  */
+/* parameter, fitted to the points using least squares                   */
+int OptInfoSurrogate::fitModel(const DoubleMatrix& u, const DoubleVector& f, DoubleVector& coef) {
+  int i, j, k, d;
+  int m = u.Nrow();
+  int n = u.Ncol();
+  double r;
+
+  if (quadratic) {
+    int size = 2 * n + 1;
+    if (m < size)
+      return 0;
+
+    DoubleMatrix A(size, size, 0.0);
+    DoubleVector b(size, 0.0);
+    DoubleVector row(size, 0.0);
+    for (k = 0; k < m; k++) {
+      row[0] = 1.0;
+      for (d = 0; d < n; d++) {
+        row[d + 1] = u[k][d];
+        row[n + d + 1] = u[k][d] * u[k][d];
+      }
+      for (i = 0; i < size; i++) {
+        b[i] += row[i] * f[k];
+        for (j = 0; j < size; j++)
+          A[i][j] += row[i] * row[j];
+      }
+    }
+    //JMB a small ridge term keeps the least squares problem well conditioned
+    for (i = 0; i < size; i++)
+      A[i][i] += 1e-8 * (A[i][i] + 1.0);
+    if (!this->solveSystem(A, b))
+      return 0;
+    coef = b;
+    return 1;
+  }
+
+  int size = m + n + 1;
+  if (m < n + 1)
+    return 0;
+
+  DoubleMatrix A(size, size, 0.0);
+  DoubleVector b(size, 0.0);
+  for (i = 0; i < m; i++) {
+    for (j = i + 1; j < m; j++) {
+      r = 0.0;
+      for (d = 0; d < n; d++)
+        r += (u[i][d] - u[j][d]) * (u[i][d] - u[j][d]);
+      r = sqrt(r);
+      A[i][j] = A[j][i] = r * r * r;
+    }
+    A[i][m] = A[m][i] = 1.0;
+    for (d = 0; d < n; d++)
+      A[i][m + d + 1] = A[m + d + 1][i] = u[i][d];
+    b[i] = f[i];
+  }
+  if (!this->solveSystem(A, b))
+    return 0;
+  coef = b;
+  return 1;
+}
+
+double OptInfoSurrogate::predictModel(const DoubleMatrix& u, const DoubleVector& coef, const DoubleVector& point) {
+  int i, d;
+  int m = u.Nrow();
+  int n = point.Size();
+  double r, value;
+
+  if (quadratic) {
+    value = coef[0];
+    for (d = 0; d < n; d++)
+      value += (coef[d + 1] + coef[n + d + 1] * point[d]) * point[d];
+    return value;
+  }
+
+  value = coef[m];
+  for (d = 0; d < n; d++)
+    value += coef[m + d + 1] * point[d];
+  for (i = 0; i < m; i++) {
+    r = 0.0;
+    for (d = 0; d < n; d++)
+      r += (u[i][d] - point[d]) * (u[i][d] - point[d]);
+    r = sqrt(r);
+    value += coef[i] * r * r * r;
+  }
+  return value;
+}
+
+void OptInfoSurrogate::OptimiseLikelihood() {
+
+  double tmp, bestf, delta, prob, w, merit, bestmerit, median;
+  double vmin, vmax, dmin, dmax;
+  int i, j, k, c, d, offset, nfree, numpoints, numcand, numsel, fitted;
+  int nsucc, nfail, maxfail, cycle, improved, bestc;
+  unsigned key; // key for the random numbers used in each iteration
+
+  handle.logMessage(LOGINFO, "\nStarting Surrogate optimisation algorithm\n");
+  int nvars = EcoSystem->numOptVariables();
+  DoubleVector x(nvars);
+  DoubleVector bestx(nvars);
+  DoubleVector lowerb(nvars);
+  DoubleVector upperb(nvars);
+  DoubleVector init(nvars);
+  DoubleVector range(nvars);
+  IntVector freevar;
+
+  EcoSystem->scaleVariables();  //JMB need to scale variables
+  EcoSystem->getOptScaledValues(x);
+  EcoSystem->getOptLowerBounds(lowerb);
+  EcoSystem->getOptUpperBounds(upperb);
+  EcoSystem->getOptInitialValues(init);
+
+  //JMB the search is done on the parameters normalised to lie between 0 and 1,
+  //ignoring any parameters where the lower and upper bounds are the same
+  for (i = 0; i < nvars; i++) {
+    bestx[i] = x[i];
+    lowerb[i] = lowerb[i] / init[i];
+    upperb[i] = upperb[i] / init[i];
+    if (lowerb[i] > upperb[i]) {
+      tmp = lowerb[i];
+      lowerb[i] = upperb[i];
+      upperb[i] = tmp;
+    }
+    range[i] = upperb[i] - lowerb[i];
+    if (!isZero(range[i]))
+      freevar.resize(1, i);
+  }
+  nfree = freevar.Size();
+
+  bestf = EcoSystem->SimulateAndUpdate(x);
+  if (bestf != bestf) { //check for NaN
+    handle.logMessage(LOGINFO, "Error starting Surrogate optimisation with f(x) = infinity");
+    converge = -1;
+    iters = 1;
+    return;
+  }
+
+  offset = EvaluationEngine::numEvaluations(); //number of function evaluations done before loop
+  if (nfree == 0) {
+    handle.logMessage(LOGINFO, "Error in Surrogate optimisation - no parameters can be changed within the bounds");
+    converge = -1;
+    iters = 0;
+    score = bestf;
+    return;
+  }
+
+  PopulationMatrix archive(1, nfree, 0.0);  // normalised values of the points that have been evaluated
+  DoubleVector archivef(1, bestf);          // likelihood scores of the points that have been evaluated
+  DoubleVector centre(nfree);
+  for (d = 0; d < nfree; d++) {
+    i = freevar[d];
+    centre[d] = (x[i] - lowerb[i]) / range[i];
+    archive[0][d] = centre[d];
+  }
+
+  delta = radius;
+  nsucc = 0;
+  nfail = 0;
+  cycle = 0;
+  maxfail = (failtol > 0 ? failtol : (max(4, nfree) + batchsize - 1) / batchsize);
+  numcand = min(100 * nfree, 5000);
+  prob = min(1.0, 20.0 / nfree);
+
+  //JMB the first batch is a step of delta along each axis, which is enough
+  //points to fit the first approximation
+  k = max(2 * nfree, batchsize);
+  DoubleMatrix batchu(k, nfree, 0.0);
+  DoubleMatrix batchx(k, nvars, 0.0);
+  DoubleVector batchf(k, 0.0);
+  numsel = 0;
+  for (d = 0; d < nfree; d++) {
+    for (k = 0; k < 2; k++) {
+      batchu[numsel] = centre;
+      tmp = (k == 0 ? delta : -delta);
+      if ((centre[d] + tmp > 1.0) || (centre[d] + tmp < 0.0))
+        tmp = -tmp;
+      batchu[numsel][d] = max(0.0, min(1.0, centre[d] + tmp));
+      numsel++;
+    }
+  }
+
+  while (1) {
+    //JMB evaluate the points in the batch, and add them to the archive
+    for (k = 0; k < numsel; k++) {
+      batchx[k] = x;
+      for (d = 0; d < nfree; d++) {
+        i = freevar[d];
+        batchx[k][i] = lowerb[i] + batchu[k][d] * range[i];
+      }
+    }
+    EvaluationEngine::Evaluate(batchx, batchf, 0, numsel);
+
+    improved = 0;
+    tmp = bestf;
+    for (k = 0; k < numsel; k++) {
+      if (batchf[k] != batchf[k])  //JMB dont archive points where f(x) is NaN
+        continue;
+      archive.AddRows(1, nfree, 0.0);
+      archive[archive.Nrow() - 1] = batchu[k];
+      archivef.resize(1, batchf[k]);
+      if (batchf[k] < bestf) {
+        bestf = batchf[k];
+        bestx = batchx[k];
+        centre = batchu[k];
+        improved = 1;
+      }
+    }
+
+    iters = EvaluationEngine::numEvaluations() - offset;
+    if (improved) {
+      for (i = 0; i < nvars; i++)
+        x[i] = bestx[i] * init[i];
+      handle.logMessage(LOGINFO, "\nNew optimum found after", iters, "function evaluations");
+      handle.logMessage(LOGINFO, "The likelihood score is", bestf, "at the point");
+      EcoSystem->storeVariables(bestf, x);
+      EcoSystem->writeBestValues();
+    }
+
+    //JMB a batch is only a success if the improvement is significant
+    if (improved && (tmp - bestf > 1e-4 * fabs(tmp))) {
+      nsucc++;
+      nfail = 0;
+    } else {
+      nsucc = 0;
+      nfail++;
+    }
+    if (nsucc >= succtol) {
+      delta = min(2.0 * delta, 0.5);
+      nsucc = 0;
+      handle.logMessage(LOGINFO, "Increasing the size of the trust region to", delta);
+    } else if (nfail >= maxfail) {
+      delta *= rho;
+      nfail = 0;
+      handle.logMessage(LOGINFO, "Reducing the size of the trust region to", delta);
+    }
+
+    //JMB store or restore the state of the optimisation at the start of each iteration
+    if (OptCheckpoint::Start(OPTSURROGATE)) {
+      OptCheckpoint::Transfer(seed);
+      OptCheckpoint::Transfer(archive);
+      OptCheckpoint::Transfer(archivef);
+      OptCheckpoint::Transfer(centre);
+      OptCheckpoint::Transfer(bestx);
+      OptCheckpoint::Transfer(bestf);
+      OptCheckpoint::Transfer(delta);
+      OptCheckpoint::Transfer(nsucc);
+      OptCheckpoint::Transfer(nfail);
+      OptCheckpoint::Transfer(cycle);
+      OptCheckpoint::Transfer(offset);
+      OptCheckpoint::Finish();
+    }
+
+    iters = EvaluationEngine::numEvaluations() - offset;
+    if (isZero(bestf)) {
+      handle.logMessage(LOGINFO, "Error in Surrogate optimisation after", iters, "function evaluations, f(x) = 0");
+      converge = -1;
+      return;
+    }
+
+    // terminate the algorithm if too many function evaluations occur
+    if (iters > surrogateiter) {
+      handle.logMessage(LOGINFO, "\nStopping Surrogate optimisation algorithm\n");
+      handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+      handle.logMessage(LOGINFO, "The size of the trust region was reduced to", delta);
+      handle.logMessage(LOGINFO, "The optimisation stopped because the maximum number of function evaluations");
+      handle.logMessage(LOGINFO, "was reached and NOT because an optimum was found for this run");
+
+      score = EcoSystem->SimulateAndUpdate(bestx);
+      handle.logMessage(LOGINFO, "\nSurrogate finished with a likelihood score of", score);
+      return;
+    }
+
+    // terminate the algorithm if the trust region is smaller than surrogateeps
+    if (delta < surrogateeps) {
+      handle.logMessage(LOGINFO, "\nStopping Surrogate optimisation algorithm\n");
+      handle.logMessage(LOGINFO, "The optimisation stopped after", iters, "function evaluations");
+      handle.logMessage(LOGINFO, "The size of the trust region was reduced to", delta);
+      handle.logMessage(LOGINFO, "The optimisation stopped because an optimum was found for this run");
+
+      converge = 1;
+      score = EcoSystem->SimulateAndUpdate(bestx);
+      handle.logMessage(LOGINFO, "\nSurrogate finished with a likelihood score of", score);
+      return;
+    }
+
+    //JMB fit the approximation to the archived points closest to the best point
+    vector<pair<double, int> > order(archive.Nrow());
+    for (k = 0; k < archive.Nrow(); k++) {
+      tmp = 0.0;
+      for (d = 0; d < nfree; d++)
+        tmp += (archive[k][d] - centre[d]) * (archive[k][d] - centre[d]);
+      order[k] = make_pair(tmp, k);
+    }
+    numpoints = min(archive.Nrow(), max(maxpoints, 2 * nfree + 1));
+    partial_sort(order.begin(), order.begin() + numpoints, order.end());
+
+    DoubleMatrix u(numpoints, nfree, 0.0);
+    DoubleVector fu(numpoints, 0.0);
+    vector<double> sorted(numpoints);
+    for (k = 0; k < numpoints; k++) {
+      u[k] = archive[order[k].second];
+      fu[k] = archivef[order[k].second];
+      sorted[k] = fu[k];
+    }
+    //JMB scores above the median are replaced by the median, so that a few
+    //very poor points dont dominate the approximation
+    nth_element(sorted.begin(), sorted.begin() + numpoints / 2, sorted.end());
+    median = sorted[numpoints / 2];
+    for (k = 0; k < numpoints; k++)
+      if (fu[k] > median)
+        fu[k] = median;
+
+    DoubleVector coef;
+    fitted = this->fitModel(u, fu, coef);
+    if (!fitted)
+      handle.logMessage(LOGINFO, "Warning in Surrogate - failed to fit the approximation after", iters, "function evaluations");
+
+    //JMB the random numbers for each candidate point are calculated from its own stream
+    key = rand_r(&seed);
+    DoubleMatrix cand(numcand, nfree, 0.0);
+    DoubleVector value(numcand, 0.0);
+    DoubleVector dist(numcand, 0.0);
+    IntVector chosen(numcand, 0);
+    for (c = 0; c < numcand; c++) {
+      RandomStream rs(key, c);
+      cand[c] = centre;
+      j = 0;
+      for (d = 0; d < nfree; d++) {
+        if (rs.Uniform() < prob) {
+          cand[c][d] += delta * (2.0 * rs.Uniform() - 1.0);
+          j++;
+        }
+      }
+      if (j == 0) {
+        d = rs.Integer(nfree);
+        cand[c][d] += delta * (2.0 * rs.Uniform() - 1.0);
+      }
+      for (d = 0; d < nfree; d++) {
+        //JMB reflect the candidate point back within the bounds
+        if (cand[c][d] < 0.0)
+          cand[c][d] = min(-cand[c][d], 1.0);
+        if (cand[c][d] > 1.0)
+          cand[c][d] = max(2.0 - cand[c][d], 0.0);
+      }
+
+      if (fitted)
+        value[c] = this->predictModel(u, coef, cand[c]);
+      dist[c] = verybig;
+      for (k = 0; k < numpoints; k++) {
+        tmp = 0.0;
+        for (d = 0; d < nfree; d++)
+          tmp += (u[k][d] - cand[c][d]) * (u[k][d] - cand[c][d]);
+        dist[c] = min(dist[c], tmp);
+      }
+      dist[c] = sqrt(dist[c]);
+    }
+
+    //JMB choose the points for the next batch, cycling through the weights
+    numsel = 0;
+    for (k = 0; k < batchsize; k++) {
+      w = surrogateweights[cycle % 4];
+      cycle++;
+      vmin = verybig;
+      vmax = -verybig;
+      dmin = verybig;
+      dmax = -verybig;
+      for (c = 0; c < numcand; c++) {
+        if (chosen[c] || (dist[c] < 1e-3 * delta))
+          continue;
+        vmin = min(vmin, value[c]);
+        vmax = max(vmax, value[c]);
+        dmin = min(dmin, dist[c]);
+        dmax = max(dmax, dist[c]);
+      }
+
+      bestc = -1;
+      bestmerit = verybig;
+      for (c = 0; c < numcand; c++) {
+        if (chosen[c] || (dist[c] < 1e-3 * delta))
+          continue;
+        merit = w * (vmax > vmin ? (value[c] - vmin) / (vmax - vmin) : 1.0)
+          + (1.0 - w) * (dmax > dmin ? (dmax - dist[c]) / (dmax - dmin) : 1.0);
+        if (merit < bestmerit) {
+          bestmerit = merit;
+          bestc = c;
+        }
+      }
+      if (bestc == -1)
+        break;
+
+      chosen[bestc] = 1;
+      batchu[numsel] = cand[bestc];
+      numsel++;
+      for (c = 0; c < numcand; c++) {
+        tmp = 0.0;
+        for (d = 0; d < nfree; d++)
+          tmp += (cand[bestc][d] - cand[c][d]) * (cand[bestc][d] - cand[c][d]);
+        dist[c] = min(dist[c], sqrt(tmp));
+      }
+    }
+
+    //JMB if every candidate point is too close to the archived points then
+    //the trust region is reduced without evaluating any points
+    if (numsel == 0) {
+      nfail = maxfail - 1;
+      nsucc = 0;
+    }
+  }
+}
+
+#ifdef _OPENMP
+/* the speculative version evaluates at least one point for each thread in */
+/* each batch, so the points found will depend on the number of threads   */
+void OptInfoSurrogate::OptimiseLikelihoodOMP() {
+  int i, numThr = omp_get_max_threads();
+  int tmpsize = batchsize;
+  for (i = 0; i < numThr; i++) // scale the variables for the ecosystem of every thread
+    EcoSystems[i]->scaleVariables();
+
+  batchsize = max(batchsize, numThr);
+  this->OptimiseLikelihood();
+  batchsize = tmpsize;
+}
+
+/* the reproducible version evaluates the same batches as the sequential */
+/* version, sharing the points in each batch between the threads          */
+void OptInfoSurrogate::OptimiseLikelihoodREP() {
+  int i, numThr = omp_get_max_threads();
+  for (i = 0; i < numThr; i++) // scale the variables for the ecosystem of every thread
+    EcoSystems[i]->scaleVariables();
+
+  this->OptimiseLikelihood();
+}
+#endif
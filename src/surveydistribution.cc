@@ -7,6 +7,7 @@
 #include "areatime.h"
 #include "stock.h"
 #include "suitfuncptrvector.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -23,7 +24,7 @@ SurveyDistribution::SurveyDistribution(CommentStream& infile, const AreaClass* c
   char aggfilename[MaxStrLength];
   strncpy(datafilename, "", MaxStrLength);
   strncpy(aggfilename, "", MaxStrLength);
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
   readWordAndValue(infile, "datafile", datafilename);
 
@@ -259,6 +260,12 @@ void SurveyDistribution::readDistributionData(CommentStream& infile,
   }
 
   AAT.addActions(Years, Steps, TimeInfo);
+
+  //JMB find the index of the likelihood data for each timestep
+  timeMap.resize(TimeInfo->numTotalSteps() + 1, -1);
+  for (i = 0; i < Years.Size(); i++)
+    timeMap[TimeInfo->calcSteps(Years[i], Steps[i])] = i;
+
   if (count == 0)
     handle.logMessage(LOGWARN, "Warning in surveydistribution - found no data in the data file for", this->getName());
 
@@ -301,8 +308,7 @@ SurveyDistribution::~SurveyDistribution() {
     }
   }
 
-  if (aggregator != 0)
-    delete aggregator;
+  //JMB the aggregator is owned by the AggregationPlanner so dont delete it here
   delete LgrpDiv;
   delete[] fittype;
   delete[] liketype;
@@ -336,11 +342,8 @@ void SurveyDistribution::printLikelihood(ofstream& outfile, const TimeClass* con
   if (!AAT.atCurrentTime(TimeInfo))
     return;
 
-  int i, area, age, len;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  int area, age, len;
+  timeindex = timeMap[TimeInfo->getTime()];
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in surveydistribution - invalid timestep");
 
@@ -362,7 +365,8 @@ void SurveyDistribution::printLikelihood(ofstream& outfile, const TimeClass* con
   }
 }
 
-void SurveyDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
+void SurveyDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+  AggregationPlanner* const planner) {
 
   int i, j, k, found, minage, maxage;
   StockPtrVector stocks;
@@ -434,7 +438,7 @@ void SurveyDistribution::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVect
       handle.logMessage(LOGWARN, "Warning in surveydistribution - maximum length group greater than stock length");
   }
 
-  aggregator = new StockAggregator(stocks, LgrpDiv, areas, ages);
+  aggregator = planner->getStockAggregator(stocks, LgrpDiv, areas, ages);
 }
 
 void SurveyDistribution::calcIndex(const TimeClass* const TimeInfo) {
@@ -476,16 +480,18 @@ void SurveyDistribution::calcIndex(const TimeClass* const TimeInfo) {
   }
 }
 
+int SurveyDistribution::isActive(int year, int step, const TimeClass* const TimeInfo) const {
+  if (isZero(weight))
+    return 0;
+  return AAT.atTime(year, step, TimeInfo);
+}
+
 void SurveyDistribution::addLikelihood(const TimeClass* const TimeInfo) {
 
   if ((!(AAT.atCurrentTime(TimeInfo))) || (isZero(weight)))
     return;
 
-  int i;
-  timeindex = -1;
-  for (i = 0; i < Years.Size(); i++)
-    if ((Years[i] == TimeInfo->getYear()) && (Steps[i] == TimeInfo->getStep()))
-      timeindex = i;
+  timeindex = timeMap[TimeInfo->getTime()];
   if (timeindex == -1)
     handle.logMessage(LOGFAIL, "Error in surveydistribution - invalid timestep");
 
@@ -10,6 +10,7 @@
 #include "sibyfleetonstep.h"
 #include "sibyeffortonstep.h"
 #include "sibyacousticonstep.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -32,7 +33,7 @@ SurveyIndices::SurveyIndices(CommentStream& infile, const AreaClass* const Area,
   strncpy(aggfilename, "", MaxStrLength);
   strncpy(sitype, "", MaxStrLength);
 
-  ifstream datafile;
+  ModelFile datafile;
   CommentStream subdata(datafile);
 
   readWordAndValue(infile, "datafile", datafilename);
@@ -218,13 +219,20 @@ SurveyIndices::~SurveyIndices() {
   delete SI;
 }
 
+int SurveyIndices::isActive(int year, int step, const TimeClass* const TimeInfo) const {
+  if (TimeInfo->calcSteps(year, step) == TimeInfo->numTotalSteps())
+    return 1;
+  return SI->isActive(year, step, TimeInfo);
+}
+
 void SurveyIndices::addLikelihood(const TimeClass* const TimeInfo) {
   SI->Sum(TimeInfo);
   if (TimeInfo->getTime() == TimeInfo->numTotalSteps())
     likelihood += SI->calcSSE();
 }
 
-void SurveyIndices::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks) {
+void SurveyIndices::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& Stocks,
+  AggregationPlanner* const planner) {
   int i, j, k, found;
   FleetPtrVector f;
   StockPtrVector s;
@@ -288,7 +296,12 @@ void SurveyIndices::setFleetsAndStocks(FleetPtrVector& Fleets, StockPtrVector& S
     }
   }
 
-  SI->setFleetsAndStocks(f, s);
+  SI->setFleetsAndStocks(f, s, planner);
+}
+
+void SurveyIndices::restoreState(int id, const TimeClass* const TimeInfo) {
+  Likelihood::restoreState(id, TimeInfo);
+  SI->Reset(TimeInfo);
 }
 
 void SurveyIndices::Reset(const Keeper* const keeper) {
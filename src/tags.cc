@@ -5,6 +5,7 @@
 #include "readword.h"
 #include "stock.h"
 #include "stockprey.h"
+#include "modelfile.h"
 #include "gadget.h"
 #include "global.h"
 
@@ -16,7 +17,7 @@ Tags::Tags(CommentStream& infile, const char* givenname, const AreaClass* const
   numtagtimesteps = 0;
   char text[MaxStrLength];
   strncpy(text, "", MaxStrLength);
-  ifstream subfile;
+  ModelFile subfile;
   CommentStream subcomment(subfile);
 
   keeper->addString("tags");
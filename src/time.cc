@@ -51,6 +51,7 @@ TimeClass::TimeClass(CommentStream& infile, double maxratio) {
   currentyear = firstyear;
   currentstep = firststep;
   currentsubstep = 1;
+  restarted = 0;
   handle.logMessage(LOGMESSAGE, "Read time file - number of timesteps", this->numTotalSteps());
 }
 
@@ -61,6 +62,7 @@ void TimeClass::IncrementTime() {
 
   } else {
     currentsubstep = 1;
+    restarted = 0;
     if (currentstep == numtimesteps) {
       currentstep = 1;
       currentyear++;
@@ -85,6 +87,11 @@ int TimeClass::isWithinPeriod(int year, int step) const {
 }
 
 int TimeClass::didStepSizeChange() const {
+  if (restarted)
+    return 1;
+  //JMB the first timestep follows the last timestep of the previous simulation
+  if ((currentyear == firstyear) && (currentstep == firststep))
+    return (timesteps[firststep] != timesteps[laststep]);
   if (currentstep == 1)
     return (timesteps[1] != timesteps[numtimesteps]);
   return (timesteps[currentstep] != timesteps[currentstep - 1]);
@@ -94,10 +101,23 @@ void TimeClass::Reset() {
   currentyear = firstyear;
   currentstep = firststep;
   currentsubstep = 1;
+  restarted = 0;
   if (handle.getLogLevel() >= LOGMESSAGE)
     handle.logMessage(LOGMESSAGE, "\nReset time in the simulation to timestep", this->getTime());
 }
 
+void TimeClass::Restart(int time) {
+  if ((time < 1) || (time > this->numTotalSteps()))
+    handle.logMessage(LOGFAIL, "Error in time - cannot restart simulation on timestep", time);
+
+  currentyear = firstyear + (firststep + time - 2) / numtimesteps;
+  currentstep = ((firststep + time - 2) % numtimesteps) + 1;
+  currentsubstep = 1;
+  restarted = 1;
+  if (handle.getLogLevel() >= LOGMESSAGE)
+    handle.logMessage(LOGMESSAGE, "\nRestarted the simulation from timestep", this->getTime());
+}
+
 double TimeClass::getMaxRatioConsumed() const {
   if (numsubsteps[currentstep - 1] == 1)
     return maxratioconsumed;
@@ -27,6 +27,8 @@ void TimeVariable::read(CommentStream& infile,
     if (infile.fail())
       handle.logFileMessage(LOGFAIL, "failed to read timevariable value");
     values[i].Inform(keeper);
+    //JMB this value is not used before the timestep it is given for
+    values[i].setFirstUse(keeper, TimeInfo->calcSteps(years[i], steps[i]));
 
     infile >> ws;
     i++;
@@ -50,17 +52,26 @@ void TimeVariable::read(CommentStream& infile,
 }
 
 int TimeVariable::didChange(const TimeClass* const TimeInfo) {
-  if (TimeInfo->getTime() == 1)
+  if ((TimeInfo->getTime() == 1) || (TimeInfo->didRestart()))
     return 1;  //return true for the first timestep
 
   return ((!(isEqual(lastvalue, value))) && (time == TimeInfo->getTime()));
 }
 
 void TimeVariable::Update(const TimeClass* const TimeInfo) {
+  int i;
   if (TimeInfo->getTime() == 1)
     timeid = 0;
+  else if (TimeInfo->didRestart()) {
+    //JMB the simulation has been restarted part way through, so find the
+    //value that was in use on the current timestep
+    timeid = 0;
+    for (i = 0; i < steps.Size(); i++)
+      if ((years[i] < TimeInfo->getYear()) || ((years[i] == TimeInfo->getYear()) && (steps[i] <= TimeInfo->getStep())))
+        timeid = i;
+    time = TimeInfo->getTime();
+  }
 
-  int i;
   for (i = timeid; i < steps.Size(); i++) {
     if (steps[i] == TimeInfo->getStep() && years[i] == TimeInfo->getYear()) {
       timeid = i;
@@ -105,6 +105,23 @@ void UnderStocking::setPredatorsAndPreys(PredatorPtrVector& predvec,
     areas[i] = Area->getInnerArea(areas[i]);
 }
 
+void UnderStocking::storeState(int id) {
+  Likelihood::storeState(id);
+  if (id >= storedsize.Size())
+    storedsize.resize(id + 1 - storedsize.Size(), 0);
+  storedsize[id] = likelihoodValues.Size();
+}
+
+void UnderStocking::restoreState(int id, const TimeClass* const TimeInfo) {
+  Likelihood::restoreState(id, TimeInfo);
+  //JMB remove the entries that were added after the checkpoint
+  while (likelihoodValues.Size() > storedsize[id]) {
+    Years.Delete(Years.Size() - 1);
+    Steps.Delete(Steps.Size() - 1);
+    likelihoodValues.Delete(likelihoodValues.Size() - 1);
+  }
+}
+
 void UnderStocking::Reset(const Keeper* const keeper) {
   Likelihood::Reset(keeper);
   if (isZero(weight))
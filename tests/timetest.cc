@@ -0,0 +1,55 @@
+#include "areatime.h"
+#include "commentstream.h"
+#include "errorhandler.h"
+#include "gadget.h"
+#include "global.h"
+#include <sstream>
+
+//JMB the global variables that are defined in gadget.cc
+class Ecosystem;
+Ecosystem* EcoSystem;
+Ecosystem** EcoSystems;
+volatile int interrupted = 0;
+volatile int interrupted_print = 0;
+
+//JMB run the timesteps of a few simulations and check that didStepSizeChange
+//reports a change whenever the length of the timestep differs from the length
+//of the timestep that was simulated before it, including the first timestep
+//of a simulation which follows the last timestep of the previous simulation
+int checkTime(const char* timefile) {
+  int run, fail = 0;
+  double size, prevsize = -1.0;
+  istringstream istr(timefile);
+  CommentStream infile(istr);
+  TimeClass* TimeInfo = new TimeClass(infile, 0.95);
+
+  for (run = 0; run < 3; run++) {
+    TimeInfo->Reset();
+    while (1) {
+      size = TimeInfo->getTimeStepSize();
+      if ((prevsize > 0.0) && (TimeInfo->didStepSizeChange() != (size != prevsize))) {
+        cerr << "Error in timetest - didStepSizeChange wrong on timestep "
+          << TimeInfo->getTime() << " of simulation " << run + 1 << endl;
+        fail = 1;
+      }
+      prevsize = size;
+      if (TimeInfo->getTime() == TimeInfo->numTotalSteps())
+        break;
+      TimeInfo->IncrementTime();
+    }
+  }
+  delete TimeInfo;
+  return fail;
+}
+
+int main(int aNumber, char* const aVector[]) {
+  int fail = 0;
+  handle.setLogLevel(LOGFAIL);
+  fail += checkTime("firstyear 2000\nfirststep 1\nlastyear 2001\nlaststep 2\nnotimesteps 3 3 6 3\n");
+  fail += checkTime("firstyear 2000\nfirststep 2\nlastyear 2002\nlaststep 3\nnotimesteps 3 3 6 3\n");
+  fail += checkTime("firstyear 2000\nfirststep 3\nlastyear 2001\nlaststep 1\nnotimesteps 4 2 4 4 2\n");
+  fail += checkTime("firstyear 2000\nfirststep 1\nlastyear 2000\nlaststep 4\nnotimesteps 4 3 3 3 3\n");
+  if (fail == 0)
+    cout << "All time tests passed" << endl;
+  return (fail > 0);
+}